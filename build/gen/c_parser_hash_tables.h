@@ -0,0 +1,70 @@
+/* c_parser_hash_tables.h - Generated by tools/gen_perfect_hash.c, do not edit */
+// Slot values are 1-based word IDs from the X-macro lists in c_parser.h; 0 is empty
+
+#ifndef C_PARSER_HASH_TABLES_H
+#define C_PARSER_HASH_TABLES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+static inline uint32_t c_parser_perfect_hash(const char* text, size_t length, uint32_t seed) {
+    uint32_t hash = seed ^ (uint32_t)length;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)text[i]) * 16777619u;
+    }
+    return hash ^ (hash >> 16);
+}
+
+#define C_KEYWORD_HASH_SEED 11u
+#define C_KEYWORD_HASH_MASK 255u
+#define C_KEYWORD_MIN_LENGTH 2
+#define C_KEYWORD_MAX_LENGTH 14
+
+static const uint8_t C_KEYWORD_HASH_SLOTS[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0, 27, 36,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0, 26,  0,  0,  0,  0,  0,  0,  1,  0,  0,
+     5,  0,  0,  0,  0,  0,  0,  0,  0,  0, 29,  0,  9, 21,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 22,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 39,  0,  0,  0, 10,
+     0,  0,  0,  7,  0,  3,  8,  0,  0, 32,  0,  0,  0,  0,  0,  0,
+     0,  0,  0, 14,  0,  0,  0,  0,  0, 11,  0,  0,  0,  0, 15,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0, 33,  0, 13, 23,  0, 35,  0,  0,  0,  0,  0, 30,
+     0,  0,  0,  0,  4,  0,  0,  0,  0,  0,  0,  0, 28,  0,  0,  0,
+    34, 20,  0,  0,  0,  0,  0,  0, 18, 17, 42,  0,  6,  0,  0,  0,
+    19,  0,  0,  0,  0,  0,  0,  0, 31,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0, 25,  0,  0,  0,  0,  0, 38, 24,  0, 16,  0,  0, 40,
+     0,  0,  0,  0,  0,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    44,  0,  0,  0, 12,  0,  0,  0,  0,  0, 37,  0,  0, 41,  0, 43,
+};
+
+#define C_TYPE_KEYWORD_HASH_SEED 11u
+#define C_TYPE_KEYWORD_HASH_MASK 127u
+#define C_TYPE_KEYWORD_MIN_LENGTH 3
+#define C_TYPE_KEYWORD_MAX_LENGTH 8
+
+static const uint8_t C_TYPE_KEYWORD_HASH_SLOTS[128] = {
+     0,  0,  0,  0,  0, 14,  0,  0, 19, 12,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  3, 15, 10,  0,  6,  0,  0, 16,  0,  8,
+     0,  0,  0,  0,  2,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  9,  0,  0, 17,  0,  0,  1,  0,  0,  0,  4,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0, 11,  0,  0,  0,  0,  0,  0,
+     7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 13,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  5,  0,  0, 18,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+#define C_DANGEROUS_FUNCTION_HASH_SEED 6u
+#define C_DANGEROUS_FUNCTION_HASH_MASK 63u
+#define C_DANGEROUS_FUNCTION_MIN_LENGTH 4
+#define C_DANGEROUS_FUNCTION_MAX_LENGTH 9
+
+static const uint8_t C_DANGEROUS_FUNCTION_HASH_SLOTS[64] = {
+     0,  0,  0,  9, 11,  0,  0,  0,  0,  0,  0,  0,  0,  0,  8,  2,
+     0,  0,  0,  0, 15,  0,  0,  0,  0,  0,  3,  5,  0,  0,  0,  6,
+     0,  0, 14,  7,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 10,  0,
+    16,  0,  0,  0, 13,  0, 12,  0,  1,  0,  0,  4,  0,  0,  0,  0,
+};
+
+#endif /* C_PARSER_HASH_TABLES_H */
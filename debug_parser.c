@@ -6,6 +6,7 @@
 #include "include/c_parser.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 int main() {
     printf("=== DEBUGGING TOKEN PARSING ===\n");
@@ -40,17 +41,24 @@ int main() {
     // Look for block comment tokens around the function
     printf("\nLooking for comment tokens around line %d:\n", target_func->line_number);
     
+    Token_t* tokens = c_parser_tokens(parsed);
+    if (!tokens) {
+        printf("Failed to build token view\n");
+        c_parser_free_parsed_file(parsed);
+        return 1;
+    }
+    
     for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
+        Token_t* token = &tokens[i];
         
         // Show tokens within 20 lines of the function
         if (token->line >= target_func->line_number - 20 && 
             token->line <= target_func->line_number + 5) {
             
             if (token->type == TOKEN_COMMENT_BLOCK || token->type == TOKEN_COMMENT_LINE) {
-                printf("  Line %d: %s (type: %s)\n", 
+                printf("  Line %d: %.*s (type: %s)\n", 
                        token->line, 
-                       token->value ? token->value : "(null)",
+                       token->length, c_parser_token_text(parsed->source, token),
                        token->type == TOKEN_COMMENT_BLOCK ? "BLOCK" : "LINE");
             }
         }
@@ -64,13 +72,12 @@ int main() {
     // Manual distance calculation to debug
     printf("\nManual distance calculation:\n");
     for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
+        Token_t* token = &tokens[i];
         if (token->type == TOKEN_COMMENT_BLOCK && token->line == 281) {
             int newline_count = 0;
-            if (token->value) {
-                for (char* p = token->value; *p; p++) {
-                    if (*p == '\n') newline_count++;
-                }
+            const char* text = c_parser_token_text(parsed->source, token);
+            for (int p = 0; p < token->length; p++) {
+                if (text[p] == '\n') newline_count++;
             }
             int comment_end_line = token->line + newline_count;
             int distance = target_func->line_number - comment_end_line;
@@ -28,30 +28,305 @@ typedef enum {
     TOKEN_COMMENT_LINE,     // Line comments (//)
     TOKEN_COMMENT_BLOCK,    // Block comments (/* */)
     TOKEN_PREPROCESSOR,     // Preprocessor directives (#include, #define)
-    TOKEN_NEWLINE,          // Newline characters
+    TOKEN_NEWLINE,          // Newline characters (never emitted; lines live in LineIndex_t)
     TOKEN_EOF               // End of file
 } TokenType_t;
 
+/*
+ * Recognised word sets as X-macros: X(ID, "text")
+ *
+ * -- Single source of truth for the ID enums below and for the perfect hash
+ *    tables that tools/gen_perfect_hash.c generates at build time
+ * -- Adding a word here is all that is needed; the tables are regenerated
+ */
+#define C_PARSER_C_KEYWORDS(X) \
+    X(AUTO,          "auto") \
+    X(BREAK,         "break") \
+    X(CASE,          "case") \
+    X(CHAR,          "char") \
+    X(CONST,         "const") \
+    X(CONTINUE,      "continue") \
+    X(DEFAULT,       "default") \
+    X(DO,            "do") \
+    X(DOUBLE,        "double") \
+    X(ELSE,          "else") \
+    X(ENUM,          "enum") \
+    X(EXTERN,        "extern") \
+    X(FLOAT,         "float") \
+    X(FOR,           "for") \
+    X(GOTO,          "goto") \
+    X(IF,            "if") \
+    X(INLINE,        "inline") \
+    X(INT,           "int") \
+    X(LONG,          "long") \
+    X(REGISTER,      "register") \
+    X(RESTRICT,      "restrict") \
+    X(RETURN,        "return") \
+    X(SHORT,         "short") \
+    X(SIGNED,        "signed") \
+    X(SIZEOF,        "sizeof") \
+    X(STATIC,        "static") \
+    X(STRUCT,        "struct") \
+    X(SWITCH,        "switch") \
+    X(TYPEDEF,       "typedef") \
+    X(UNION,         "union") \
+    X(UNSIGNED,      "unsigned") \
+    X(VOID,          "void") \
+    X(VOLATILE,      "volatile") \
+    X(WHILE,         "while") \
+    X(BOOL,          "_Bool") \
+    X(COMPLEX,       "_Complex") \
+    X(IMAGINARY,     "_Imaginary") \
+    X(STATIC_ASSERT, "_Static_assert") \
+    X(THREAD_LOCAL,  "_Thread_local") \
+    X(ALIGNAS,       "_Alignas") \
+    X(ALIGNOF,       "_Alignof") \
+    X(ATOMIC,        "_Atomic") \
+    X(GENERIC,       "_Generic") \
+    X(NORETURN,      "_Noreturn")
+
+#define C_PARSER_TYPE_KEYWORDS(X) \
+    X(INT,      "int") \
+    X(CHAR,     "char") \
+    X(FLOAT,    "float") \
+    X(DOUBLE,   "double") \
+    X(VOID,     "void") \
+    X(BOOL,     "bool") \
+    X(SIZE_T,   "size_t") \
+    X(UINT8_T,  "uint8_t") \
+    X(UINT16_T, "uint16_t") \
+    X(UINT32_T, "uint32_t") \
+    X(UINT64_T, "uint64_t") \
+    X(INT8_T,   "int8_t") \
+    X(INT16_T,  "int16_t") \
+    X(INT32_T,  "int32_t") \
+    X(INT64_T,  "int64_t") \
+    X(FILE,     "FILE") \
+    X(NULL,     "NULL") \
+    X(TRUE,     "true") \
+    X(FALSE,    "false")
+
+#define C_PARSER_DANGEROUS_FUNCTIONS(X) \
+    X(GETS,      "gets") \
+    X(STRCPY,    "strcpy") \
+    X(STRCAT,    "strcat") \
+    X(SPRINTF,   "sprintf") \
+    X(VSPRINTF,  "vsprintf") \
+    X(STRLEN,    "strlen") \
+    X(STRNCPY,   "strncpy") \
+    X(STRNCAT,   "strncat") \
+    X(SNPRINTF,  "snprintf") \
+    X(VSNPRINTF, "vsnprintf") \
+    X(MALLOC,    "malloc") \
+    X(CALLOC,    "calloc") \
+    X(REALLOC,   "realloc") \
+    X(FREE,      "free") \
+    X(PRINTF,    "printf") \
+    X(FPRINTF,   "fprintf")
+
+#define C_PARSER_KEYWORD_ENUM(id, text) C_KEYWORD_##id,
+#define C_PARSER_TYPE_KEYWORD_ENUM(id, text) C_TYPE_##id,
+#define C_PARSER_DANGEROUS_FUNCTION_ENUM(id, text) C_DANGEROUS_##id,
+
+/*
+ * C language keyword IDs - 0 means "not a keyword"
+ */
+typedef enum {
+    C_KEYWORD_NONE = 0,
+    C_PARSER_C_KEYWORDS(C_PARSER_KEYWORD_ENUM)
+    C_KEYWORD_COUNT
+} CKeywordId_t;
+
+/*
+ * Type keyword and common type identifier IDs - 0 means "not a type word"
+ */
+typedef enum {
+    C_TYPE_NONE = 0,
+    C_PARSER_TYPE_KEYWORDS(C_PARSER_TYPE_KEYWORD_ENUM)
+    C_TYPE_COUNT
+} CTypeKeywordId_t;
+
+/*
+ * Dangerous function IDs - 0 means "not a dangerous function"
+ */
+typedef enum {
+    C_DANGEROUS_NONE = 0,
+    C_PARSER_DANGEROUS_FUNCTIONS(C_PARSER_DANGEROUS_FUNCTION_ENUM)
+    C_DANGEROUS_COUNT
+} CDangerousFunctionId_t;
+
+/*
+ * Token sub-kinds: which punctuator, operator or keyword a token is
+ *
+ * -- Lets analyses compare integers instead of token text
+ * -- TOKEN_SUB_NONE for identifiers, literals, comments and preprocessor lines
+ * -- Keyword sub-kinds follow C_PARSER_C_KEYWORDS order; convert with
+ *    TOKEN_SUB_FROM_KEYWORD() and TOKEN_SUB_TO_KEYWORD()
+ * -- Values fit in a byte so tokens can store them compactly
+ */
+#define C_PARSER_KEYWORD_SUB_KIND_ENUM(id, text) KW_##id,
+
+typedef enum {
+    TOKEN_SUB_NONE = 0,
+
+    // Punctuation
+    PUNCT_LPAREN,           // (
+    PUNCT_RPAREN,           // )
+    PUNCT_LBRACE,           // {
+    PUNCT_RBRACE,           // }
+    PUNCT_LBRACKET,         // [
+    PUNCT_RBRACKET,         // ]
+    PUNCT_SEMICOLON,        // ;
+    PUNCT_COMMA,            // ,
+    PUNCT_DOT,              // .
+
+    // Operators
+    OP_PLUS,                // +
+    OP_MINUS,               // -
+    OP_STAR,                // *
+    OP_SLASH,               // /
+    OP_PERCENT,             // %
+    OP_ASSIGN,              // =
+    OP_LESS,                // <
+    OP_GREATER,             // >
+    OP_NOT,                 // !
+    OP_AMPERSAND,           // &
+    OP_PIPE,                // |
+    OP_CARET,               // ^
+    OP_TILDE,               // ~
+    OP_QUESTION,            // ?
+    OP_COLON,               // :
+    OP_EQUAL,               // ==
+    OP_NOT_EQUAL,           // !=
+    OP_LESS_EQUAL,          // <=
+    OP_GREATER_EQUAL,       // >=
+    OP_LOGICAL_AND,         // &&
+    OP_LOGICAL_OR,          // ||
+    OP_INCREMENT,           // ++
+    OP_DECREMENT,           // --
+    OP_SHIFT_LEFT,          // <<
+    OP_SHIFT_RIGHT,         // >>
+    OP_PLUS_ASSIGN,         // +=
+    OP_MINUS_ASSIGN,        // -=
+    OP_STAR_ASSIGN,         // *=
+    OP_SLASH_ASSIGN,        // /=
+    OP_PERCENT_ASSIGN,      // %=
+    OP_AND_ASSIGN,          // &=
+    OP_OR_ASSIGN,           // |=
+    OP_XOR_ASSIGN,          // ^=
+    OP_ARROW,               // ->
+
+    // Keywords
+    C_PARSER_C_KEYWORDS(C_PARSER_KEYWORD_SUB_KIND_ENUM)
+
+    TOKEN_SUB_COUNT
+} TokenSubKind_t;
+
+#define TOKEN_SUB_FROM_KEYWORD(keyword_id) ((TokenSubKind_t)(KW_AUTO + ((keyword_id) - C_KEYWORD_AUTO)))
+#define TOKEN_SUB_TO_KEYWORD(sub_kind) ((CKeywordId_t)(C_KEYWORD_AUTO + ((sub_kind) - KW_AUTO)))
+
 /*
  * Individual token with position and content information
+ *
+ * -- Tokens do not own their text: `offset` and `length` describe a view into
+ *    the source buffer they were lexed from (ParsedFile_t::source, or the
+ *    content passed to c_parser_tokenize())
+ * -- The view is NOT null-terminated; use the c_parser_token_* accessors below
  */
 typedef struct {
     TokenType_t type;       // Type of this token
-    char* value;            // String content of the token
+    uint32_t offset;        // Byte offset of the token text in the source buffer
     int line;               // Line number (1-based)
     int column;             // Column number (1-based)
     int length;             // Length of the token in characters
+    uint8_t sub_kind;       // TokenSubKind_t for punctuation, operators and keywords
 } Token_t;
 
+/*
+ * Struct-of-arrays token storage owned by a parsed file
+ *
+ * -- Token i is described by element i of every array
+ * -- Passes that only need kinds (and maybe lines) read one or two dense
+ *    arrays instead of striding over whole Token_t records
+ * -- Tokens are in source order, so `lines` is non-decreasing and can be
+ *    binary searched
+ * -- Columns are not stored; they come from the offset and the LineIndex_t
+ * -- Use c_parser_token_at() or c_parser_tokens() when a full Token_t is wanted
+ */
+typedef struct {
+    uint8_t* kinds;         // TokenType_t of each token
+    uint8_t* sub_kinds;     // TokenSubKind_t of each token
+    uint32_t* offsets;      // Byte offset of each token in the source buffer
+    int32_t* lengths;       // Length of each token in bytes
+    int32_t* lines;         // Line number of each token (1-based)
+    int count;              // Number of tokens stored
+    int capacity;           // Allocated elements in each array
+} TokenStore_t;
+
+/*
+ * Line-start table for a source buffer
+ *
+ * -- starts[i] is the byte offset where line i + 1 begins; starts[0] is 0
+ * -- Built by the tokenizer with one memchr sweep, 4 bytes per line
+ * -- Offset to line/column is a binary search: see c_parser_offset_to_line_column()
+ */
+typedef struct {
+    uint32_t* starts;       // Byte offset of the first character of each line
+    int count;              // Number of lines (at least 1 for any source)
+} LineIndex_t;
+
+/*
+ * Read-only bytes of a source file, memory-mapped or read into the heap
+ *
+ * -- `data[length]` is always a '\0' sentinel, so the buffer is a C string
+ * -- Regular files are mmap()ed; pipes, special files and files whose size
+ *    leaves no room for the sentinel in the last page fall back to read()
+ * -- `mapping` is NULL when `data` is a heap buffer owned by the input
+ */
+typedef struct {
+    const char* data;       // File contents followed by '\0'
+    size_t length;          // Bytes before the first '\0'
+    void* mapping;          // mmap() base, or NULL for heap-backed input
+    size_t mapping_length;  // Length passed to munmap()
+} SourceInput_t;
+
+struct ArenaChunk;
+
+/*
+ * Bump allocator owning many small allocations that are freed together
+ *
+ * -- Zero-initialize to get an empty arena; nothing is allocated until first use
+ * -- Memory is released all at once with c_parser_arena_release()
+ */
+typedef struct {
+    struct ArenaChunk* head;    // Chunk being filled; older chunks follow it
+    size_t used;                // Bytes handed out from `head`
+} Arena_t;
+
+/*
+ * Identifier for a string interned in a run's atom table
+ *
+ * -- Equal strings intern to the same atom on every thread within a table, so
+ *    comparing atoms stands in for strcmp() when c_parser_atoms_comparable()
+ * -- Each parse cache run interns into a fresh table; a parse keeps the table it
+ *    used alive, so a long-lived process holds only the strings live parses use
+ * -- ATOM_NONE is never handed out; it marks a string that was not interned
+ */
+typedef uint32_t Atom_t;
+
+#define ATOM_NONE 0
+
 /*
  * Parser context for tracking position during tokenization
+ *
+ * -- Only byte positions are tracked; lines and columns are resolved
+ *    afterwards from the LineIndex_t
  */
 typedef struct {
     const char* source;     // Source code being parsed
     size_t source_length;   // Total length of source
     size_t position;        // Current position in source
-    int line;               // Current line number
-    int column;             // Current column number
+    size_t token_start;     // Offset where the token being lexed begins
 } ParserContext_t;
 
 // =============================================================================
@@ -72,6 +347,11 @@ typedef struct {
     bool is_static;         // Whether function is static
     bool is_inline;         // Whether function is inline
     bool has_documentation; // Whether function has associated comments
+    int body_start;         // Token index of the body's '{' (-1 for a declaration)
+    int body_end;           // Token index of the matching '}' (-1 if never closed)
+    int doc_comment;        // Token index of the nearest block comment above (-1 if none)
+    Atom_t name_atom;       // Interned `name` (ATOM_NONE if built outside the parser)
+    Atom_t return_type_atom; // Interned `return_type`
 } FunctionInfo_t;
 
 /*
@@ -86,26 +366,75 @@ typedef struct {
     bool has_deep_nesting;      // Whether function has deep nesting (>3 levels)
 } ComplexityAnalysis_t;
 
+/*
+ * Token range of one call argument
+ */
+typedef struct {
+    int start;              // First token of the argument
+    int end;                // One past its last token (the ',' or ')')
+} CallArgRange_t;
+
+/*
+ * One call expression: an `identifier (` that is not a function definition or declaration
+ *
+ * -- Recorded in token order by the same sweep that finds functions
+ * -- `dangerous_id` is the callee's ID in the dangerous-function set, so unsafe
+ *    call rules never hash the name again; other callees are read from the token
+ */
+typedef struct {
+    int token_index;                    // Callee identifier; its '(' is token_index + 1
+    int close_paren;                    // Matching ')', or -1 if the call is never closed
+    int function_index;                 // Enclosing definition in `functions`, or -1
+    int first_arg;                      // First of this call's ranges in `call_args`
+    int arg_count;                      // Top-level arguments (0 for an unclosed call)
+    CDangerousFunctionId_t dangerous_id;
+} CallSite_t;
+
+struct ParseCacheEntry;
+
 /*
  * Complete parsed file structure containing all extracted information
  */
 typedef struct {
     char* file_path;        // Path to the source file
 
-    // Tokens
-    Token_t* tokens;        // Array of all tokens
-    int token_count;        // Number of tokens
-    size_t token_capacity;  // Allocated capacity for tokens
+    // Source buffer - owned by the parsed file, referenced by every token
+    const char* source;     // Null-terminated parsed content (same as input.data)
+    size_t source_length;   // Length of source in bytes
+    SourceInput_t input;    // Mapping or heap buffer backing `source`
+
+    // Tokens - stored column-wise; `tokens` is an on-demand Token_t[] view of the store
+    TokenStore_t token_store;   // Struct-of-arrays token storage
+    int token_count;            // Number of tokens (same as token_store.count)
+    Token_t* tokens;            // Built by c_parser_tokens(), NULL until first requested
+    LineIndex_t line_index;     // Start offset of every line in `source`
 
     // Functions
     FunctionInfo_t* functions;     // Array of detected functions
     int function_count;            // Number of functions
-    size_t function_capacity;      // Allocated capacity for functions
+    int function_capacity;         // Allocated capacity for functions
+    int* function_index;           // Open-addressed name slots holding function index + 1, 0 if empty
+    uint32_t function_index_mask;  // Slot count - 1
 
     // Includes
-    char** includes;        // Array of include file names
+    char** includes;        // Array of include file names (strings live in `arena`)
     int include_count;      // Number of includes
-    size_t include_capacity; // Allocated capacity for includes
+    int include_capacity;   // Allocated capacity for includes
+
+    // Calls - built by the same sweep that finds functions
+    CallSite_t* calls;          // Every call expression, in token order
+    int call_count;             // Number of calls
+    CallArgRange_t* call_args;  // Argument ranges, contiguous per call
+    int call_arg_count;         // Total argument ranges
+
+    // Names, return types, parameters, documentation and include strings
+    Arena_t arena;
+
+    // Set on handles from c_parser_acquire_file() that share a cached parse, else NULL
+    struct ParseCacheEntry* cache_entry;
+
+    // Atom table the names, return types and includes were interned in; held until freed
+    struct AtomTable* atoms;
 } ParsedFile_t;
 
 // =============================================================================
@@ -121,6 +450,7 @@ typedef struct {
  * `Token_t*` - Array of tokens, or NULL on failure
  *
  * -- Must be freed with c_parser_free_tokens() to prevent memory leaks
+ * -- Tokens are views into `content`, which must outlive the returned array
  * -- Handles all C language constructs including comments and preprocessor
  * -- Preserves exact line and column position information for each token
  * -- Supports multi-character operators (==, <=, >=, etc.)
@@ -156,14 +486,257 @@ ParsedFile_t* c_parser_parse_content(const char* content, const char* file_path)
  * `ParsedFile_t*` - Complete parsed file structure, or NULL on failure
  *
  * -- Must be freed with c_parser_free_parsed_file() to prevent memory leaks
- * -- Reads entire file into memory before parsing for optimal performance
- * -- Handles files of any reasonable size with efficient memory management
- * -- Returns NULL if file cannot be opened, read, or parsed
- * -- Automatically detects file encoding issues and truncated reads
- * -- Convenience wrapper around c_parser_parse_content() for file operations
+ * -- Maps the file with c_parser_input_open(); tokens point into the mapping
+ * -- Returns NULL if file cannot be opened, read, or parsed, or is empty
+ * -- Convenience wrapper around c_parser_parse_input() for file operations
  */
 ParsedFile_t* c_parser_parse_file(const char* file_path);
 
+/*
+ * Parse an opened source input, taking ownership of its buffer
+ *
+ * `input` - Input from c_parser_input_open(); reset to empty on return
+ * `file_path` - File path for reference and error reporting (can be NULL)
+ *
+ * `ParsedFile_t*` - Complete parsed file structure, or NULL on failure
+ *
+ * -- The buffer is moved into the parsed file without copying and released
+ *    by c_parser_free_parsed_file(), or immediately on failure
+ * -- Closing `input` afterwards is a harmless no-op
+ */
+ParsedFile_t* c_parser_parse_input(SourceInput_t* input, const char* file_path);
+
+// =============================================================================
+// SOURCE INPUT
+// =============================================================================
+
+/*
+ * Open a source file as a read-only, null-terminated buffer
+ *
+ * `file_path` - Path to the file to open
+ * `input` - Output input; zeroed on failure
+ *
+ * `bool` - true on success, false if the file cannot be opened or read
+ *
+ * -- Regular files are mmap()ed with a sequential-access hint, so the kernel
+ *    touches each page once and nothing is copied in userspace
+ * -- Pipes, character devices and other unmappable files are read() instead
+ * -- Reading a mapping faults if another process truncates the file meanwhile,
+ *    so parses kept by a resident cache are read() as well
+ * -- Empty files succeed with an empty string
+ * -- Must be released with c_parser_input_close() or c_parser_parse_input()
+ */
+bool c_parser_input_open(const char* file_path, SourceInput_t* input);
+
+/*
+ * Open a source file relative to an open directory
+ *
+ * `dir_fd` - Directory to resolve `file_name` against (AT_FDCWD for the working directory)
+ * `file_name` - Name of the file within it
+ * `input` - Output input; zeroed on failure
+ *
+ * `bool` - true on success, false if the file cannot be opened or read
+ *
+ * -- As c_parser_input_open(), for files whose full path is too long to open
+ */
+bool c_parser_input_open_at(int dir_fd, const char* file_name, SourceInput_t* input);
+
+/*
+ * Release a source input's mapping or heap buffer
+ *
+ * `input` - Input to release; reset to empty
+ *
+ * -- Safe to call with NULL or an already closed input (does nothing)
+ */
+void c_parser_input_close(SourceInput_t* input);
+
+// =============================================================================
+// PARSE CACHE
+// =============================================================================
+
+/*
+ * Start a run-scoped parse cache
+ *
+ * -- While a run is active c_parser_acquire_file() reads and parses each file once
+ * -- Runs nest: only the outermost c_parser_cache_end() empties the cache
+ * -- Headers stay cached for the whole run; any other file is dropped as soon as
+ *    its last handle is released, since nothing else is expected to ask for it
+ * -- A file that changes on disk during a run replaces its earlier parse, so a
+ *    run may stay open indefinitely (as `metis serve` keeps one)
+ * -- Thread-safe
+ */
+void c_parser_cache_begin(void);
+
+/*
+ * End a run started with c_parser_cache_begin()
+ *
+ * -- Entries still held by a handle are freed when their last handle is released
+ * -- Retires the current atom table, nested runs included: later parses intern
+ *    into a fresh one, and the old one is freed with the last parse using it
+ */
+void c_parser_cache_end(void);
+
+/*
+ * Keep every file, not just headers, cached until the outermost run ends
+ *
+ * `resident` - true to keep sources too, false to drop them once unused again
+ *
+ * -- For a long-lived run that is asked for the same sources repeatedly, such as
+ *    `metis serve`; an unchanged file is then never re-parsed
+ * -- Resident parses read their file into memory instead of mapping it, since a
+ *    mapping kept that long would fault if an editor truncated the file
+ * -- Applies to files first parsed after the call
+ */
+void c_parser_cache_set_resident(bool resident);
+
+/*
+ * Get the parsed form of a file, parsing it only on first use within a run
+ *
+ * `file_path` - Path to the file; also becomes the handle's `file_path`
+ *
+ * `ParsedFile_t*` - Parsed file handle, or NULL if the file cannot be read or parsed
+ *
+ * -- Must be released with c_parser_release_file()
+ * -- Entries are keyed by canonical path plus device, inode, size and mtime, so
+ *    different spellings of one path share a parse and an edited file is re-parsed
+ * -- The handle is shared with other callers and threads: treat it as read-only.
+ *    Lazily computed state (token view, documentation flags) is resolved up front
+ * -- Concurrent first requests for one file wait for a single parse
+ * -- Empty files parse to an empty structure; outside a run each call parses afresh
+ */
+ParsedFile_t* c_parser_acquire_file(const char* file_path);
+
+/*
+ * Release a handle from c_parser_acquire_file()
+ *
+ * `parsed` - Handle to release
+ *
+ * -- Safe to call with NULL pointer (does nothing)
+ * -- Frees the parse itself once the run has ended and no handle remains
+ */
+void c_parser_release_file(ParsedFile_t* parsed);
+
+// =============================================================================
+// PARSE BUFFER POOL
+// =============================================================================
+
+/*
+ * Start recycling parse buffers on the calling thread
+ *
+ * -- While open, freeing a parse on this thread keeps its token, function and
+ *    include arrays for the thread's next parse instead of returning them to malloc
+ * -- Calls nest; only the outermost c_parser_pool_end() frees what was kept
+ * -- Per-thread: each worker of a parallel run opens its own pool
+ */
+void c_parser_pool_begin(void);
+
+/*
+ * Stop recycling parse buffers on the calling thread and free the kept ones
+ *
+ * -- Does nothing if the thread has no open pool
+ */
+void c_parser_pool_end(void);
+
+// =============================================================================
+// ARENA ALLOCATION
+// =============================================================================
+
+/*
+ * Allocate uninitialized memory from an arena
+ *
+ * `arena` - Arena to allocate from
+ * `size` - Bytes needed
+ *
+ * `void*` - Suitably aligned memory, or NULL if arena is NULL or memory ran out
+ *
+ * -- Valid until the arena is released; never free() it directly
+ * -- Chunks come from a per-thread pool of recently released ones, so a
+ *    worker reuses the same memory file after file without locking
+ */
+void* c_parser_arena_alloc(Arena_t* arena, size_t size);
+
+/*
+ * Copy `length` bytes into an arena as a null-terminated string
+ *
+ * `arena` - Arena to allocate from
+ * `text` - Bytes to copy (need not be null-terminated)
+ * `length` - Number of bytes to copy
+ *
+ * `char*` - Arena-owned copy, or NULL on failure
+ */
+char* c_parser_arena_strndup(Arena_t* arena, const char* text, size_t length);
+
+/*
+ * Copy a null-terminated string into an arena
+ *
+ * `arena` - Arena to allocate from
+ * `text` - String to copy
+ *
+ * `char*` - Arena-owned copy, or NULL if text is NULL or memory ran out
+ */
+char* c_parser_arena_strdup(Arena_t* arena, const char* text);
+
+/*
+ * Move every allocation of `src` into `dst`
+ *
+ * -- Pointers into `src` stay valid and now live as long as `dst`
+ * -- `src` is left empty
+ */
+void c_parser_arena_adopt(Arena_t* dst, Arena_t* src);
+
+/*
+ * Release everything allocated from an arena
+ *
+ * `arena` - Arena to release
+ *
+ * -- Safe to call with NULL or an empty arena (does nothing)
+ * -- Standard-size chunks go back to the calling thread's pool for reuse;
+ *    the arena is left empty and can be allocated from again
+ */
+void c_parser_arena_release(Arena_t* arena);
+
+// =============================================================================
+// ATOM TABLE
+// =============================================================================
+
+/*
+ * Intern a string, adding it to the current run's table on first use
+ *
+ * `text` - Bytes to intern (need not be null-terminated)
+ * `length` - Number of bytes
+ *
+ * `Atom_t` - The string's atom, or ATOM_NONE if text is NULL or memory ran out
+ *
+ * -- Thread-safe; the table is split into independently locked shards
+ * -- The atom and its text stay valid until c_parser_cache_end() retires the
+ *    table and the last parse interned in it is freed
+ */
+Atom_t c_parser_intern(const char* text, size_t length);
+
+/*
+ * Look up a string's atom in the current run's table without adding it
+ *
+ * `Atom_t` - The atom, or ATOM_NONE if the string was not interned in this table
+ */
+Atom_t c_parser_atom_find(const char* text, size_t length);
+
+/*
+ * Get the null-terminated text of an atom
+ *
+ * `const char*` - Interned text, or NULL for ATOM_NONE or an unknown atom
+ *
+ * -- The text is shared by every holder of the atom; never modify or free it
+ */
+const char* c_parser_atom_text(Atom_t atom);
+
+/*
+ * Check whether two atoms come from the same table
+ *
+ * `bool` - true if the atoms are equal exactly when their strings are;
+ *          false if either is ATOM_NONE or they were interned in different runs
+ */
+bool c_parser_atoms_comparable(Atom_t first, Atom_t second);
+
 // =============================================================================
 // MEMORY MANAGEMENT
 // =============================================================================
@@ -175,7 +748,7 @@ ParsedFile_t* c_parser_parse_file(const char* file_path);
  * `count` - Number of tokens in the array
  *
  * -- Safe to call with NULL pointer (does nothing)
- * -- Frees all token value strings and the token array itself
+ * -- Frees the token array itself; token text lives in the source buffer
  * -- Must be called for every array returned by c_parser_tokenize()
  * -- After calling, the tokens pointer becomes invalid
  */
@@ -187,17 +760,174 @@ void c_parser_free_tokens(Token_t* tokens, int count);
  * `parsed` - Parsed file structure to free
  *
  * -- Safe to call with NULL pointer (does nothing)
- * -- Frees all tokens, functions, includes, and file path strings
- * -- Recursively frees all dynamically allocated strings and arrays
+ * -- Frees the source buffer, token store and view, line index and arrays; the
+ *    strings they reference are released with the arena in one step
+ * -- Handles from c_parser_acquire_file() are passed on to c_parser_release_file()
  * -- Must be called for every structure returned by parse functions
  * -- After calling, the parsed pointer becomes invalid
  */
 void c_parser_free_parsed_file(ParsedFile_t* parsed);
 
+// =============================================================================
+// TOKEN TEXT ACCESSORS
+// =============================================================================
+
+/*
+ * Get a pointer to a token's text inside its source buffer
+ *
+ * `source` - Source buffer the token was lexed from (e.g. parsed->source)
+ * `token` - Token to view
+ *
+ * `const char*` - Start of the token text, or NULL if either argument is NULL
+ *
+ * -- The text is NOT null-terminated; it spans exactly token->length bytes
+ * -- Print with "%.*s", token->length, c_parser_token_text(source, token)
+ * -- Valid for as long as the source buffer is alive
+ */
+const char* c_parser_token_text(const char* source, const Token_t* token);
+
+/*
+ * Check whether a token's text is exactly equal to a string
+ *
+ * `source` - Source buffer the token was lexed from
+ * `token` - Token to compare
+ * `text` - Null-terminated string to compare against
+ *
+ * `bool` - true if the token text matches `text` byte for byte
+ *
+ * -- Returns false if any argument is NULL
+ * -- Compares lengths first, so mismatches are usually rejected in O(1)
+ */
+bool c_parser_token_equals(const char* source, const Token_t* token, const char* text);
+
+/*
+ * Check whether a token's text contains a substring
+ *
+ * `source` - Source buffer the token was lexed from
+ * `token` - Token to search
+ * `pattern` - Null-terminated substring to look for
+ *
+ * `bool` - true if `pattern` occurs anywhere in the token text
+ *
+ * -- Returns false if any argument is NULL
+ * -- Bounded by token->length, never reads past the token view
+ */
+bool c_parser_token_contains(const char* source, const Token_t* token, const char* pattern);
+
+/*
+ * Copy a token's text into a caller-provided buffer
+ *
+ * `source` - Source buffer the token was lexed from
+ * `token` - Token to copy
+ * `buffer` - Destination buffer
+ * `buffer_size` - Size of destination buffer in bytes
+ *
+ * `size_t` - Number of bytes copied (excluding the terminator)
+ *
+ * -- Always null-terminates when buffer_size > 0
+ * -- Truncates tokens longer than buffer_size - 1
+ * -- Returns 0 if any pointer argument is NULL or buffer_size is 0
+ */
+size_t c_parser_token_copy_to(const char* source, const Token_t* token, char* buffer, size_t buffer_size);
+
+/*
+ * Allocate a null-terminated copy of a token's text
+ *
+ * `source` - Source buffer the token was lexed from
+ * `token` - Token to copy
+ *
+ * `char*` - Newly allocated string, or NULL on failure
+ *
+ * -- Caller must free the returned string
+ * -- Intended for cold paths; hot loops should use the view accessors
+ */
+char* c_parser_token_strdup(const char* source, const Token_t* token);
+
+/*
+ * Gather one token of a parsed file from its struct-of-arrays store
+ *
+ * `parsed` - Parsed file to read from
+ * `index` - Token index (0-based)
+ *
+ * `Token_t` - The token by value, or a zeroed TOKEN_EOF token if out of range
+ *
+ * -- Cheap enough for cold paths that want a Token_t for the text accessors
+ * -- Hot scans should read parsed->token_store arrays directly
+ */
+Token_t c_parser_token_at(const ParsedFile_t* parsed, int index);
+
+/*
+ * Convert a byte offset in a parsed file's source to a line and column
+ *
+ * `parsed` - Parsed file whose line index to search
+ * `offset` - Byte offset into parsed->source
+ * `line_out` - Output: line number (1-based), may be NULL
+ * `column_out` - Output: column number (1-based, in bytes), may be NULL
+ *
+ * `bool` - true on success, false if parsed is NULL or offset is past the end
+ *
+ * -- O(log lines) binary search over parsed->line_index
+ * -- An offset equal to source_length maps to the end of the last line
+ */
+bool c_parser_offset_to_line_column(const ParsedFile_t* parsed, uint32_t offset, int* line_out, int* column_out);
+
+/*
+ * Get a Token_t array view of a parsed file's tokens
+ *
+ * `parsed` - Parsed file to read from
+ *
+ * `Token_t*` - Array of parsed->token_count tokens, or NULL on failure
+ *
+ * -- Adapter for code written against the array-of-structs layout
+ * -- Built on first call and cached in parsed->tokens; later calls are free
+ * -- Owned by the parsed file; do not free it
+ * -- Not thread-safe on first call for a given parsed file
+ */
+Token_t* c_parser_tokens(ParsedFile_t* parsed);
+
 // =============================================================================
 // LANGUAGE RECOGNITION UTILITIES
 // =============================================================================
 
+/*
+ * Look up the keyword ID of a word with a perfect hash
+ *
+ * `text` - Start of the word (need not be null-terminated)
+ * `length` - Length of the word in bytes
+ *
+ * `CKeywordId_t` - Keyword ID, or C_KEYWORD_NONE if the word is not a keyword
+ *
+ * -- One hash and at most one comparison; safe on the tokenizer hot path
+ * -- Works directly on token views: c_parser_keyword_id(source + t->offset, t->length)
+ * -- Returns C_KEYWORD_NONE if text is NULL
+ */
+CKeywordId_t c_parser_keyword_id(const char* text, size_t length);
+
+/*
+ * Look up the type keyword ID of a word with a perfect hash
+ *
+ * `text` - Start of the word (need not be null-terminated)
+ * `length` - Length of the word in bytes
+ *
+ * `CTypeKeywordId_t` - Type keyword ID, or C_TYPE_NONE if the word is not a type word
+ *
+ * -- Returns C_TYPE_NONE if text is NULL
+ */
+CTypeKeywordId_t c_parser_type_keyword_id(const char* text, size_t length);
+
+/*
+ * Look up the dangerous function ID of a name with a perfect hash
+ *
+ * `text` - Start of the name (need not be null-terminated)
+ * `length` - Length of the name in bytes
+ *
+ * `CDangerousFunctionId_t` - Dangerous function ID, or C_DANGEROUS_NONE if the name is safe
+ *
+ * -- Returns C_DANGEROUS_NONE if text is NULL
+ * -- Callers switch on the ID to pick per-function advice
+ */
+CDangerousFunctionId_t c_parser_dangerous_function_id(const char* text, size_t length);
+
 /*
  * Check if a word is a standard C language keyword
  *
@@ -273,26 +1003,55 @@ const char* c_parser_token_type_name(TokenType_t type);
  * -- Returns NULL if parsed is NULL or no function found at line
  * -- Returned pointer is valid until parsed structure is freed
  * -- Only finds functions that start exactly on the specified line
+ * -- Binary search: functions are recorded in source order
  * -- Used for IDE integration and precise error reporting
  * -- Essential for documentation linting of specific functions
  */
 FunctionInfo_t* c_parser_find_function_at_line(ParsedFile_t* parsed, int line);
 
+/*
+ * Find a function by name
+ *
+ * `parsed` - Parsed file structure to search
+ * `name` - Function name to look up (must be null-terminated)
+ *
+ * `FunctionInfo_t*` - Pointer to function info, or NULL if not found
+ *
+ * -- Returns NULL if parsed or name is NULL or no function has that name
+ * -- Returned pointer is valid until parsed structure is freed
+ * -- Hashed lookup through the name index built with the parse
+ * -- When a name repeats (prototype, then definition) the first one is returned
+ */
+FunctionInfo_t* c_parser_find_function(const ParsedFile_t* parsed, const char* name);
 
 /*
- * Check if a specific line contains a text pattern
+ * Find a function by interned name
  *
  * `parsed` - Parsed file structure to search
- * `line` - Line number to check (1-based)
- * `pattern` - Text pattern to search for (must be null-terminated)
+ * `name_atom` - Atom of the function name, e.g. another file's `name_atom`
  *
- * `bool` - true if pattern found on line, false otherwise
+ * `FunctionInfo_t*` - Pointer to function info, or NULL if not found
  *
- * -- Returns false if parsed or pattern is NULL
- * -- Searches through all tokens on the specified line
- * -- Uses substring matching (strstr) for flexible pattern detection
- * -- Case-sensitive pattern matching
- * -- Used for custom linting rules and pattern-based analysis
+ * -- Same result as c_parser_find_function() without hashing the name again,
+ *    unless the atom is from another run's table and its name is looked up
+ * -- Returns NULL for ATOM_NONE
+ */
+FunctionInfo_t* c_parser_find_function_atom(const ParsedFile_t* parsed, Atom_t name_atom);
+
+
+/*
+ * Check whether a function has a documentation comment
+ *
+ * `parsed` - Parsed file structure containing the function
+ * `func_name` - Name of function to check (must be null-terminated)
+ *
+ * `bool` - true if the function's documentation was found, false otherwise
+ *
+ * -- Returns false if parsed, func_name is NULL or function not found
+ * -- Reads the association the parser made; callers holding the
+ *    FunctionInfo_t can read has_documentation directly
+ * -- A block comment documents a function when it ends at most 3 lines
+ *    above it with only comments or preprocessor lines in between
 */
 bool c_parser_has_documentation_for_function(ParsedFile_t* parsed, const char* func_name);
 
@@ -306,7 +1065,8 @@ bool c_parser_has_documentation_for_function(ParsedFile_t* parsed, const char* f
  * `bool` - true if pattern found on line, false otherwise
  *
  * -- Returns false if parsed or pattern is NULL
- * -- Searches through all tokens on the specified line
+ * -- Searches through all tokens starting on the specified line
+ * -- Finds the line's first token by binary search over token_store.lines
  * -- Uses substring matching (strstr) for flexible pattern detection
  * -- Case-sensitive pattern matching
  * -- Used for custom linting rules and pattern-based analysis
@@ -336,6 +1096,20 @@ typedef struct {
  */
 bool c_parser_detect_unsafe_strcmp_dstring_usage(ParsedFile_t* parsed, UnsafeStrcmpUsage_t** usages, int* count);
 
+/*
+ * Check one call for an unsafe strcmp on a dString_t's str member
+ *
+ * `parsed` - Parsed file structure
+ * `token_index` - Token to check; only a `strcmp` identifier followed by '(' can match
+ * `usage` - Filled in when the call is unsafe
+ *
+ * `bool` - true if the call compares dString_t->str with strcmp
+ *
+ * -- The per-call form of c_parser_detect_unsafe_strcmp_dstring_usage(), so
+ *    a caller already sweeping the tokens can run the check without a second pass
+ */
+bool c_parser_match_unsafe_strcmp(ParsedFile_t* parsed, int token_index, UnsafeStrcmpUsage_t* usage);
+
 /*
  * Analyze function complexity with mathematical precision for philosophical guidance
  *
@@ -354,6 +1128,22 @@ bool c_parser_detect_unsafe_strcmp_dstring_usage(ParsedFile_t* parsed, UnsafeStr
  */
 ComplexityAnalysis_t c_parser_analyze_function_complexity(ParsedFile_t* parsed, const char* func_name);
 
+/*
+ * Analyze the complexity of every function in one pass over their bodies
+ *
+ * `parsed` - Parsed file structure
+ * `results` - Caller-provided array of parsed->function_count entries
+ *
+ * `bool` - true on success, false if parsed or results is NULL
+ *
+ * -- results[i] describes parsed->functions[i], with the same metrics as
+ *    c_parser_analyze_function_complexity()
+ * -- Walks each body's recorded token range once, so the cost is linear in
+ *    the file rather than in functions x tokens
+ * -- Declarations have no body and report only a one-line length
+ */
+bool c_parser_analyze_all_function_complexity(ParsedFile_t* parsed, ComplexityAnalysis_t* results);
+
 // =============================================================================
 // DIVINE DOCUMENTATION ANALYSIS - METIS'S DOMAIN
 // =============================================================================
@@ -439,6 +1229,19 @@ bool c_parser_has_proper_file_headers(ParsedFile_t* parsed);
  */
 bool c_parser_has_proper_header_doc_format(ParsedFile_t* parsed, const char* func_name);
 
+/*
+ * Check the documentation format of an already resolved function
+ *
+ * `parsed` - Parsed file structure the function belongs to
+ * `func` - Function record from parsed->functions
+ *
+ * `bool` - true if documentation follows one-line format or there is none
+ *
+ * -- Same rules as c_parser_has_proper_header_doc_format() without the name lookup
+ * -- Validates the comment linked in func->doc_comment, so no tokens are searched
+ */
+bool c_parser_function_has_proper_doc_format(const ParsedFile_t* parsed, const FunctionInfo_t* func);
+
 /*
  * Extract the one-line description from a function's documentation
  *
@@ -449,6 +1252,7 @@ bool c_parser_has_proper_header_doc_format(ParsedFile_t* parsed, const char* fun
  *
  * -- Returns NULL if function not found or has no documentation
  * -- Extracts only the first line of documentation before blank line
+ * -- Reads the comment linked in func->doc_comment, so no tokens are searched
  * -- Caller must free returned string to prevent memory leaks
  * -- Used for comparing header and implementation documentation consistency
  */
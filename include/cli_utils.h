@@ -29,6 +29,10 @@ typedef struct {
     char* output_format;       // Output format (text, json, divine)
     char* fragment_filter;     // Filter specific fragment types
     int wisdom_level_filter;   // Minimum wisdom level to display
+    int jobs;                  // Worker threads for directory analysis (0 = one per core)
+    char* cache_dir;           // Result cache directory (NULL = --no-cache)
+    int max_depth;             // Directory levels to descend below the target (-1 = unlimited)
+    char* socket_path;         // Lint server socket (serve: listen on it, lint: try it first)
 } MetisArgs_t;
 
 // CLI utility functions
@@ -17,6 +17,9 @@ int metis_cmd_wisdom(const MetisArgs_t* args);
 int metis_cmd_story(const MetisArgs_t* args);
 int metis_cmd_help(const MetisArgs_t* args);
 int metis_cmd_version(const MetisArgs_t* args);
+int metis_cmd_serve(const MetisArgs_t* args);
+int metis_cmd_lsp(const MetisArgs_t* args);
+int metis_cmd_lint_via_server(const MetisArgs_t* args);
 
 // Command dispatcher
 int metis_cmd_execute(const MetisArgs_t* args);
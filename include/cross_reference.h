@@ -6,6 +6,7 @@
 #define CROSS_REFERENCE_H
 
 #include "c_parser.h"
+#include <stdio.h>
 
 // Forward declaration to avoid circular includes
 // ViolationList_t is defined in metis_linter.c
@@ -107,6 +108,33 @@ bool cross_reference_compare_documentation(const FunctionInfo_t* header_func, co
  */
 int cross_reference_analyze_file(const char* c_file_path, ViolationList_t* violations);
 
+/*
+ * Perform full cross-reference analysis, printing findings to a given stream
+ *
+ * `c_file_path` - Path to the .c implementation file
+ * `violations` - Violation list to append results to
+ * `out` - Stream the findings are printed to
+ *
+ * `int` - Number of cross-reference violations found
+ *
+ * -- cross_reference_analyze_file() is this with `out` = stdout
+ * -- Lets parallel linting capture each file's findings and print them in order
+ */
+int cross_reference_analyze_file_to(const char* c_file_path, ViolationList_t* violations, FILE* out);
+
+/*
+ * Cross-reference an already parsed .c file against its header, collecting the findings
+ *
+ * `c_file_path` - Path of the .c file, used to find its header
+ * `impl_parsed` - Parse of the .c file (may come from an unsaved buffer)
+ *
+ * `XRefViolationList_t*` - Findings, or NULL if there is no header to compare against
+ *
+ * -- Prints nothing; free the list with cross_reference_free_violations()
+ * -- `impl_parsed` stays owned by the caller; the header is read from disk
+ */
+XRefViolationList_t* cross_reference_check_parsed(const char* c_file_path, ParsedFile_t* impl_parsed);
+
 /*
  * Check if a function should be cross-referenced
  *
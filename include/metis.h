@@ -30,12 +30,40 @@ MetisResult metis_init(const MetisConfig* config);
 /**
  * @brief Analyze source files for linting issues
  *
+ * Nothing is printed and no wisdom fragments are delivered. Calls may run
+ * concurrently on different threads; headers shared by the files of one call
+ * are parsed once.
+ *
  * @param files Array of file paths to analyze
  * @param file_count Number of files in the array
- * @param options Linting options
+ * @param options Linting options (may be NULL); `fix` and `ruleset` are not used yet
+ * @param report Receives the diagnostics; free it with metis_lint_report_free()
+ * @return MetisResult METIS_ERROR_FILE_NOT_FOUND if any file could not be read
+ *         (the others are still reported), or another code on failure
+ */
+MetisResult metis_lint(const char** files, size_t file_count, const MetisLintOptions* options,
+                       MetisLintReport* report);
+
+/**
+ * @brief Analyze in-memory buffers (or files, where `content` is NULL)
+ *
+ * Same as metis_lint() for editors and build tools holding unsaved sources.
+ *
+ * @param sources Array of sources to analyze
+ * @param source_count Number of sources in the array
+ * @param options Linting options (may be NULL)
+ * @param report Receives the diagnostics; free it with metis_lint_report_free()
  * @return MetisResult Status code indicating success or failure
  */
-MetisResult metis_lint(const char** files, size_t file_count, const MetisLintOptions* options);
+MetisResult metis_lint_sources(const MetisSource* sources, size_t source_count,
+                               const MetisLintOptions* options, MetisLintReport* report);
+
+/**
+ * @brief Free the diagnostics of a metis_lint() call
+ *
+ * @param report Report to free; left empty and safe to free again
+ */
+void metis_lint_report_free(MetisLintReport* report);
 
 /**
  * @brief Format source files according to style rules
@@ -67,6 +95,8 @@ MetisResult metis_get_achievements(MetisAchievement** achievements, size_t* coun
 /**
  * @brief Get the last error message
  *
+ * Errors are kept per thread, so concurrent callers only see their own.
+ *
  * @return const char* Error message string or NULL if no error
  */
 const char* metis_get_last_error(void);
@@ -0,0 +1,92 @@
+/* metis_ignore.h - .metisignore pattern lists for pruning directory lints */
+// INSERT WISDOM HERE
+
+#ifndef METIS_IGNORE_H
+#define METIS_IGNORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define METIS_IGNORE_FILE ".metisignore"
+
+/*
+ * Verdict of one pattern list on a path
+ */
+typedef enum {
+    METIS_IGNORE_NO_MATCH,      // No pattern matched; an outer list may still decide
+    METIS_IGNORE_EXCLUDED,      // Last matching pattern excludes the path
+    METIS_IGNORE_INCLUDED       // Last matching pattern is a `!` re-include
+} MetisIgnoreMatch_t;
+
+typedef enum {
+    METIS_IGNORE_RULE_EXACT,    // No wildcards: compared with memcmp
+    METIS_IGNORE_RULE_SUFFIX,   // `*` then literal text, e.g. `*.o`
+    METIS_IGNORE_RULE_GLOB      // Anything else: wildcard matcher
+} MetisIgnoreRuleKind_t;
+
+/*
+ * One compiled pattern line
+ */
+typedef struct {
+    const char* pattern;        // Pattern text without `!`, leading `/` or trailing `/`
+    size_t length;
+    MetisIgnoreRuleKind_t kind;
+    bool negated;               // `!pattern` re-includes what earlier patterns excluded
+    bool directory_only;        // `pattern/` only matches directories
+    bool anchored;              // Contains a `/`: matched against the whole relative path
+} MetisIgnoreRule_t;
+
+/*
+ * Patterns from one .metisignore, in file order
+ */
+typedef struct {
+    MetisIgnoreRule_t* rules;
+    int count;
+    char* text;                 // Owns every pattern's bytes
+} MetisIgnore_t;
+
+/*
+ * Compile .metisignore text into a pattern list
+ *
+ * `text` - File contents (need not be null-terminated)
+ * `length` - Number of bytes
+ *
+ * `MetisIgnore_t*` - Compiled list, or NULL if it has no patterns or memory ran out
+ *
+ * -- Follows .gitignore syntax: `#` comments, `!` negation, `\` escapes,
+ *    trailing `/` for directories only, `*`, `?`, `[...]` and `**`
+ * -- A pattern with a `/` before its end is relative to the file's directory;
+ *    one without matches an entry's name at any depth below it
+ */
+MetisIgnore_t* metis_ignore_compile(const char* text, size_t length);
+
+/*
+ * Read and compile the .metisignore in an open directory
+ *
+ * `dir_fd` - Descriptor of the directory holding the file
+ *
+ * `MetisIgnore_t*` - Compiled list, or NULL if there is no readable file or it has no patterns
+ */
+MetisIgnore_t* metis_ignore_load_at(int dir_fd);
+
+/*
+ * Match a path against a pattern list
+ *
+ * `ignore` - Compiled list (NULL never matches)
+ * `relative_path` - Path below the list's directory, `/`-separated, no leading `/`
+ * `is_directory` - Whether the path names a directory
+ *
+ * `MetisIgnoreMatch_t` - Verdict of the last matching pattern
+ *
+ * -- Nested lists are checked innermost first; the first list with a match decides
+ */
+MetisIgnoreMatch_t metis_ignore_match(const MetisIgnore_t* ignore, const char* relative_path, bool is_directory);
+
+/*
+ * Free a pattern list
+ *
+ * -- Safe to call with NULL pointer (does nothing)
+ */
+void metis_ignore_free(MetisIgnore_t* ignore);
+
+#endif // METIS_IGNORE_H
@@ -0,0 +1,91 @@
+/* metis_json.h - Minimal JSON reader and writer for the server and editor protocols */
+// INSERT WISDOM HERE
+
+#ifndef METIS_JSON_H
+#define METIS_JSON_H
+
+#include "c_parser.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+typedef enum {
+    METIS_JSON_NULL,
+    METIS_JSON_BOOL,
+    METIS_JSON_NUMBER,
+    METIS_JSON_STRING,
+    METIS_JSON_ARRAY,
+    METIS_JSON_OBJECT
+} MetisJsonType_t;
+
+/*
+ * One parsed JSON value
+ */
+typedef struct MetisJson {
+    MetisJsonType_t type;
+    bool boolean;               // METIS_JSON_BOOL
+    double number;              // METIS_JSON_NUMBER
+    const char* string;         // METIS_JSON_STRING: unescaped and null-terminated
+    size_t length;              // METIS_JSON_STRING: bytes, which may include '\0'
+    struct MetisJson* items;    // METIS_JSON_ARRAY and METIS_JSON_OBJECT members, in order
+    const char** keys;          // METIS_JSON_OBJECT: key of each member
+    int count;
+} MetisJson_t;
+
+/*
+ * A parsed document; every value and string lives in its arena
+ */
+typedef struct {
+    MetisJson_t* root;
+    Arena_t arena;
+} MetisJsonDocument_t;
+
+/*
+ * Parse one JSON text
+ *
+ * `text` - JSON text (need not be null-terminated)
+ * `length` - Number of bytes
+ * `document` - Output document; free with metis_json_free() whatever the result
+ *
+ * `bool` - true if the whole text is one valid JSON value
+ *
+ * -- Nesting deeper than 64 levels is rejected rather than recursed into
+ */
+bool metis_json_parse(const char* text, size_t length, MetisJsonDocument_t* document);
+
+/*
+ * Free a parsed document
+ *
+ * -- Safe to call with NULL pointer or an empty document (does nothing)
+ */
+void metis_json_free(MetisJsonDocument_t* document);
+
+/*
+ * Look up an object member by key
+ *
+ * `object` - Object to search (anything else never matches)
+ * `key` - Member name
+ *
+ * `const MetisJson_t*` - Last member named `key`, or NULL if there is none
+ */
+const MetisJson_t* metis_json_get(const MetisJson_t* object, const char* key);
+
+/*
+ * Read a member as a string, number or boolean
+ *
+ * -- Return `fallback` (or NULL) when the member is missing or of another type
+ */
+const char* metis_json_get_string(const MetisJson_t* object, const char* key);
+double metis_json_get_number(const MetisJson_t* object, const char* key, double fallback);
+bool metis_json_get_bool(const MetisJson_t* object, const char* key, bool fallback);
+
+/*
+ * Write `length` bytes of text as a quoted, escaped JSON string
+ *
+ * `out` - Stream to write to
+ * `text` - Text to write (NULL writes `null`)
+ * `length` - Number of bytes
+ */
+void metis_json_write_string(FILE* out, const char* text, size_t length);
+
+#endif // METIS_JSON_H
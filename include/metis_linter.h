@@ -9,10 +9,54 @@
 #define METIS_LINTER_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 // Core linting functions
 int metis_lint_file(const char* file_path);
 int metis_lint_directory(const char* dir_path);
+// Same as metis_lint_directory() with `jobs` worker threads (0 = one per core);
+// reports still print in path order and fragments are delivered on the calling thread
+int metis_lint_directory_jobs(const char* dir_path, int jobs);
+// Replay files whose content, headers, version and config are unchanged from
+// entries in `cache_dir` (created on first store); NULL disables it (the default)
+void metis_linter_set_cache_dir(const char* cache_dir);
+// Enter at most `max_depth` directory levels below a linted directory's root
+// (0 = the root only); negative removes the limit (the default)
+void metis_linter_set_max_depth(int max_depth);
+
+// Severity of a finding from metis_linter_analyze()
+typedef enum {
+    METIS_FINDING_INFO,
+    METIS_FINDING_WARNING,
+    METIS_FINDING_ERROR
+} MetisFindingSeverity_t;
+
+// One violation from metis_linter_analyze(), as plain data
+typedef struct {
+    const char* file_path;
+    int line;
+    int column;
+    const char* message;
+    const char* suggestion;             // NULL if there is none
+    const char* category;               // "docs", "daedalus", "philosophy" or "header"
+    MetisFindingSeverity_t severity;
+} MetisFinding_t;
+
+// Everything metis_linter_analyze() found in one file
+typedef struct {
+    MetisFinding_t* findings;           // In detection order
+    int count;
+    bool readable;                      // false if the file could not be read
+    void* storage;                      // Owns the findings' strings
+} MetisFindings_t;
+
+// Analyze `file_path`, or `length` bytes of `content` standing in for it when
+// non-NULL, without printing or touching the fragment engine. Safe to call from
+// several threads at once; headers are read from disk and shared between calls
+// inside one c_parser_cache_begin()/c_parser_cache_end() run. Returns false if
+// memory ran out; free the result with metis_linter_free_findings()
+bool metis_linter_analyze(const char* file_path, const char* content, size_t length, MetisFindings_t* findings);
+void metis_linter_free_findings(MetisFindings_t* findings);
 
 // Initialization and cleanup
 bool metis_linter_init(void);
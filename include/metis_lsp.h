@@ -0,0 +1,30 @@
+/* metis_lsp.h - Language Server Protocol front end for editors */
+// INSERT WISDOM HERE
+
+#ifndef METIS_LSP_H
+#define METIS_LSP_H
+
+#include <stdio.h>
+
+/*
+ * Speak the Language Server Protocol until the client says exit
+ *
+ * `input_fd` - Descriptor carrying client messages (stdin for `metis lsp`)
+ * `output` - Stream for server messages (stdout for `metis lsp`)
+ *
+ * `int` - 0 after shutdown then exit, 1 if the client exited or hung up without shutdown
+ *
+ * -- Handles initialize, shutdown, exit and textDocument/didOpen, didChange
+ *    (full or incremental), didSave and didClose; diagnostics are pushed with
+ *    textDocument/publishDiagnostics, tagged with the version they describe
+ * -- Linting runs on a worker thread, so reading the client never waits on it.
+ *    Keystrokes arriving during an analysis are coalesced: only the latest text
+ *    of a buffer is analyzed next, and unchanged buffers are never re-analyzed
+ * -- Header parses are shared by every buffer for the whole session; saving a
+ *    header re-lints the open buffers, since they read headers from disk
+ * -- Positions are UTF-16 unless the client offers "utf-8" encoding
+ * -- Nothing but protocol messages is written to `output`
+ */
+int metis_lsp_run(int input_fd, FILE* output);
+
+#endif // METIS_LSP_H
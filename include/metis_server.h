@@ -0,0 +1,63 @@
+/* metis_server.h - Long-running lint server on a Unix socket, and its client */
+// INSERT WISDOM HERE
+
+#ifndef METIS_SERVER_H
+#define METIS_SERVER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Serve lint requests on a Unix socket until stopped
+ *
+ * `socket_path` - Filesystem path to listen on
+ *
+ * `int` - 0 after a clean stop, 1 if the socket could not be set up
+ *
+ * -- Each connection carries newline-delimited JSON requests and gets one
+ *    JSON response line per request, in order:
+ *      {"paths": ["a.c", ...]}
+ *      {"sources": [{"path": "a.c", "content": "..."}, ...]}
+ *    with optional "ignore_warnings" (bool) and "ignore_rules" (array of rule ids)
+ * -- Responses: {"ok": true, "files_analyzed": N, "files_unreadable": N,
+ *    "diagnostics": [{"file", "line", "column", "severity", "rule", "message", "suggestion"}]}
+ *    or {"ok": false, "error": "..."}
+ * -- Relative paths resolve against the server's working directory
+ * -- Parsed files stay cached between requests until they change on disk
+ * -- Connections are served concurrently, one thread each
+ * -- One server per process: metis_server_stop() stops whichever is running
+ * -- Refuses to replace a socket another server is still listening on
+ * -- SIGINT and SIGTERM stop the server and remove the socket
+ */
+int metis_server_run(const char* socket_path);
+
+/*
+ * Ask a running metis_server_run() to stop
+ *
+ * -- Safe to call from any thread; returns without waiting
+ */
+void metis_server_stop(void);
+
+/*
+ * Answer one request line, as the server does for each line it reads
+ *
+ * `request` - JSON request text
+ * `length` - Number of bytes
+ *
+ * `char*` - Newline-terminated JSON response (caller frees), or NULL if memory ran out
+ */
+char* metis_server_handle_request(const char* request, size_t length);
+
+/*
+ * Send one request to a server and wait for its response
+ *
+ * `socket_path` - Socket the server listens on
+ * `request` - JSON request text, without a trailing newline
+ * `length` - Number of bytes
+ *
+ * `char*` - Response line without its newline (caller frees), or NULL if no
+ *           server answered
+ */
+char* metis_server_call(const char* socket_path, const char* request, size_t length);
+
+#endif // METIS_SERVER_H
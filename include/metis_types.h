@@ -12,6 +12,7 @@
 #ifndef METIS_TYPES_H
 #define METIS_TYPES_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -96,6 +97,26 @@ typedef struct {
     size_t ignore_count;       /**< Number of ignored rules */
 } MetisLintOptions;
 
+/**
+ * @brief Source buffer to lint in place of a file on disk
+ */
+typedef struct {
+    const char* path;          /**< Path reported in diagnostics; its header is looked up from here */
+    const char* content;       /**< Source text, or NULL to read `path` from disk */
+    size_t length;             /**< Number of bytes in `content` */
+} MetisSource;
+
+/**
+ * @brief Diagnostics produced by one metis_lint() call
+ */
+typedef struct {
+    MetisDiagnostic* diagnostics; /**< Grouped by file in input order, then in detection order */
+    size_t count;              /**< Number of diagnostics */
+    size_t files_analyzed;     /**< Files or buffers that were analyzed */
+    size_t files_unreadable;   /**< Files that could not be read */
+    void* storage;             /**< Owns the diagnostics' strings (internal) */
+} MetisLintReport;
+
 /**
  * @brief Formatting options
  */
@@ -80,6 +80,12 @@ map_target_to_file_path() {
         "run-test-c-parser-basic")
             echo "tests/linter/test_c_parser_basic.c"
             ;;
+        "run-test-metis-server-basic")
+            echo "tests/server/test_metis_server_basic.c"
+            ;;
+        "run-test-metis-lsp-basic")
+            echo "tests/server/test_metis_lsp_basic.c"
+            ;;
         *)
             # Fallback for unknown targets
             echo "true_tests/${target#*test-}.c"
@@ -1512,6 +1518,8 @@ run_test "Test Fragment Engine Basic" "run-test-fragment-engine-basic"
 run_test "Test Fragment Engine Integration" "run-test-fragment-engine-integration"
 run_test "Test Advanced C Parser" "run-test-c-parser-advanced"
 run_test "Test Advanced Metis Linter" "run-test-metis-linter-advanced"
+run_test "Test Metis Server Basic" "run-test-metis-server-basic"
+run_test "Test Metis LSP Basic" "run-test-metis-lsp-basic"
 
 
 # Calculate overall execution time
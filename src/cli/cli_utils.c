@@ -33,6 +33,10 @@ MetisArgs_t* metis_cli_create_default_args(void) {
     args->output_format = strdup("text");
     args->fragment_filter = NULL;
     args->wisdom_level_filter = 0;
+    args->jobs = 0;
+    args->cache_dir = strdup(".metis-cache");
+    args->max_depth = -1;
+    args->socket_path = NULL;
 
     return args;
 }
@@ -74,6 +78,12 @@ MetisArgs_t* metis_cli_parse_arguments(int argc, char* argv[]) {
         {"min-level", required_argument, 0, 1004},
         {"story", no_argument, 0, 1005},
         {"fragments", no_argument, 0, 1006},
+        {"jobs", required_argument, 0, 'j'},
+        {"no-cache", no_argument, 0, 1007},
+        {"cache-dir", required_argument, 0, 1008},
+        {"max-depth", required_argument, 0, 1009},
+        {"socket", required_argument, 0, 1010},
+        {"server", required_argument, 0, 1011},
         {0, 0, 0, 0}
     };
 
@@ -83,7 +93,7 @@ MetisArgs_t* metis_cli_parse_arguments(int argc, char* argv[]) {
     // Start parsing from argv[2] since argv[1] is the command
     optind = 2;
 
-    while ((opt = getopt_long(argc, argv, "rqvsc:f:hV", long_options, &option_index)) != -1) {
+    while ((opt = getopt_long(argc, argv, "rqvsc:f:j:hV", long_options, &option_index)) != -1) {
         switch (opt) {
             case 'r':
                 args->recursive = true;
@@ -104,6 +114,10 @@ MetisArgs_t* metis_cli_parse_arguments(int argc, char* argv[]) {
                 free(args->output_format);
                 args->output_format = strdup(optarg);
                 break;
+            case 'j':
+                args->jobs = atoi(optarg);
+                if (args->jobs < 0) args->jobs = 0;
+                break;
             case 'h':
                 free(args->command);
                 args->command = strdup("help");
@@ -130,6 +144,23 @@ MetisArgs_t* metis_cli_parse_arguments(int argc, char* argv[]) {
             case 1006: // --fragments
                 args->show_fragments = true;
                 break;
+            case 1007: // --no-cache
+                free(args->cache_dir);
+                args->cache_dir = NULL;
+                break;
+            case 1008: // --cache-dir
+                free(args->cache_dir);
+                args->cache_dir = strdup(optarg);
+                break;
+            case 1009: // --max-depth
+                args->max_depth = atoi(optarg);
+                if (args->max_depth < 0) args->max_depth = -1;
+                break;
+            case 1010: // --socket
+            case 1011: // --server
+                free(args->socket_path);
+                args->socket_path = strdup(optarg);
+                break;
             case '?':
                 // getopt_long already printed an error message
                 break;
@@ -159,6 +190,8 @@ void metis_cli_free_arguments(MetisArgs_t* args) {
     free(args->config_file);
     free(args->output_format);
     free(args->fragment_filter);
+    free(args->cache_dir);
+    free(args->socket_path);
     free(args);
 }
 
@@ -208,6 +241,10 @@ void metis_cli_display_help(void) {
            METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
     printf("  %sstory%s           %sView unlocked story fragments%s\n",
            METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
+    printf("  %sserve%s           %sKeep a lint server running on --socket PATH%s\n",
+           METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
+    printf("  %slsp%s             %sServe editors over the Language Server Protocol on stdio%s\n",
+           METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
     printf("  %shelp%s           %sShow this divine guidance%s\n",
            METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
     printf("  %sversion%s        %sDisplay version information%s\n\n",
@@ -226,6 +263,18 @@ void metis_cli_display_help(void) {
            METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
     printf("  %s-f, --format%s FORMAT  %sOutput format (text, json, divine)%s\n",
            METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
+    printf("  %s-j, --jobs%s N         %sAnalyze N files in parallel (default: one per core)%s\n",
+           METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
+    printf("  %s    --no-cache%s       %sRe-analyze every file instead of replaying .metis-cache%s\n",
+           METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
+    printf("  %s    --cache-dir%s DIR  %sKeep cached results in DIR (default: .metis-cache)%s\n",
+           METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
+    printf("  %s    --max-depth%s N    %sDescend at most N directory levels (default: unlimited)%s\n",
+           METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
+    printf("  %s    --socket%s PATH    %sSocket for 'metis serve' to listen on%s\n",
+           METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
+    printf("  %s    --server%s PATH    %sLint a file through 'metis serve'; prints file:line:col lines%s\n",
+           METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
     printf("  %s    --compassion%s     %sEnable extra compassionate error messages%s\n",
            METIS_BOLD, METIS_RESET, METIS_TEXT_SECONDARY, METIS_RESET);
     printf("  %s    --no-colors%s      %sDisable divine color output%s\n",
@@ -246,6 +295,8 @@ void metis_cli_display_help(void) {
            METIS_ACCENT, METIS_RESET, METIS_TEXT_MUTED, METIS_RESET);
     printf("  %smetis lint -r --stats .%s     %s# Recursive analysis with stats%s\n",
            METIS_ACCENT, METIS_RESET, METIS_TEXT_MUTED, METIS_RESET);
+    printf("  %smetis lint -j 8 src/%s        %s# Analyze with eight worker threads%s\n",
+           METIS_ACCENT, METIS_RESET, METIS_TEXT_MUTED, METIS_RESET);
     printf("  %smetis config show%s           %s# Show current configuration%s\n",
            METIS_ACCENT, METIS_RESET, METIS_TEXT_MUTED, METIS_RESET);
     printf("  %smetis wisdom%s                %s# Show consciousness status%s\n",
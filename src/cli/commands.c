@@ -1,16 +1,21 @@
-#define _POSIX_C_SOURCE 200809L
+#define _XOPEN_SOURCE 700  // For realpath in the lint server client
 
 #include "commands.h"
 #include "cli_utils.h"
 #include "metis_config.h"
 #include "metis_colors.h"
 #include "metis_linter.h"
+#include "metis_json.h"
+#include "metis_server.h"
+#include "metis_lsp.h"
 #include "fragment_engine.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <time.h>
+#include <unistd.h>
 // List of commands that require full system initialization (config, fragments)
 static const char* COMMANDS_REQUIRING_INIT[] = {
     "lint", "config", "wisdom", "story", NULL
@@ -57,6 +62,19 @@ int metis_cmd_lint(const MetisArgs_t* args) {
                args->compassion_mode ? "✅ Enabled" : "❌ Disabled");
         printf("  %sOutput format:%s %s%s%s\n", METIS_TEXT_SECONDARY, METIS_RESET,
                METIS_ACCENT, args->output_format, METIS_RESET);
+        if (args->jobs > 0) {
+            printf("  %sJobs:%s %s%d%s\n", METIS_TEXT_SECONDARY, METIS_RESET,
+                   METIS_ACCENT, args->jobs, METIS_RESET);
+        } else {
+            printf("  %sJobs:%s %sone per core%s\n", METIS_TEXT_SECONDARY, METIS_RESET,
+                   METIS_ACCENT, METIS_RESET);
+        }
+        printf("  %sResult cache:%s %s%s%s\n", METIS_TEXT_SECONDARY, METIS_RESET,
+               METIS_ACCENT, args->cache_dir ? args->cache_dir : "disabled", METIS_RESET);
+        if (args->max_depth >= 0) {
+            printf("  %sMax depth:%s %s%d%s\n", METIS_TEXT_SECONDARY, METIS_RESET,
+                   METIS_ACCENT, args->max_depth, METIS_RESET);
+        }
         printf("  %sColors:%s %s\n", METIS_TEXT_SECONDARY, METIS_RESET,
                args->enable_colors ? "✅ Divine" : "❌ Monochrome");
 
@@ -82,6 +100,9 @@ int metis_cmd_lint(const MetisArgs_t* args) {
         return 3;
     }
 
+    metis_linter_set_cache_dir(args->cache_dir);
+    metis_linter_set_max_depth(args->max_depth);
+
     // Determine if target is file or directory and analyze accordingly
     if (metis_cli_is_directory(args->target_path)) {
         printf("%s📁 Directory Analysis:%s Scanning divine directory structure...\n",
@@ -92,7 +113,7 @@ int metis_cmd_lint(const MetisArgs_t* args) {
                    METIS_INFO, METIS_RESET);
         }
 
-        result = metis_lint_directory(args->target_path);
+        result = metis_lint_directory_jobs(args->target_path, args->jobs);
 
     } else if (metis_cli_is_file(args->target_path)) {
         printf("%s📄 File Analysis:%s Examining sacred source file...\n",
@@ -125,6 +146,120 @@ int metis_cmd_lint(const MetisArgs_t* args) {
     return result;
 }
 
+/**
+ * Lint a single file through a running `metis serve`
+ * @param args Parsed command arguments (socket_path names the server)
+ * @return Exit code as metis_cmd_lint would give, or -1 to lint locally instead
+ *
+ * Output is machine-readable rather than the local report: one compiler-style
+ * `file:line:col: severity: message [rule]` line per finding, then a count, or
+ * the server's JSON response with --format json. Findings in the file itself
+ * show the path as typed; findings elsewhere (its header) show that file's path.
+ */
+int metis_cmd_lint_via_server(const MetisArgs_t* args) {
+    if (!args || !args->socket_path || !args->target_path) return -1;
+
+    // Directories are walked locally, with their ignore files and result cache
+    char absolute_path[PATH_MAX];
+    if (!metis_cli_is_file(args->target_path) || !realpath(args->target_path, absolute_path)) {
+        return -1;
+    }
+
+    char* request = NULL;
+    size_t request_length = 0;
+    FILE* out = open_memstream(&request, &request_length);
+    if (!out) return -1;
+    fputs("{\"paths\":[", out);
+    metis_json_write_string(out, absolute_path, strlen(absolute_path));
+    fputs("]}", out);
+    fclose(out);
+
+    char* response = metis_server_call(args->socket_path, request, request_length);
+    free(request);
+    if (!response) return -1;
+
+    MetisJsonDocument_t document;
+    if (!metis_json_parse(response, strlen(response), &document) ||
+        !metis_json_get_bool(document.root, "ok", false)) {
+        const char* error = metis_json_get_string(document.root, "error");
+        printf("%s💀 Divine Error:%s Lint server failed: %s\n",
+               METIS_ERROR, METIS_RESET, error ? error : "malformed response");
+        metis_json_free(&document);
+        free(response);
+        return 1;
+    }
+
+    const MetisJson_t* diagnostics = metis_json_get(document.root, "diagnostics");
+    int count = diagnostics && diagnostics->type == METIS_JSON_ARRAY ? diagnostics->count : 0;
+    int result = count;
+    if (metis_json_get_number(document.root, "files_unreadable", 0) > 0) {
+        printf("%s💀 Divine Error:%s Cannot access path: %s%s%s\n",
+               METIS_ERROR, METIS_RESET,
+               METIS_CLICKABLE_LINK, args->target_path, METIS_RESET);
+        result = 3;
+    } else if (strcmp(args->output_format, "json") == 0) {
+        printf("%s\n", response);
+    } else {
+        for (int i = 0; i < count; i++) {
+            const MetisJson_t* diagnostic = &diagnostics->items[i];
+            const char* suggestion = metis_json_get_string(diagnostic, "suggestion");
+
+            // The server reports absolute paths; the linted file itself shows as the user typed it
+            const char* file = metis_json_get_string(diagnostic, "file");
+            const char* shown_file = !file || strcmp(file, absolute_path) == 0 ? args->target_path : file;
+            printf("%s%s%s:%d:%d: %s: %s [%s]\n",
+                   METIS_CLICKABLE_LINK, shown_file, METIS_RESET,
+                   (int)metis_json_get_number(diagnostic, "line", 1),
+                   (int)metis_json_get_number(diagnostic, "column", 1),
+                   metis_json_get_string(diagnostic, "severity"),
+                   metis_json_get_string(diagnostic, "message"),
+                   metis_json_get_string(diagnostic, "rule"));
+            if (suggestion && *suggestion && args->verbose) {
+                printf("    %s%s%s\n", METIS_TEXT_SECONDARY, suggestion, METIS_RESET);
+            }
+        }
+        if (!args->quiet_mode) {
+            printf("%s%d issue%s found%s\n", METIS_TEXT_MUTED, count, count == 1 ? "" : "s", METIS_RESET);
+        }
+    }
+
+    metis_json_free(&document);
+    free(response);
+    return result;
+}
+
+/**
+ * Execute serve command: keep a lint server running until interrupted
+ * @param args Parsed command arguments (socket_path is required)
+ * @return Exit code (0 = clean stop)
+ */
+int metis_cmd_serve(const MetisArgs_t* args) {
+    if (!args || !args->socket_path) {
+        printf("%s💀 Divine Error:%s serve needs a socket: metis serve --socket PATH\n",
+               METIS_ERROR, METIS_RESET);
+        return 2;
+    }
+
+    if (!args->quiet_mode) {
+        printf("%s🛰️  Lint Server:%s Listening on %s%s%s (Ctrl-C to stop)\n",
+               METIS_PRIMARY, METIS_RESET, METIS_CLICKABLE_LINK, args->socket_path, METIS_RESET);
+        fflush(stdout);
+    }
+    return metis_server_run(args->socket_path);
+}
+
+/**
+ * Execute lsp command: serve an editor over stdin/stdout until it exits
+ * @param args Parsed command arguments
+ * @return Exit code (0 = orderly shutdown)
+ */
+int metis_cmd_lsp(const MetisArgs_t* args) {
+    (void)args; // Suppress unused parameter warning
+
+    // stdout now belongs to the protocol; nothing else may print there
+    return metis_lsp_run(STDIN_FILENO, stdout);
+}
+
 /**
  * Execute config command with divine configuration management
  * @param args Parsed command arguments
@@ -389,6 +524,10 @@ int metis_cmd_execute(const MetisArgs_t* args) {
         return metis_cmd_wisdom(args);
     } else if (strcmp(args->command, "story") == 0) {
         return metis_cmd_story(args);
+    } else if (strcmp(args->command, "serve") == 0) {
+        return metis_cmd_serve(args);
+    } else if (strcmp(args->command, "lsp") == 0) {
+        return metis_cmd_lsp(args);
     } else if (strcmp(args->command, "help") == 0) {
         return metis_cmd_help(args);
     } else if (strcmp(args->command, "version") == 0) {
@@ -411,7 +550,7 @@ bool metis_cmd_is_valid(const char* command) {
     if (!command) return false;
 
     const char* valid_commands[] = {
-        "lint", "config", "wisdom", "story", "help", "version", NULL
+        "lint", "config", "wisdom", "story", "serve", "lsp", "help", "version", NULL
     };
 
     for (int i = 0; valid_commands[i] != NULL; i++) {
@@ -439,6 +578,10 @@ const char* metis_cmd_get_description(const char* command) {
         return "Show consciousness statistics and progress";
     } else if (strcmp(command, "story") == 0) {
         return "View unlocked story fragments";
+    } else if (strcmp(command, "serve") == 0) {
+        return "Keep a lint server running on a Unix socket";
+    } else if (strcmp(command, "lsp") == 0) {
+        return "Serve editors over the Language Server Protocol on stdio";
     } else if (strcmp(command, "help") == 0) {
         return "Show divine guidance";
     } else if (strcmp(command, "version") == 0) {
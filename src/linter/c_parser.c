@@ -2,76 +2,515 @@
 // INSERT WISDOM HERE
 
 #define _POSIX_C_SOURCE 200809L
+#define _XOPEN_SOURCE 700
 
 #include "c_parser.h"
+#include "c_parser_hash_tables.h"
 #include "metis_colors.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <limits.h>
-
-static bool _is_valid_number_char(char c, bool* has_dot, bool* has_e, char next_c);
-static int _read_hex_number(ParserContext_t* ctx, char* buffer, size_t buffer_size, int current_length);
-static int _read_float_exponent(ParserContext_t* ctx, char* buffer, size_t buffer_size, int current_length);
-static int _read_decimal_integer_or_float_part(ParserContext_t* ctx, char* buffer, size_t buffer_size, int current_length, bool* has_dot_out, bool* has_e_out);
-
-static bool _is_two_char_operator(char c1, char c2, char* op_buffer);
-static bool _is_single_char_operator(char c);
-static const char* TWO_CHAR_OPERATORS[] = {
-    "==", "!=", "<=", ">=", "&&", "||", "++", "--", "<<", ">>",
-    "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "->",
-    NULL
-};
-
-static bool _attempt_tokenize_next_token(ParserContext_t* ctx, ParsedFile_t* parsed, char* buffer, size_t buffer_size);
-static bool _tokenize_comment(ParserContext_t* ctx, ParsedFile_t* parsed, char c, char next_c, int start_line, int start_column, char* buffer, size_t buffer_size);
-static bool _tokenize_preprocessor(ParserContext_t* ctx, ParsedFile_t* parsed, int start_line, int start_column, char* buffer, size_t buffer_size);
-static bool _tokenize_string_char_literal(ParserContext_t* ctx, ParsedFile_t* parsed, char c, int start_line, int start_column, char* buffer, size_t buffer_size);
-static bool _tokenize_number(ParserContext_t* ctx, ParsedFile_t* parsed, char c, char next_c, int start_line, int start_column, char* buffer, size_t buffer_size);
-static bool _tokenize_identifier_keyword(ParserContext_t* ctx, ParsedFile_t* parsed, char c, int start_line, int start_column, char* buffer, size_t buffer_size);
-static bool _tokenize_operator(ParserContext_t* ctx, ParsedFile_t* parsed, int start_line, int start_column, char* buffer, size_t buffer_size);
-static bool _tokenize_punctuation(ParserContext_t* ctx, ParsedFile_t* parsed, char c, int start_line, int start_column, char* buffer);
-static bool _tokenize_newline(ParserContext_t* ctx, ParsedFile_t* parsed, int start_line, int start_column);
-static bool _tokenize_unknown(ParserContext_t* ctx, ParsedFile_t* parsed, char c, int start_line, int start_column, char* buffer); // For unknown characters
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // =============================================================================
 // TOKEN RECOGNITION TABLES
 // =============================================================================
 
+// Word texts and lengths indexed by ID (index 0 is the "none" ID); the perfect
+// hash slots in c_parser_hash_tables.h are generated from the same X-macro lists
+#define WORD_TEXT(id, text) text,
+#define WORD_LENGTH(id, text) sizeof(text) - 1,
+
 // C Keywords for divine recognition of language constructs
-static const char* C_KEYWORDS[] = {
-    "auto", "break", "case", "char", "const", "continue", "default", "do",
-    "double", "else", "enum", "extern", "float", "for", "goto", "if",
-    "inline", "int", "long", "register", "restrict", "return", "short",
-    "signed", "sizeof", "static", "struct", "switch", "typedef", "union",
-    "unsigned", "void", "volatile", "while", "_Bool", "_Complex", "_Imaginary",
-    "_Static_assert", "_Thread_local", "_Alignas", "_Alignof", "_Atomic",
-    "_Generic", "_Noreturn",
-    NULL
-};
+static const char* const C_KEYWORD_TEXT[C_KEYWORD_COUNT] = { NULL, C_PARSER_C_KEYWORDS(WORD_TEXT) };
+static const uint8_t C_KEYWORD_LENGTH[C_KEYWORD_COUNT] = { 0, C_PARSER_C_KEYWORDS(WORD_LENGTH) };
 
 // Dangerous functions that should be replaced with Daedalus alternatives
-static const char* DANGEROUS_FUNCTIONS[] = {
-    "gets", "strcpy", "strcat", "sprintf", "vsprintf",
-    "strlen", "strncpy", "strncat", "snprintf", "vsnprintf",
-    "malloc", "calloc", "realloc", "free",
-    "printf", "fprintf",
-    //"scanf", "fscanf", "sscanf", "atoi", "atol", "atof",
-    NULL
-};
+static const char* const C_DANGEROUS_FUNCTION_TEXT[C_DANGEROUS_COUNT] = { NULL, C_PARSER_DANGEROUS_FUNCTIONS(WORD_TEXT) };
+static const uint8_t C_DANGEROUS_FUNCTION_LENGTH[C_DANGEROUS_COUNT] = { 0, C_PARSER_DANGEROUS_FUNCTIONS(WORD_LENGTH) };
 
 // Common type keywords and identifiers
-static const char* TYPE_KEYWORDS[] = {
-    "int", "char", "float", "double", "void", "bool", "size_t",
-    "uint8_t", "uint16_t", "uint32_t", "uint64_t",
-    "int8_t", "int16_t", "int32_t", "int64_t",
-    "FILE", "NULL", "true", "false",
-    NULL
+static const char* const C_TYPE_KEYWORD_TEXT[C_TYPE_COUNT] = { NULL, C_PARSER_TYPE_KEYWORDS(WORD_TEXT) };
+static const uint8_t C_TYPE_KEYWORD_LENGTH[C_TYPE_COUNT] = { 0, C_PARSER_TYPE_KEYWORDS(WORD_LENGTH) };
+
+#undef WORD_TEXT
+#undef WORD_LENGTH
+
+// =============================================================================
+// ARENA ALLOCATION
+// =============================================================================
+
+#define ARENA_CHUNK_BYTES (32 * 1024)   // Standard chunk size; bigger requests get their own chunk
+#define ARENA_SPARE_CHUNKS 32           // Released chunks each thread keeps for reuse
+
+struct ArenaChunk {
+    struct ArenaChunk* next;
+    size_t capacity;                    // Bytes available in `data`
+    max_align_t data[];
 };
 
+#define PARSE_POOL_FILES 2              // Retired parses each thread keeps while its pool is open
+#define PARSE_POOL_MAX_TOKENS (1 << 20) // Token stores beyond this go back to malloc instead
+
+/*
+ * Memory released on one thread, waiting to be reused by the same thread
+ *
+ * Arena chunks are always kept; parse buffers only while the thread's pool is open.
+ */
+typedef struct {
+    struct ArenaChunk* chunks;
+    int count;
+    int pool_depth;                             // Nesting of c_parser_pool_begin() calls
+    ParsedFile_t* files[PARSE_POOL_FILES];      // Emptied parses that kept their arrays
+    int file_count;
+} ThreadSpares_t;
+
+static pthread_key_t thread_spares_key;
+static pthread_once_t thread_spares_once = PTHREAD_ONCE_INIT;
+static bool thread_spares_ready = false;
+
+static void free_pooled_file(ParsedFile_t* parsed);
+
+/*
+ * Free a thread's spare chunks and pooled parses when the thread exits
+ */
+static void free_thread_spares(void* value) {
+    ThreadSpares_t* spares = value;
+    while (spares->chunks) {
+        struct ArenaChunk* next = spares->chunks->next;
+        free(spares->chunks);
+        spares->chunks = next;
+    }
+    for (int i = 0; i < spares->file_count; i++) {
+        free_pooled_file(spares->files[i]);
+    }
+    free(spares);
+}
+
+/*
+ * Create the thread-specific key for spare memory, once per process
+ */
+static void create_thread_spares_key(void) {
+    thread_spares_ready = pthread_key_create(&thread_spares_key, free_thread_spares) == 0;
+}
+
+/*
+ * Get the calling thread's spare memory, or NULL if it cannot be set up
+ */
+static ThreadSpares_t* thread_spares(void) {
+    pthread_once(&thread_spares_once, create_thread_spares_key);
+    if (!thread_spares_ready) return NULL;
+
+    ThreadSpares_t* spares = pthread_getspecific(thread_spares_key);
+    if (!spares) {
+        spares = calloc(1, sizeof(ThreadSpares_t));
+        if (spares && pthread_setspecific(thread_spares_key, spares) != 0) {
+            free(spares);
+            spares = NULL;
+        }
+    }
+    return spares;
+}
+
+/*
+ * Get a chunk of at least `size` bytes, reusing a spare one when it fits
+ */
+static struct ArenaChunk* take_arena_chunk(size_t size) {
+    if (size <= ARENA_CHUNK_BYTES) {
+        ThreadSpares_t* spares = thread_spares();
+        if (spares && spares->chunks) {
+            struct ArenaChunk* chunk = spares->chunks;
+            spares->chunks = chunk->next;
+            spares->count--;
+            chunk->next = NULL;
+            return chunk;
+        }
+        size = ARENA_CHUNK_BYTES;
+    }
+
+    if (size > SIZE_MAX - sizeof(struct ArenaChunk)) return NULL;
+    struct ArenaChunk* chunk = malloc(sizeof(struct ArenaChunk) + size);
+    if (!chunk) return NULL;
+    chunk->next = NULL;
+    chunk->capacity = size;
+    return chunk;
+}
+
+/*
+ * Bump-allocate `size` bytes aligned to `align` (a power of two)
+ */
+static void* arena_bump(Arena_t* arena, size_t size, size_t align) {
+    if (!arena) return NULL;
+
+    if (arena->head) {
+        size_t start = (arena->used + align - 1) & ~(align - 1);
+        if (start <= arena->head->capacity && arena->head->capacity - start >= size) {
+            arena->used = start + size;
+            return (unsigned char*)arena->head->data + start;
+        }
+    }
+
+    struct ArenaChunk* chunk = take_arena_chunk(size);
+    if (!chunk) return NULL;
+
+    // A big request goes behind the head so the head's free space is not abandoned
+    if (arena->head && size > ARENA_CHUNK_BYTES / 4) {
+        chunk->next = arena->head->next;
+        arena->head->next = chunk;
+        return chunk->data;
+    }
+
+    chunk->next = arena->head;
+    arena->head = chunk;
+    arena->used = size;
+    return chunk->data;
+}
+
+/*
+ * Allocate uninitialized memory from an arena
+ */
+void* c_parser_arena_alloc(Arena_t* arena, size_t size) {
+    return arena_bump(arena, size, _Alignof(max_align_t));
+}
+
+/*
+ * Copy `length` bytes into an arena as a null-terminated string
+ */
+char* c_parser_arena_strndup(Arena_t* arena, const char* text, size_t length) {
+    if (!text || length == SIZE_MAX) return NULL;
+
+    char* copy = arena_bump(arena, length + 1, 1);
+    if (!copy) return NULL;
+    memcpy(copy, text, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+/*
+ * Copy a null-terminated string into an arena
+ */
+char* c_parser_arena_strdup(Arena_t* arena, const char* text) {
+    return text ? c_parser_arena_strndup(arena, text, strlen(text)) : NULL;
+}
+
+/*
+ * Move every allocation of `src` into `dst`
+ */
+void c_parser_arena_adopt(Arena_t* dst, Arena_t* src) {
+    if (!dst || !src || !src->head || dst == src) return;
+
+    if (!dst->head) {
+        *dst = *src;
+    } else {
+        // Splice src's chunks in behind dst's head, which keeps filling
+        struct ArenaChunk* tail = src->head;
+        while (tail->next) tail = tail->next;
+        tail->next = dst->head->next;
+        dst->head->next = src->head;
+    }
+    src->head = NULL;
+    src->used = 0;
+}
+
+/*
+ * Release everything allocated from an arena
+ */
+void c_parser_arena_release(Arena_t* arena) {
+    if (!arena || !arena->head) return;
+
+    ThreadSpares_t* spares = thread_spares();
+    struct ArenaChunk* chunk = arena->head;
+    while (chunk) {
+        struct ArenaChunk* next = chunk->next;
+        if (spares && chunk->capacity == ARENA_CHUNK_BYTES && spares->count < ARENA_SPARE_CHUNKS) {
+            chunk->next = spares->chunks;
+            spares->chunks = chunk;
+            spares->count++;
+        } else {
+            free(chunk);
+        }
+        chunk = next;
+    }
+    arena->head = NULL;
+    arena->used = 0;
+}
+
+// =============================================================================
+// ATOM TABLE
+// =============================================================================
+
+#define ATOM_SHARD_BITS 6
+#define ATOM_SHARDS (1u << ATOM_SHARD_BITS)     // Independently locked parts of a table
+#define ATOM_TABLE_BITS 4
+#define ATOM_TABLES (1u << ATOM_TABLE_BITS)     // Tables alive at once: the current one and retired ones still held
+#define ATOM_INDEX_SHIFT (ATOM_SHARD_BITS + ATOM_TABLE_BITS)
+#define ATOM_MIN_SLOTS 64
+
+/*
+ * One lock's worth of an atom table
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t* slots;        // Open-addressed, holding index + 1; 0 if empty
+    uint32_t mask;          // Slot count - 1
+    const char** texts;     // Interned text of each index
+    uint32_t* lengths;      // Length of each text
+    uint32_t* hashes;       // Full hash of each text, for probing and regrowth
+    uint32_t count;
+    uint32_t capacity;
+    Arena_t arena;          // Owns every text until the table is freed
+} AtomShard_t;
+
+/*
+ * The strings interned during one run
+ *
+ * An atom is ((index + 1) << ATOM_INDEX_SHIFT) | (slot << ATOM_SHARD_BITS) | shard,
+ * so it is never ATOM_NONE, names its table, and decodes without a search.
+ * A run's end retires the current table; it is freed once the last parse
+ * holding it is, so a long-lived server keeps only what live parses use.
+ */
+typedef struct AtomTable {
+    AtomShard_t shards[ATOM_SHARDS];
+    uint32_t slot;          // Index in atom_tables, carried by every atom
+    int holders;            // Parses interning into it, plus one while current - under atom_tables_lock
+} AtomTable_t;
+
+static pthread_mutex_t atom_tables_lock = PTHREAD_MUTEX_INITIALIZER;
+static AtomTable_t* atom_tables[ATOM_TABLES];
+static AtomTable_t* current_atom_table = NULL;
+static uint32_t last_atom_slot = ATOM_TABLES - 1;
+
+/*
+ * Free a table and every string in it
+ */
+static void free_atom_table(AtomTable_t* table) {
+    for (uint32_t i = 0; i < ATOM_SHARDS; i++) {
+        AtomShard_t* shard = &table->shards[i];
+        free(shard->slots);
+        free(shard->texts);
+        free(shard->lengths);
+        free(shard->hashes);
+        c_parser_arena_release(&shard->arena);
+        pthread_mutex_destroy(&shard->lock);
+    }
+    free(table);
+}
+
+/*
+ * Take a hold on the current table, starting a new one if the last was retired
+ *
+ * `AtomTable_t*` - The held table, or NULL if none could be made
+ */
+static AtomTable_t* hold_current_atom_table(void) {
+    pthread_mutex_lock(&atom_tables_lock);
+    if (!current_atom_table) {
+        // Slots are handed out in turn, so a just-freed table's atoms do not decode into the next
+        for (uint32_t step = 1; step <= ATOM_TABLES; step++) {
+            uint32_t slot = (last_atom_slot + step) & (ATOM_TABLES - 1);
+            if (atom_tables[slot]) continue;
+
+            AtomTable_t* table = calloc(1, sizeof(AtomTable_t));
+            if (!table) break;
+            for (uint32_t i = 0; i < ATOM_SHARDS; i++) {
+                pthread_mutex_init(&table->shards[i].lock, NULL);
+            }
+            table->slot = slot;
+            table->holders = 1;
+            atom_tables[slot] = table;
+            current_atom_table = table;
+            last_atom_slot = slot;
+            break;
+        }
+    }
+    AtomTable_t* table = current_atom_table;
+    if (table) table->holders++;
+    pthread_mutex_unlock(&atom_tables_lock);
+    return table;
+}
+
+/*
+ * Drop a hold from hold_current_atom_table(), freeing a retired table with its last
+ */
+static void release_atom_table(AtomTable_t* table) {
+    if (!table) return;
+
+    pthread_mutex_lock(&atom_tables_lock);
+    bool last = --table->holders == 0;
+    if (last) atom_tables[table->slot] = NULL;
+    pthread_mutex_unlock(&atom_tables_lock);
+
+    if (last) free_atom_table(table);
+}
+
+/*
+ * Stop interning into the current table; the next intern starts a fresh one
+ *
+ * -- Kept as is when every slot is taken by tables parses still hold, so
+ *    interning never has to fail for want of a slot
+ */
+static void retire_atom_table(void) {
+    pthread_mutex_lock(&atom_tables_lock);
+    AtomTable_t* retired = current_atom_table;
+    bool slot_free = retired && retired->holders == 1;
+    for (uint32_t slot = 0; retired && !slot_free && slot < ATOM_TABLES; slot++) {
+        slot_free = atom_tables[slot] == NULL;
+    }
+    if (!slot_free) retired = NULL;
+    if (retired) current_atom_table = NULL;
+    pthread_mutex_unlock(&atom_tables_lock);
+
+    release_atom_table(retired);
+}
+
+/*
+ * Find a string's index in a locked shard, or -1
+ */
+static int64_t atom_shard_find(const AtomShard_t* shard, const char* text, uint32_t length, uint32_t hash) {
+    if (!shard->slots) return -1;
+
+    uint32_t slot = (hash >> ATOM_SHARD_BITS) & shard->mask;
+    while (shard->slots[slot] != 0) {
+        uint32_t index = shard->slots[slot] - 1;
+        if (shard->hashes[index] == hash && shard->lengths[index] == length &&
+            memcmp(shard->texts[index], text, length) == 0) {
+            return index;
+        }
+        slot = (slot + 1) & shard->mask;
+    }
+    return -1;
+}
+
+/*
+ * Make room for one more string in a locked shard
+ */
+static bool atom_shard_reserve(AtomShard_t* shard) {
+    if (shard->count < shard->capacity) return true;
+
+    uint32_t capacity = shard->capacity ? shard->capacity * 2 : ATOM_MIN_SLOTS / 2;
+    const char** texts = realloc(shard->texts, sizeof(char*) * capacity);
+    if (!texts) return false;
+    shard->texts = texts;
+    uint32_t* lengths = realloc(shard->lengths, sizeof(uint32_t) * capacity);
+    if (!lengths) return false;
+    shard->lengths = lengths;
+    uint32_t* hashes = realloc(shard->hashes, sizeof(uint32_t) * capacity);
+    if (!hashes) return false;
+    shard->hashes = hashes;
+
+    // Slots stay at most half full
+    uint32_t* slots = calloc((size_t)capacity * 2, sizeof(uint32_t));
+    if (!slots) return false;
+    uint32_t mask = capacity * 2 - 1;
+    for (uint32_t index = 0; index < shard->count; index++) {
+        uint32_t slot = (shard->hashes[index] >> ATOM_SHARD_BITS) & mask;
+        while (slots[slot] != 0) slot = (slot + 1) & mask;
+        slots[slot] = index + 1;
+    }
+    free(shard->slots);
+    shard->slots = slots;
+    shard->mask = mask;
+    shard->capacity = capacity;
+    return true;
+}
+
+/*
+ * Look up, and optionally add, a string in a held atom table
+ *
+ * `text_out` - Receives the interned text when the string is found or added; may be NULL
+ */
+static Atom_t atom_lookup(AtomTable_t* table, const char* text, size_t length, bool insert, const char** text_out) {
+    if (!table || !text || length >= UINT32_MAX) return ATOM_NONE;
+
+    uint32_t hash = c_parser_perfect_hash(text, length, 0);
+    uint32_t shard_id = hash & (ATOM_SHARDS - 1);
+    AtomShard_t* shard = &table->shards[shard_id];
+
+    pthread_mutex_lock(&shard->lock);
+    int64_t index = atom_shard_find(shard, text, (uint32_t)length, hash);
+    if (index < 0 && insert && shard->count < (UINT32_MAX >> ATOM_INDEX_SHIFT) - 1 && atom_shard_reserve(shard)) {
+        const char* copy = c_parser_arena_strndup(&shard->arena, text, length);
+        if (copy) {
+            index = shard->count++;
+            shard->texts[index] = copy;
+            shard->lengths[index] = (uint32_t)length;
+            shard->hashes[index] = hash;
+
+            uint32_t slot = (hash >> ATOM_SHARD_BITS) & shard->mask;
+            while (shard->slots[slot] != 0) slot = (slot + 1) & shard->mask;
+            shard->slots[slot] = (uint32_t)index + 1;
+        }
+    }
+    if (text_out) *text_out = index < 0 ? NULL : shard->texts[index];
+    pthread_mutex_unlock(&shard->lock);
+
+    if (index < 0) return ATOM_NONE;
+    return (Atom_t)((((uint32_t)index + 1) << ATOM_INDEX_SHIFT) | (table->slot << ATOM_SHARD_BITS) | shard_id);
+}
+
+/*
+ * Intern a string, adding it to the current run's table on first use
+ */
+Atom_t c_parser_intern(const char* text, size_t length) {
+    if (!text) return ATOM_NONE;
+
+    AtomTable_t* table = hold_current_atom_table();
+    Atom_t atom = atom_lookup(table, text, length, true, NULL);
+    release_atom_table(table);
+    return atom;
+}
+
+/*
+ * Look up a string's atom in the current run's table without adding it
+ */
+Atom_t c_parser_atom_find(const char* text, size_t length) {
+    if (!text) return ATOM_NONE;
+
+    AtomTable_t* table = hold_current_atom_table();
+    Atom_t atom = atom_lookup(table, text, length, false, NULL);
+    release_atom_table(table);
+    return atom;
+}
+
+/*
+ * Get the null-terminated text of an atom
+ */
+const char* c_parser_atom_text(Atom_t atom) {
+    if (atom == ATOM_NONE) return NULL;
+
+    uint32_t index = (atom >> ATOM_INDEX_SHIFT) - 1;
+    const char* text = NULL;
+
+    // The tables lock keeps the table from being freed while its shard is read
+    pthread_mutex_lock(&atom_tables_lock);
+    AtomTable_t* table = atom_tables[(atom >> ATOM_SHARD_BITS) & (ATOM_TABLES - 1)];
+    if (table) {
+        AtomShard_t* shard = &table->shards[atom & (ATOM_SHARDS - 1)];
+        pthread_mutex_lock(&shard->lock);
+        if (index < shard->count) text = shard->texts[index];
+        pthread_mutex_unlock(&shard->lock);
+    }
+    pthread_mutex_unlock(&atom_tables_lock);
+    return text;
+}
+
+/*
+ * Check whether two atoms come from the same table
+ */
+bool c_parser_atoms_comparable(Atom_t first, Atom_t second) {
+    return first != ATOM_NONE && second != ATOM_NONE &&
+           ((first ^ second) & ((ATOM_TABLES - 1) << ATOM_SHARD_BITS)) == 0;
+}
+
 // =============================================================================
 // PARSER CONTEXT & UTILITIES
 // =============================================================================
@@ -79,73 +518,245 @@ static const char* TYPE_KEYWORDS[] = {
 /*
  * Initialize a new parser context for divine understanding
  */
-static void init_parser_context(ParserContext_t* ctx, const char* source) {
+static void init_parser_context(ParserContext_t* ctx, const char* source, size_t source_length) {
     if (!ctx || !source) return;
 
     memset(ctx, 0, sizeof(ParserContext_t));
     ctx->source = source;
-    ctx->source_length = strlen(source);
-    ctx->line = 1;
-    ctx->column = 1;
+    ctx->source_length = source_length;
     ctx->position = 0;
 }
 
 /*
- * Create a new parsed file structure with divine initialization
+ * Grow every array of a token store to hold at least `capacity` tokens
  */
-static ParsedFile_t* create_parsed_file(const char* file_path) {
-    ParsedFile_t* parsed = calloc(1, sizeof(ParsedFile_t));
-    if (!parsed) return NULL;
+static bool reserve_token_store(TokenStore_t* store, int capacity) {
+    if (!store) return false;
+    if (capacity <= store->capacity) return true;
 
-    parsed->file_path = strdup(file_path ? file_path : "unknown");
-    if (!parsed->file_path) {
-        free(parsed);
-        return NULL;
-    }
+    // Each array is resized independently; a failure leaves the larger ones in place,
+    // which is harmless because `capacity` is only raised once all of them succeed
+    uint8_t* kinds = realloc(store->kinds, (size_t)capacity);
+    if (!kinds) return false;
+    store->kinds = kinds;
 
-    // Initialize token array with divine capacity
-    parsed->token_capacity = 2000;
-    parsed->tokens = malloc(sizeof(Token_t) * parsed->token_capacity);
+    uint8_t* sub_kinds = realloc(store->sub_kinds, (size_t)capacity);
+    if (!sub_kinds) return false;
+    store->sub_kinds = sub_kinds;
 
-    // Initialize function array
-    parsed->function_capacity = 100;
-    parsed->functions = malloc(sizeof(FunctionInfo_t) * parsed->function_capacity);
+    uint32_t* offsets = realloc(store->offsets, sizeof(uint32_t) * (size_t)capacity);
+    if (!offsets) return false;
+    store->offsets = offsets;
 
-    // Initialize include array
-    parsed->include_capacity = 50;
-    parsed->includes = malloc(sizeof(char*) * parsed->include_capacity);
+    int32_t* lengths = realloc(store->lengths, sizeof(int32_t) * (size_t)capacity);
+    if (!lengths) return false;
+    store->lengths = lengths;
 
-    if (!parsed->tokens || !parsed->functions || !parsed->includes) {
-        c_parser_free_parsed_file(parsed);
-        return NULL;
+    int32_t* lines = realloc(store->lines, sizeof(int32_t) * (size_t)capacity);
+    if (!lines) return false;
+    store->lines = lines;
+
+    store->capacity = capacity;
+    return true;
+}
+
+/*
+ * Release every array of a token store and reset it to empty
+ */
+static void free_token_store(TokenStore_t* store) {
+    if (!store) return;
+
+    free(store->kinds);
+    free(store->sub_kinds);
+    free(store->offsets);
+    free(store->lengths);
+    free(store->lines);
+    memset(store, 0, sizeof(TokenStore_t));
+}
+
+/*
+ * Record the start offset of every line in `source` - one memchr sweep
+ */
+static bool build_line_index(const char* source, size_t source_length, LineIndex_t* index) {
+    if (!source || !index) return false;
+
+    // Typical C averages 30-40 bytes per line; start there and double as needed
+    int capacity = (int)(source_length / 32) + 16;
+    uint32_t* starts = malloc(sizeof(uint32_t) * (size_t)capacity);
+    if (!starts) return false;
+
+    int count = 0;
+    starts[count++] = 0;
+
+    const char* cursor = source;
+    const char* end = source + source_length;
+    const char* newline;
+    while ((newline = memchr(cursor, '\n', (size_t)(end - cursor))) != NULL) {
+        if (count >= capacity) {
+            capacity *= 2;
+            uint32_t* new_starts = realloc(starts, sizeof(uint32_t) * (size_t)capacity);
+            if (!new_starts) {
+                free(starts);
+                return false;
+            }
+            starts = new_starts;
+        }
+        cursor = newline + 1;
+        starts[count++] = (uint32_t)(cursor - source);
     }
 
-    return parsed;
+    index->starts = starts;
+    index->count = count;
+    return true;
 }
 
 /*
- * Expand array capacity with divine growth management
+ * Release a line index and reset it to empty
  */
-static bool expand_token_capacity(ParsedFile_t* parsed) {
-    if (!parsed) return false;
+static void free_line_index(LineIndex_t* index) {
+    if (!index) return;
+
+    free(index->starts);
+    index->starts = NULL;
+    index->count = 0;
+}
 
-    size_t new_capacity = parsed->token_capacity * 2;
-    Token_t* new_tokens = realloc(parsed->tokens, sizeof(Token_t) * new_capacity);
-    if (!new_tokens) return false;
+// =============================================================================
+// PARSE BUFFER POOL
+// =============================================================================
+
+// Typical densities of real C; headers run sparser, dense generated code denser
+#define BYTES_PER_TOKEN_ESTIMATE 6
+#define BYTES_PER_FUNCTION_ESTIMATE 256
+#define BYTES_PER_INCLUDE_ESTIMATE 1024
+#define BYTES_PER_CALL_ESTIMATE 128
+#define MIN_TOKEN_CAPACITY 64
+#define MIN_FUNCTION_CAPACITY 8
+#define MIN_INCLUDE_CAPACITY 8
+#define MIN_CALL_CAPACITY 16
 
-    parsed->tokens = new_tokens;
-    parsed->token_capacity = new_capacity;
+/*
+ * Initial capacity for `length` bytes of source at `bytes_per_item`, never below `minimum`
+ */
+static int estimate_capacity(size_t length, size_t bytes_per_item, int minimum) {
+    size_t estimate = length / bytes_per_item + (size_t)minimum;
+    return estimate > INT_MAX / 2 ? INT_MAX / 2 : (int)estimate;
+}
+
+/*
+ * Free a parse's token, function and include arrays and the structure itself
+ */
+static void free_pooled_file(ParsedFile_t* parsed) {
+    free_token_store(&parsed->token_store);
+    free(parsed->functions);
+    free(parsed->includes);
+    free(parsed);
+}
+
+/*
+ * Keep an otherwise freed parse for the thread's next one, if its pool is open
+ *
+ * `parsed` - Parse whose other resources are already released
+ *
+ * `bool` - true if the pool took it, false if the caller must free it
+ */
+static bool keep_pooled_file(ParsedFile_t* parsed) {
+    ThreadSpares_t* spares = thread_spares();
+    if (!spares || spares->pool_depth == 0 || spares->file_count >= PARSE_POOL_FILES) return false;
+    if (parsed->token_store.capacity > PARSE_POOL_MAX_TOKENS) return false;
+
+    TokenStore_t store = parsed->token_store;
+    FunctionInfo_t* functions = parsed->functions;
+    int function_capacity = parsed->function_capacity;
+    char** includes = parsed->includes;
+    int include_capacity = parsed->include_capacity;
+
+    memset(parsed, 0, sizeof(ParsedFile_t));
+    parsed->token_store = store;
+    parsed->token_store.count = 0;
+    parsed->functions = functions;
+    parsed->function_capacity = function_capacity;
+    parsed->includes = includes;
+    parsed->include_capacity = include_capacity;
+
+    spares->files[spares->file_count++] = parsed;
     return true;
 }
 
+/*
+ * Start recycling parse buffers on the calling thread
+ */
+void c_parser_pool_begin(void) {
+    ThreadSpares_t* spares = thread_spares();
+    if (spares) spares->pool_depth++;
+}
+
+/*
+ * Stop recycling parse buffers on the calling thread and free the kept ones
+ */
+void c_parser_pool_end(void) {
+    ThreadSpares_t* spares = thread_spares();
+    if (!spares || spares->pool_depth == 0 || --spares->pool_depth > 0) return;
+
+    while (spares->file_count > 0) {
+        free_pooled_file(spares->files[--spares->file_count]);
+    }
+}
+
+/*
+ * Create an empty parsed file sized for `source_length` bytes of source
+ *
+ * Reuses a pooled parse's arrays when the thread has one, growing them once if needed.
+ */
+static ParsedFile_t* create_parsed_file(const char* file_path, size_t source_length) {
+    ThreadSpares_t* spares = thread_spares();
+    ParsedFile_t* parsed = (spares && spares->file_count > 0) ? spares->files[--spares->file_count]
+                                                              : calloc(1, sizeof(ParsedFile_t));
+    if (!parsed) return NULL;
+
+    parsed->file_path = strdup(file_path ? file_path : "unknown");
+    if (!parsed->file_path) {
+        c_parser_free_parsed_file(parsed);
+        return NULL;
+    }
+
+    // Without a table every string is copied into the arena and lookups scan
+    parsed->atoms = hold_current_atom_table();
+
+    // The token store is sized by the tokenizer, and the Token_t view is built on demand
+    int function_capacity = estimate_capacity(source_length, BYTES_PER_FUNCTION_ESTIMATE, MIN_FUNCTION_CAPACITY);
+    if (parsed->function_capacity < function_capacity) {
+        FunctionInfo_t* functions = realloc(parsed->functions, sizeof(FunctionInfo_t) * (size_t)function_capacity);
+        if (!functions) {
+            c_parser_free_parsed_file(parsed);
+            return NULL;
+        }
+        parsed->functions = functions;
+        parsed->function_capacity = function_capacity;
+    }
+
+    int include_capacity = estimate_capacity(source_length, BYTES_PER_INCLUDE_ESTIMATE, MIN_INCLUDE_CAPACITY);
+    if (parsed->include_capacity < include_capacity) {
+        char** includes = realloc(parsed->includes, sizeof(char*) * (size_t)include_capacity);
+        if (!includes) {
+            c_parser_free_parsed_file(parsed);
+            return NULL;
+        }
+        parsed->includes = includes;
+        parsed->include_capacity = include_capacity;
+    }
+
+    return parsed;
+}
+
 /*
  * Expand function array capacity
  */
 static bool expand_function_capacity(ParsedFile_t* parsed) {
     if (!parsed) return false;
 
-    size_t new_capacity = parsed->function_capacity * 2;
-    FunctionInfo_t* new_functions = realloc(parsed->functions, sizeof(FunctionInfo_t) * new_capacity);
+    int new_capacity = parsed->function_capacity * 2;
+    FunctionInfo_t* new_functions = realloc(parsed->functions, sizeof(FunctionInfo_t) * (size_t)new_capacity);
     if (!new_functions) return false;
 
     parsed->functions = new_functions;
@@ -158,30 +769,171 @@ static bool expand_function_capacity(ParsedFile_t* parsed) {
 // =============================================================================
 
 /*
- * Add a token to the parsed file with divine growth management
+ * Append a token to a token store with divine growth management
+ * Tokens only record where their text lives - no per-token allocation
  */
-static bool add_token(ParsedFile_t* parsed, TokenType_t type, const char* value,
-                      int line, int column, int length) {
-    if (!parsed || !value) return false;
+static bool add_token(TokenStore_t* store, TokenType_t type, TokenSubKind_t sub_kind,
+                      size_t offset, int line, int length) {
+    if (!store) return false;
 
     // Expand capacity if needed
-    if (parsed->token_count >= parsed->token_capacity) {
-        if (!expand_token_capacity(parsed)) return false;
+    if (store->count >= store->capacity) {
+        if (!reserve_token_store(store, store->capacity ? store->capacity * 2 : MIN_TOKEN_CAPACITY)) return false;
+    }
+
+    int i = store->count;
+    store->kinds[i] = (uint8_t)type;
+    store->sub_kinds[i] = (uint8_t)sub_kind;
+    store->offsets[i] = (uint32_t)offset;
+    store->lengths[i] = length;
+    store->lines[i] = line;
+
+    store->count++;
+    return true;
+}
+
+/*
+ * Get the 1-based column of token `index` from its offset and its line's start
+ */
+static inline int token_column(const TokenStore_t* store, const LineIndex_t* line_index, int index) {
+    return (int)(store->offsets[index] - line_index->starts[store->lines[index] - 1]) + 1;
+}
+
+/*
+ * Gather token `index` of a store into a Token_t
+ */
+static inline Token_t token_from_store(const TokenStore_t* store, const LineIndex_t* line_index, int index) {
+    Token_t token;
+    token.type = (TokenType_t)store->kinds[index];
+    token.offset = store->offsets[index];
+    token.line = store->lines[index];
+    token.column = token_column(store, line_index, index);
+    token.length = store->lengths[index];
+    token.sub_kind = store->sub_kinds[index];
+    return token;
+}
+
+/*
+ * Build a text-only Token_t view of token `index` for the text accessors
+ * -- Only offset and length are meaningful; use token_from_store() for positions
+ */
+static inline Token_t token_text_view(const TokenStore_t* store, int index) {
+    Token_t token = {0};
+    token.type = (TokenType_t)store->kinds[index];
+    token.offset = store->offsets[index];
+    token.length = store->lengths[index];
+    return token;
+}
+
+/*
+ * Build a Token_t array from a token store - caller frees the result
+ */
+static Token_t* token_store_to_array(const TokenStore_t* store, const LineIndex_t* line_index) {
+    Token_t* tokens = malloc(sizeof(Token_t) * (size_t)(store->count > 0 ? store->count : 1));
+    if (!tokens) return NULL;
+
+    for (int i = 0; i < store->count; i++) {
+        tokens[i] = token_from_store(store, line_index, i);
+    }
+    return tokens;
+}
+
+/*
+ * Find the first token starting on or after `line` - binary search over lines
+ */
+static int first_token_at_line(const TokenStore_t* store, int line) {
+    int low = 0;
+    int high = store->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (store->lines[mid] < line) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
     }
+    return low;
+}
 
-    Token_t* token = &parsed->tokens[parsed->token_count];
-    token->type = type;
-    token->value = strdup(value);
-    if (!token->value) return false;
+/*
+ * Gather one token of a parsed file from its struct-of-arrays store
+ */
+Token_t c_parser_token_at(const ParsedFile_t* parsed, int index) {
+    if (!parsed || index < 0 || index >= parsed->token_store.count) {
+        Token_t none = {0};
+        none.type = TOKEN_EOF;
+        return none;
+    }
+    return token_from_store(&parsed->token_store, &parsed->line_index, index);
+}
 
-    token->line = line;
-    token->column = column;
-    token->length = length;
+/*
+ * Convert a source offset to a line and column with a binary search
+ */
+bool c_parser_offset_to_line_column(const ParsedFile_t* parsed, uint32_t offset, int* line_out, int* column_out) {
+    if (!parsed || !parsed->line_index.starts || offset > parsed->source_length) return false;
+
+    // Find the last line starting at or before `offset`
+    const uint32_t* starts = parsed->line_index.starts;
+    int low = 0;
+    int high = parsed->line_index.count - 1;
+    while (low < high) {
+        int mid = low + (high - low + 1) / 2;
+        if (starts[mid] <= offset) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
 
-    parsed->token_count++;
+    if (line_out) *line_out = low + 1;
+    if (column_out) *column_out = (int)(offset - starts[low]) + 1;
     return true;
 }
 
+/*
+ * Check whether token `index` of a store contains a substring
+ */
+static bool store_token_contains(const char* source, const TokenStore_t* store, int index, const char* pattern) {
+    Token_t token = token_text_view(store, index);
+    return c_parser_token_contains(source, &token, pattern);
+}
+
+/*
+ * Copy the text of token `index` of a store into a caller-provided buffer
+ */
+static size_t store_token_copy_to(const char* source, const TokenStore_t* store, int index,
+                                  char* buffer, size_t buffer_size) {
+    Token_t token = token_text_view(store, index);
+    return c_parser_token_copy_to(source, &token, buffer, buffer_size);
+}
+
+/*
+ * Get (building once) the Token_t array view of a parsed file
+ */
+Token_t* c_parser_tokens(ParsedFile_t* parsed) {
+    if (!parsed) return NULL;
+
+    if (!parsed->tokens) {
+        parsed->tokens = token_store_to_array(&parsed->token_store, &parsed->line_index);
+    }
+    return parsed->tokens;
+}
+
+/*
+ * Intern `text` in the parse's atom table and share its copy, or copy it into the arena if that failed
+ *
+ * `atom_out` - Receives the atom, ATOM_NONE if interning failed; may be NULL
+ *
+ * Interned text is never written through the returned pointer.
+ */
+static char* interned_text(ParsedFile_t* parsed, const char* text, Atom_t* atom_out) {
+    const char* shared = NULL;
+    Atom_t atom = atom_lookup(parsed->atoms, text, strlen(text), true, &shared);
+    if (atom_out) *atom_out = atom;
+    return shared ? (char*)shared : c_parser_arena_strdup(&parsed->arena, text);
+}
+
 /*
  * Add a function to the parsed file with divine tracking
  */
@@ -197,8 +949,9 @@ static bool add_function(ParsedFile_t* parsed, const char* name, const char* ret
     FunctionInfo_t* func = &parsed->functions[parsed->function_count];
     memset(func, 0, sizeof(FunctionInfo_t));
 
-    func->name = strdup(name);
-    func->return_type = strdup(return_type ? return_type : "unknown");
+    // Return types are tokens joined by single spaces, so equal types intern to equal atoms
+    func->name = interned_text(parsed, name, &func->name_atom);
+    func->return_type = interned_text(parsed, return_type ? return_type : "unknown", &func->return_type_atom);
     if (!func->name || !func->return_type) return false;
 
     func->line_number = line;
@@ -208,9 +961,50 @@ static bool add_function(ParsedFile_t* parsed, const char* name, const char* ret
     func->param_count = 0;
     func->parameters = NULL;
     func->has_documentation = false;
+    func->body_start = -1;
+    func->body_end = -1;
+    func->doc_comment = -1;
+
+    parsed->function_count++;
+    return true;
+}
+
+#define DOC_COMMENT_WINDOW  20  // Lines above a function searched for its comment
+#define DOC_COMMENT_MAX_GAP 3   // Lines allowed between the comment's end and the function
+
+/*
+ * Link a just-added function to the block comment nearest above it
+ *
+ * `comment_index` is the candidate the parse loop tracked; it documents the
+ * function when it ends close above it with no code in between.
+ */
+static void link_function_documentation(ParsedFile_t* parsed, FunctionInfo_t* func, int comment_index) {
+    const TokenStore_t* ts = &parsed->token_store;
+    int func_line = func->line_number;
+    if (comment_index < 0 || ts->lines[comment_index] < func_line - DOC_COMMENT_WINDOW) return;
+
+    func->doc_comment = comment_index;
 
-    parsed->function_count++;
-    return true;
+    // The comment ends at its start line plus the number of newlines it spans
+    const char* comment_text = parsed->source + ts->offsets[comment_index];
+    int comment_end_line = ts->lines[comment_index];
+    for (int p = 0; p < ts->lengths[comment_index]; p++) {
+        if (comment_text[p] == '\n') comment_end_line++;
+    }
+    if (func_line - comment_end_line > DOC_COMMENT_MAX_GAP) return;
+
+    // Any significant code between comment end and function breaks the link
+    for (int i = first_token_at_line(ts, comment_end_line + 1); i < ts->count && ts->lines[i] < func_line; i++) {
+        if (ts->kinds[i] != TOKEN_NEWLINE &&
+            ts->kinds[i] != TOKEN_COMMENT_LINE &&
+            ts->kinds[i] != TOKEN_COMMENT_BLOCK &&
+            ts->kinds[i] != TOKEN_PREPROCESSOR) {
+            return;
+        }
+    }
+
+    func->has_documentation = true;
+    func->documentation = c_parser_arena_strndup(&parsed->arena, comment_text, (size_t)ts->lengths[comment_index]);
 }
 
 /*
@@ -221,15 +1015,15 @@ static bool add_include(ParsedFile_t* parsed, const char* include_path) {
 
     // Expand capacity if needed
     if (parsed->include_count >= parsed->include_capacity) {
-        size_t new_capacity = parsed->include_capacity * 2;
-        char** new_includes = realloc(parsed->includes, sizeof(char*) * new_capacity);
+        int new_capacity = parsed->include_capacity * 2;
+        char** new_includes = realloc(parsed->includes, sizeof(char*) * (size_t)new_capacity);
         if (!new_includes) return false;
 
         parsed->includes = new_includes;
         parsed->include_capacity = new_capacity;
     }
 
-    parsed->includes[parsed->include_count] = strdup(include_path);
+    parsed->includes[parsed->include_count] = interned_text(parsed, include_path, NULL);
     if (!parsed->includes[parsed->include_count]) return false;
 
     parsed->include_count++;
@@ -237,647 +1031,566 @@ static bool add_include(ParsedFile_t* parsed, const char* include_path) {
 }
 
 // =============================================================================
-// LEXICAL ANALYSIS - DIVINE TOKENIZATION
+// TOKEN TEXT ACCESSORS
 // =============================================================================
 
 /*
- * Skip whitespace and update position with line tracking
+ * Get a pointer to a token's text inside its source buffer
  */
-static void skip_whitespace(ParserContext_t* ctx) {
-    while (ctx->position < ctx->source_length &&
-           isspace(ctx->source[ctx->position])) {
-        if (ctx->source[ctx->position] == '\n') {
-            ctx->line++;
-            ctx->column = 1;
-        } else {
-            ctx->column++;
-        }
-        ctx->position++;
-    }
+const char* c_parser_token_text(const char* source, const Token_t* token) {
+    if (!source || !token) return NULL;
+    return source + token->offset;
 }
 
 /*
- * Read an identifier or keyword with proper bounds checking
+ * Check whether a token's text is exactly equal to a string
  */
-static int read_identifier(ParserContext_t* ctx, char* buffer, size_t buffer_size) {
-    int length = 0;
+bool c_parser_token_equals(const char* source, const Token_t* token, const char* text) {
+    if (!source || !token || !text) return false;
 
-    while (ctx->position < ctx->source_length &&
-           (isalnum(ctx->source[ctx->position]) || ctx->source[ctx->position] == '_') &&
-           length < (int)(buffer_size - 1)) {
-        buffer[length] = ctx->source[ctx->position];
-        length++;
-        ctx->position++;
-        ctx->column++;
-    }
+    size_t text_length = strlen(text);
+    if ((size_t)token->length != text_length) return false;
 
-    buffer[length] = '\0';
-    return length;
+    return memcmp(source + token->offset, text, text_length) == 0;
 }
 
 /*
- * Read a string literal with escape sequence handling
+ * Check whether a token's text contains a substring
  */
-static int read_string(ParserContext_t* ctx, char* buffer, size_t buffer_size) {
-    int length = 0;
-    char quote_char = ctx->source[ctx->position];
-    bool escaped = false;
-
-    // Include opening quote
-    buffer[length++] = quote_char;
-    ctx->position++;
-    ctx->column++;
-
-    while (ctx->position < ctx->source_length && length < (int)(buffer_size - 1)) {
-        char c = ctx->source[ctx->position];
-        buffer[length++] = c;
-
-        if (!escaped && c == quote_char) {
-            ctx->position++;
-            ctx->column++;
-            break;
-        }
+bool c_parser_token_contains(const char* source, const Token_t* token, const char* pattern) {
+    if (!source || !token || !pattern) return false;
 
-        escaped = (!escaped && c == '\\');
+    size_t pattern_length = strlen(pattern);
+    size_t token_length = (size_t)token->length;
+    if (pattern_length == 0) return true;
+    if (pattern_length > token_length) return false;
 
-        if (c == '\n') {
-            ctx->line++;
-            ctx->column = 1;
-        } else {
-            ctx->column++;
-        }
-        ctx->position++;
+    const char* text = source + token->offset;
+    const char* last = text + (token_length - pattern_length);
+    for (const char* p = text; p <= last; p++) {
+        p = memchr(p, pattern[0], (size_t)(last - p) + 1);
+        if (!p) return false;
+        if (memcmp(p, pattern, pattern_length) == 0) return true;
     }
-
-    buffer[length] = '\0';
-    return length;
+    return false;
 }
+
 /*
- * Helper function to determine if a character is valid within a number literal,
- * considering current parsing state (e.g., if a decimal or exponent has already been seen).
- * Updates has_dot and has_e flags as necessary.
- *
- * `c` - The current character to evaluate.
- * `has_dot` - Pointer to a boolean flag indicating if a decimal point has been encountered.
- * `has_e` - Pointer to a boolean flag indicating if an exponent 'e' or 'E' has been encountered.
- * `next_c` - The next character in the source, used for lookahead (e.g., for 'e+' or 'e-').
- *
- * `bool` - True if the character is valid for the current number literal, false otherwise.
+ * Copy a token's text into a caller-provided buffer
  */
-static bool _is_valid_number_char(char c, bool* has_dot, bool* has_e, char next_c) {
-    // Digits, hex characters, and suffixes (u, U, l, L)
-    if (isalnum(c) || c == '_') { // Alnum covers digits and hex (a-f, A-F)
-        return true;
-    }
+size_t c_parser_token_copy_to(const char* source, const Token_t* token, char* buffer, size_t buffer_size) {
+    if (!source || !token || !buffer || buffer_size == 0) return 0;
 
-    // Decimal point
-    if (c == '.') {
-        if (!*has_dot && !*has_e) { // Only one dot allowed, not after exponent
-            *has_dot = true;
-            return true;
-        }
-        return false; // Invalid: multiple dots or dot after exponent
-    }
+    size_t copy_length = (size_t)token->length;
+    if (copy_length > buffer_size - 1) copy_length = buffer_size - 1;
 
-    // Exponent (e or E)
-    if (c == 'e' || c == 'E') {
-        if (!*has_e) { // Only one 'e' or 'E' allowed
-            *has_e = true;
-            // Optionally handle +/- after e/E
-            return true;
-        }
-        return false; // Invalid: multiple exponents
-    }
+    memcpy(buffer, source + token->offset, copy_length);
+    buffer[copy_length] = '\0';
+    return copy_length;
+}
 
-    // Sign after exponent
-    if ((c == '+' || c == '-') && *has_e && (next_c != '\0' && isdigit(next_c))) {
-        // This is tricky: we only accept +/- if it immediately follows e/E
-        // and is followed by a digit. The main loop will advance past it.
-        // This helper just validates 'e', and the main loop handles the +/- after 'e'.
-        // For simplicity and to keep this helper focused on *single* char validity,
-        // we'll primarily validate the 'e' itself here. The +/- logic
-        // is best kept in `read_number` where lookahead is natural.
-        return true; // We'll let read_number handle advancing for this.
-    }
+/*
+ * Allocate a null-terminated copy of a token's text
+ */
+char* c_parser_token_strdup(const char* source, const Token_t* token) {
+    if (!source || !token) return NULL;
+
+    char* copy = malloc((size_t)token->length + 1);
+    if (!copy) return NULL;
 
-    return false; // Not a valid number character
+    memcpy(copy, source + token->offset, (size_t)token->length);
+    copy[token->length] = '\0';
+    return copy;
 }
 
+// =============================================================================
+// LEXICAL ANALYSIS - DIVINE TOKENIZATION
+// =============================================================================
+
 /*
- * Helper function to read a hexadecimal number literal (after "0x" or "0X").
- *
- * `ctx` - The parser context.
- * `buffer` - The buffer to write the number to.
- * `buffer_size` - The maximum size of the buffer.
- * `current_length` - The current length of the number already in the buffer (should be 2 for "0x").
- *
- * `int` - The total length of the number read, or `current_length` if no valid hex digits follow.
- */
-static int _read_hex_number(ParserContext_t* ctx, char* buffer, size_t buffer_size, int current_length) {
-    while (ctx->position < ctx->source_length && current_length < (int)(buffer_size - 1)) {
-        char c = ctx->source[ctx->position];
-        if (isxdigit((unsigned char)c) || c == 'u' || c == 'U' || c == 'l' || c == 'L') {
-            buffer[current_length++] = c;
-            ctx->position++;
-            ctx->column++;
-        } else {
-            break;
-        }
-    }
-    return current_length;
-}
+ * Character classes driving the lexer state machine
+ */
+typedef enum {
+    CHAR_OTHER = 0,         // Anything unrecognised - becomes TOKEN_UNKNOWN
+    CHAR_SPACE,             // ' ', \t, \v, \f, \r
+    CHAR_NEWLINE,           // \n
+    CHAR_IDENT,             // a-z, A-Z, _ (identifier start)
+    CHAR_DIGIT,             // 0-9
+    CHAR_QUOTE,             // " and ' (string and char literals)
+    CHAR_HASH,              // # (preprocessor directive)
+    CHAR_SLASH,             // / (comment or operator)
+    CHAR_DOT,               // . (punctuation or fractional number)
+    CHAR_OPERATOR,          // + - * % = < > ! & | ^ ~ ? :
+    CHAR_PUNCT              // ( ) { } [ ] ; ,
+} CharClass_t;
+
+#define O_ CHAR_OTHER
+#define S_ CHAR_SPACE
+#define N_ CHAR_NEWLINE
+#define I_ CHAR_IDENT
+#define D_ CHAR_DIGIT
+#define Q_ CHAR_QUOTE
+#define H_ CHAR_HASH
+#define SL CHAR_SLASH
+#define DT CHAR_DOT
+#define OP CHAR_OPERATOR
+#define P_ CHAR_PUNCT
+
+// One class per byte; bytes 0x80-0xFF are left zeroed as CHAR_OTHER
+static const uint8_t CHAR_CLASS[256] = {
+    O_, O_, O_, O_, O_, O_, O_, O_, O_, S_, N_, S_, S_, S_, O_, O_,  // 0x00
+    O_, O_, O_, O_, O_, O_, O_, O_, O_, O_, O_, O_, O_, O_, O_, O_,  // 0x10
+    S_, OP, Q_, H_, O_, OP, OP, Q_, P_, P_, OP, OP, P_, OP, DT, SL,  // 0x20
+    D_, D_, D_, D_, D_, D_, D_, D_, D_, D_, OP, P_, OP, OP, OP, OP,  // 0x30
+    O_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_,  // 0x40
+    I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, P_, O_, P_, OP, I_,  // 0x50
+    O_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_,  // 0x60
+    I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, I_, P_, OP, P_, OP, O_,  // 0x70
+};
+
+#undef O_
+#undef S_
+#undef N_
+#undef I_
+#undef D_
+#undef Q_
+#undef H_
+#undef SL
+#undef DT
+#undef OP
+#undef P_
 
 /*
- * Helper function to read the exponent part of a floating-point number (e.g., "e+10", "E-5").
- *
- * `ctx` - The parser context.
- * `buffer` - The buffer to write the number to.
- * `buffer_size` - The maximum size of the buffer.
- * `current_length` - The current length of the number already in the buffer (should include 'e'/'E').
- *
- * `int` - The total length of the number read, or `current_length` if no valid exponent digits follow.
- */
-static int _read_float_exponent(ParserContext_t* ctx, char* buffer, size_t buffer_size, int current_length) {
-    // Already consumed 'e' or 'E' by the caller
-    // Check for optional sign
-    if (ctx->position < ctx->source_length && current_length < (int)(buffer_size - 1)) {
-        char c = ctx->source[ctx->position];
-        if (c == '+' || c == '-') {
-            buffer[current_length++] = c;
-            ctx->position++;
-            ctx->column++;
-        }
-    }
-
-    // Read exponent digits
-    while (ctx->position < ctx->source_length && current_length < (int)(buffer_size - 1)) {
-        char c = ctx->source[ctx->position];
-        if (isdigit((unsigned char)c)) {
-            buffer[current_length++] = c;
-            ctx->position++;
-            ctx->column++;
-        } else {
-            break;
-        }
-    }
-    return current_length;
+ * Check if a byte may continue an identifier
+ */
+static inline bool _is_identifier_char(unsigned char c) {
+    return CHAR_CLASS[c] == CHAR_IDENT || CHAR_CLASS[c] == CHAR_DIGIT;
 }
 
 /*
- * Helper function to read the decimal or integer part of a number, including a single decimal point.
- * This function will *not* read an 'e' or 'E' exponent.
- *
- * `ctx` - The parser context.
- * `buffer` - The buffer to write the number to.
- * `buffer_size` - The maximum size of the buffer.
- * `current_length` - The current length of the number already in the buffer (e.g., initial sign).
- * `has_dot_out` - Output parameter: set to true if a decimal point was encountered.
- * `has_e_out` - Output parameter: set to true if an 'e' or 'E' was encountered.
- *
- * `int` - The total length of the number read.
- */
-static int _read_decimal_integer_or_float_part(ParserContext_t* ctx, char* buffer, size_t buffer_size, int current_length, bool* has_dot_out, bool* has_e_out) {
-    *has_dot_out = false;
-    *has_e_out = false; // This helper doesn't read 'e', but sets it to false for the caller
-
-    while (ctx->position < ctx->source_length && current_length < (int)(buffer_size - 1)) {
-        char c = ctx->source[ctx->position];
-
-        if (isdigit((unsigned char)c) || c == 'u' || c == 'U' || c == 'l' || c == 'L') {
-            buffer[current_length++] = c;
-            ctx->position++;
-            ctx->column++;
-        } else if (c == '.' && !*has_dot_out) { // Allow one decimal point
-            *has_dot_out = true;
-            buffer[current_length++] = c;
-            ctx->position++;
-            ctx->column++;
-        } else if (c == 'e' || c == 'E') { // Found 'e' or 'E', this part is done, let caller handle exponent
-            *has_e_out = true;
-            break;
-        } else {
-            break; // Not a number character
-        }
-    }
-    return current_length;
+ * Advance past a run of characters up to (not including) the next newline.
+ * Used for line comments and preprocessor directives.
+ */
+static void _lex_to_end_of_line(ParserContext_t* ctx) {
+    size_t limit = ctx->source_length;
+    const char* newline = memchr(ctx->source + ctx->position, '\n', limit - ctx->position);
+    size_t end = newline ? (size_t)(newline - ctx->source) : limit;
+
+    ctx->position = end;
 }
+
 /*
- * Read a number literal with hex/octal/float support
+ * Advance past a block comment, including its closing marker when present.
+ * An unterminated comment stops one byte short of the end of the source.
+ * Comments of any length stay a single token; memchr hops between '*'
+ * candidates so long license and Doxygen blocks cost little to skip.
  */
-static int read_number(ParserContext_t* ctx, char* buffer, size_t buffer_size) {
-    int length = 0;
-    bool has_dot = false;
-    bool has_e = false;
+static void _lex_block_comment(ParserContext_t* ctx) {
+    const char* src = ctx->source;
+    const char* last = src + ctx->source_length - 1;  // A '*' here has no room for '/'
+    const char* cursor = src + ctx->position + 2;      // '/*'
 
-    // Handle optional leading sign for numbers if it's the very first character
-    if (ctx->position < ctx->source_length) {
-        char initial_c = ctx->source[ctx->position];
-        if (initial_c == '+' || initial_c == '-') {
-            buffer[length++] = initial_c;
-            ctx->position++;
-            ctx->column++;
-        }
+    if (cursor >= last) {
+        ctx->position = (size_t)(cursor - src);
+        return;
     }
 
-    // Check for hexadecimal prefix
-    if (ctx->position + 1 < ctx->source_length &&
-        ctx->source[ctx->position] == '0' &&
-        (ctx->source[ctx->position + 1] == 'x' || ctx->source[ctx->position + 1] == 'X')) {
-        buffer[length++] = ctx->source[ctx->position++]; // '0'
-        buffer[length++] = ctx->source[ctx->position++]; // 'x' or 'X'
-        ctx->column += 2;
-        length = _read_hex_number(ctx, buffer, buffer_size, length);
-    } else {
-        // Must be a decimal integer or float
-        length = _read_decimal_integer_or_float_part(ctx, buffer, buffer_size, length, &has_dot, &has_e);
-        
-        // If an 'e' or 'E' was encountered, read the exponent part
-        if (has_e) {
-            buffer[length++] = ctx->source[ctx->position++]; // consume 'e' or 'E'
-            ctx->column++;
-            length = _read_float_exponent(ctx, buffer, buffer_size, length);
+    while (cursor < last) {
+        const char* star = memchr(cursor, '*', (size_t)(last - cursor));
+        if (!star) break;
+
+        if (star[1] == '/') {
+            ctx->position = (size_t)(star + 2 - src);
+            return;
         }
+        cursor = star + 1;
     }
 
-    buffer[length] = '\0';
-    return length;
+    ctx->position = (size_t)(last - src);
 }
+
 /*
- * Helper function to check if two characters form a known two-character operator.
- * If a match is found, copies the operator string to op_buffer.
- *
- * `c1` - The first character.
- * `c2` - The second character.
- * `op_buffer` - Buffer to store the operator string if found (must be at least 3 bytes).
- *
- * `bool` - True if c1c2 is a known two-character operator, false otherwise.
+ * Advance past a string or character literal with escape sequence handling
  */
-static bool _is_two_char_operator(char c1, char c2, char* op_buffer) {
-    if (!op_buffer) return false;
+static void _lex_quoted(ParserContext_t* ctx) {
+    const char* src = ctx->source;
+    char quote_char = src[ctx->position];
+    size_t limit = ctx->source_length;
+    size_t pos = ctx->position + 1;  // Include opening quote
+    bool escaped = false;
 
-    op_buffer[0] = c1;
-    op_buffer[1] = c2;
-    op_buffer[2] = '\0';
+    while (pos < limit) {
+        char c = src[pos];
 
-    for (int i = 0; TWO_CHAR_OPERATORS[i] != NULL; i++) {
-        if (strcmp(op_buffer, TWO_CHAR_OPERATORS[i]) == 0) {
-            return true;
+        if (!escaped && c == quote_char) {
+            pos++;
+            break;
         }
+
+        escaped = (!escaped && c == '\\');
+        pos++;
     }
-    op_buffer[0] = '\0'; // Clear buffer if not found
-    return false;
+
+    ctx->position = pos;
 }
 
 /*
- * Helper function to check if a character is a known single-character operator.
- *
- * `c` - The character to check.
- *
- * `bool` - True if c is a known single-character operator, false otherwise.
+ * Advance past a number literal with hex/float/exponent/suffix support
  */
-static bool _is_single_char_operator(char c) {
-    // This string contains all single-character operators
-    return strchr("+-*/%=<>!&|^~?:", c) != NULL;
+static void _lex_number(ParserContext_t* ctx) {
+    const unsigned char* src = (const unsigned char*)ctx->source;
+    size_t start = ctx->position;
+    size_t pos = start;
+    size_t limit = ctx->source_length;
+
+    if (pos + 1 < ctx->source_length && src[pos] == '0' && (src[pos + 1] == 'x' || src[pos + 1] == 'X')) {
+        // Hexadecimal: '0x' followed by hex digits and integer suffixes
+        pos += 2;
+        while (pos < limit && (isxdigit(src[pos]) || src[pos] == 'u' || src[pos] == 'U' ||
+                               src[pos] == 'l' || src[pos] == 'L')) {
+            pos++;
+        }
+    } else {
+        // Decimal integer or float with at most one decimal point
+        bool has_dot = false;
+        bool has_e = false;
+        while (pos < limit) {
+            unsigned char c = src[pos];
+            if (CHAR_CLASS[c] == CHAR_DIGIT || c == 'u' || c == 'U' || c == 'l' || c == 'L') {
+                pos++;
+            } else if (c == '.' && !has_dot) {
+                has_dot = true;
+                pos++;
+            } else {
+                has_e = (c == 'e' || c == 'E');
+                break;
+            }
+        }
+
+        // Exponent: 'e' is always taken, then an optional sign and digits
+        if (has_e) {
+            pos++;
+            if (pos < limit && (src[pos] == '+' || src[pos] == '-')) {
+                pos++;
+            }
+            while (pos < limit && CHAR_CLASS[src[pos]] == CHAR_DIGIT) {
+                pos++;
+            }
+        }
+    }
+
+    ctx->position = pos;
 }
+
 /*
- * Read a multi-character operator (like <=, >=, ==, !=, etc.)
+ * Advance past an identifier and look up its keyword ID (C_KEYWORD_NONE for identifiers)
  */
-static int read_operator(ParserContext_t* ctx, char* buffer, size_t buffer_size) {
-    if (ctx->position >= ctx->source_length || buffer_size < 3) return 0;
+static CKeywordId_t _lex_identifier(ParserContext_t* ctx) {
+    const unsigned char* src = (const unsigned char*)ctx->source;
+    size_t start = ctx->position;
+    size_t pos = start;
+    size_t limit = ctx->source_length;
 
-    char c1 = ctx->source[ctx->position];
-    char c2 = (ctx->position + 1 < ctx->source_length) ? ctx->source[ctx->position + 1] : '\0';
-
-    // Attempt to read a two-character operator first
-    if (_is_two_char_operator(c1, c2, buffer)) {
-        ctx->position += 2;
-        ctx->column += 2;
-        return 2;
+    while (pos < limit && _is_identifier_char(src[pos])) {
+        pos++;
     }
 
-    // If not a two-character operator, attempt to read a single-character operator
-    if (_is_single_char_operator(c1)) {
-        buffer[0] = c1;
-        buffer[1] = '\0';
-        ctx->position++;
-        ctx->column++;
-        return 1;
-    }
+    size_t length = pos - start;
+    ctx->position = pos;
 
-    return 0; // Not an operator
+    return c_parser_keyword_id(ctx->source + start, length);
 }
 
-// =============================================================================
-// PUBLIC API IMPLEMENTATION
-// =============================================================================
-
 /*
- * Check if a word is a C keyword
- * FIXED: Now also checks for 'inline' keyword
+ * Identify the operator starting with `c`, preferring two-character forms
+ *
+ * `c` - First character of the operator
+ * `next_c` - Following character, or '\0' at end of input
+ * `length_out` - Receives 1 or 2
+ *
+ * `TokenSubKind_t` - The operator's sub-kind
  */
-bool c_parser_is_c_keyword(const char* word) {
-    if (!word) return false;
-
-    for (int i = 0; C_KEYWORDS[i]; i++) {
-        if (strcmp(word, C_KEYWORDS[i]) == 0) {
-            return true;
-        }
+static TokenSubKind_t _lex_operator(unsigned char c, unsigned char next_c, int* length_out) {
+    *length_out = 2;
+    switch (c) {
+        case '=': if (next_c == '=') return OP_EQUAL;          *length_out = 1; return OP_ASSIGN;
+        case '!': if (next_c == '=') return OP_NOT_EQUAL;      *length_out = 1; return OP_NOT;
+        case '*': if (next_c == '=') return OP_STAR_ASSIGN;    *length_out = 1; return OP_STAR;
+        case '/': if (next_c == '=') return OP_SLASH_ASSIGN;   *length_out = 1; return OP_SLASH;
+        case '%': if (next_c == '=') return OP_PERCENT_ASSIGN; *length_out = 1; return OP_PERCENT;
+        case '^': if (next_c == '=') return OP_XOR_ASSIGN;     *length_out = 1; return OP_CARET;
+        case '<':
+            if (next_c == '=') return OP_LESS_EQUAL;
+            if (next_c == '<') return OP_SHIFT_LEFT;
+            *length_out = 1; return OP_LESS;
+        case '>':
+            if (next_c == '=') return OP_GREATER_EQUAL;
+            if (next_c == '>') return OP_SHIFT_RIGHT;
+            *length_out = 1; return OP_GREATER;
+        case '&':
+            if (next_c == '=') return OP_AND_ASSIGN;
+            if (next_c == '&') return OP_LOGICAL_AND;
+            *length_out = 1; return OP_AMPERSAND;
+        case '|':
+            if (next_c == '=') return OP_OR_ASSIGN;
+            if (next_c == '|') return OP_LOGICAL_OR;
+            *length_out = 1; return OP_PIPE;
+        case '+':
+            if (next_c == '=') return OP_PLUS_ASSIGN;
+            if (next_c == '+') return OP_INCREMENT;
+            *length_out = 1; return OP_PLUS;
+        case '-':
+            if (next_c == '=') return OP_MINUS_ASSIGN;
+            if (next_c == '-') return OP_DECREMENT;
+            if (next_c == '>') return OP_ARROW;
+            *length_out = 1; return OP_MINUS;
+        case '~': *length_out = 1; return OP_TILDE;
+        case '?': *length_out = 1; return OP_QUESTION;
+        default:  *length_out = 1; return OP_COLON;
     }
-    return false;
 }
 
 /*
- * Check if a function name is dangerous and should be replaced
+ * Identify a single-character punctuator
  */
-bool c_parser_is_dangerous_function(const char* func_name) {
-    if (!func_name) return false;
-
-    for (int i = 0; DANGEROUS_FUNCTIONS[i]; i++) {
-        if (strcmp(func_name, DANGEROUS_FUNCTIONS[i]) == 0) {
-            return true;
-        }
+static TokenSubKind_t _punctuation_sub_kind(unsigned char c) {
+    switch (c) {
+        case '(': return PUNCT_LPAREN;
+        case ')': return PUNCT_RPAREN;
+        case '{': return PUNCT_LBRACE;
+        case '}': return PUNCT_RBRACE;
+        case '[': return PUNCT_LBRACKET;
+        case ']': return PUNCT_RBRACKET;
+        case ';': return PUNCT_SEMICOLON;
+        case ',': return PUNCT_COMMA;
+        default:  return PUNCT_DOT;
     }
-    return false;
 }
 
 /*
- * Check if a word is a standard C type keyword or common type identifier
- *
- * `word` - Word to check (must be null-terminated)
+ * Tokenize C source code into a token store with divine precision
  *
- * `bool` - true if word is a type keyword, false otherwise
- *
- * -- Returns false if word is NULL
- * -- Recognizes primitive types (int, char, float, etc.)
- * -- Includes standard library types (size_t, FILE, etc.)
- * -- Covers fixed-width integer types (uint32_t, int64_t, etc.)
- * -- Used for variable declaration detection and type analysis
+ * A single pass over the source: each token's first byte is classified through
+ * CHAR_CLASS and a switch on that class picks the scanner for the rest of it.
+ * The scanners only move a byte cursor; each token's line comes from walking
+ * the line index forward alongside it, since tokens arrive in source order.
  */
-bool c_parser_is_type_keyword(const char* word) {
-    if (!word) return false;
+static bool tokenize_into_store(const char* content, size_t content_length,
+                                TokenStore_t* store, LineIndex_t* line_index) {
+    ParserContext_t ctx;
+    init_parser_context(&ctx, content, content_length);
+    const unsigned char* src = (const unsigned char*)ctx.source;
 
-    for (int i = 0; TYPE_KEYWORDS[i]; i++) {
-        if (strcmp(word, TYPE_KEYWORDS[i]) == 0) {
-            return true;
+    if (!build_line_index(content, ctx.source_length, line_index)) return false;
+
+    // Reserve for the expected token count up front so big inputs do not double repeatedly
+    if (!reserve_token_store(store, estimate_capacity(content_length, BYTES_PER_TOKEN_ESTIMATE,
+                                                      MIN_TOKEN_CAPACITY))) return false;
+
+    const uint32_t* line_starts = line_index->starts;
+    int line = 1;
+    uint32_t next_line_start = (line_index->count > 1) ? line_starts[1] : UINT32_MAX;
+
+    while (ctx.position < ctx.source_length) {
+        unsigned char c = src[ctx.position];
+        CharClass_t char_class = (CharClass_t)CHAR_CLASS[c];
+
+        // Whitespace only moves the cursor - newlines are already in the line index
+        if (char_class == CHAR_SPACE || char_class == CHAR_NEWLINE) {
+            ctx.position++;
+            continue;
         }
-    }
-    return false;
-}
-/*
- * Helper to tokenize comments (line or block).
- * Returns true if a comment was tokenized, false otherwise.
- */
-static bool _tokenize_comment(ParserContext_t* ctx, ParsedFile_t* parsed, char c, char next_c, int start_line, int start_column, char* buffer, size_t buffer_size) {
-    if (c == '/' && ctx->position + 1 < ctx->source_length) {
-        if (next_c == '/') {
-            // Line comment
-            int length = 0;
-            while (ctx->position < ctx->source_length &&
-                   ctx->source[ctx->position] != '\n' &&
-                   length < (int)(buffer_size - 1)) {
-                buffer[length++] = ctx->source[ctx->position];
-                ctx->position++;
-                ctx->column++;
+
+        ctx.token_start = ctx.position;
+        while (ctx.token_start >= next_line_start) {
+            line++;
+            next_line_start = (line < line_index->count) ? line_starts[line] : UINT32_MAX;
+        }
+        unsigned char next_c = (ctx.position + 1 < ctx.source_length) ? src[ctx.position + 1] : '\0';
+        TokenType_t type;
+        TokenSubKind_t sub_kind = TOKEN_SUB_NONE;
+        int single_length = 0;  // Set for tokens whose length is known up front
+
+        switch (char_class) {
+            case CHAR_IDENT: {
+                CKeywordId_t keyword = _lex_identifier(&ctx);
+                if (keyword != C_KEYWORD_NONE) {
+                    type = TOKEN_KEYWORD;
+                    sub_kind = TOKEN_SUB_FROM_KEYWORD(keyword);
+                } else {
+                    type = TOKEN_IDENTIFIER;
+                }
+                break;
             }
-            buffer[length] = '\0';
-            return add_token(parsed, TOKEN_COMMENT_LINE, buffer, start_line, start_column, length);
-        } else if (next_c == '*') {
-            // Block comment
-            int length = 0;
-            buffer[length++] = ctx->source[ctx->position++];  // '/'
-            buffer[length++] = ctx->source[ctx->position++];  // '*'
-            ctx->column += 2;
-
-            while (ctx->position + 1 < ctx->source_length && length < (int)(buffer_size - 1)) {
-                char c1 = ctx->source[ctx->position];
-                char c2 = ctx->source[ctx->position + 1];
-
-                buffer[length++] = c1;
-                if (c1 == '\n') {
-                    ctx->line++;
-                    ctx->column = 1;
+
+            case CHAR_DIGIT:
+                type = TOKEN_NUMBER;
+                _lex_number(&ctx);
+                break;
+
+            case CHAR_DOT:
+                if (CHAR_CLASS[next_c] == CHAR_DIGIT) {
+                    type = TOKEN_NUMBER;
+                    _lex_number(&ctx);
                 } else {
-                    ctx->column++;
+                    type = TOKEN_PUNCTUATION;
+                    sub_kind = PUNCT_DOT;
+                    single_length = 1;
                 }
-                ctx->position++;
+                break;
 
-                if (c1 == '*' && c2 == '/') {
-                    buffer[length++] = c2;
-                    ctx->position++;
-                    ctx->column++;
-                    break;
+            case CHAR_QUOTE:
+                type = (c == '"') ? TOKEN_STRING : TOKEN_CHAR;
+                _lex_quoted(&ctx);
+                break;
+
+            case CHAR_HASH:
+                type = TOKEN_PREPROCESSOR;
+                _lex_to_end_of_line(&ctx);
+                break;
+
+            case CHAR_SLASH:
+                if (next_c == '/') {
+                    type = TOKEN_COMMENT_LINE;
+                    _lex_to_end_of_line(&ctx);
+                } else if (next_c == '*') {
+                    type = TOKEN_COMMENT_BLOCK;
+                    _lex_block_comment(&ctx);
+                } else {
+                    type = TOKEN_OPERATOR;
+                    sub_kind = _lex_operator(c, next_c, &single_length);
                 }
-            }
-            buffer[length] = '\0';
-            return add_token(parsed, TOKEN_COMMENT_BLOCK, buffer, start_line, start_column, length);
+                break;
+
+            case CHAR_OPERATOR:
+                type = TOKEN_OPERATOR;
+                sub_kind = _lex_operator(c, next_c, &single_length);
+                break;
+
+            case CHAR_PUNCT:
+                type = TOKEN_PUNCTUATION;
+                sub_kind = _punctuation_sub_kind(c);
+                single_length = 1;
+                break;
+
+            default:
+                type = TOKEN_UNKNOWN;
+                single_length = 1;
+                break;
         }
-    }
-    return false;
-}
 
-/*
- * Helper to tokenize preprocessor directives.
- * Returns true if a directive was tokenized, false otherwise.
- */
-static bool _tokenize_preprocessor(ParserContext_t* ctx, ParsedFile_t* parsed, int start_line, int start_column, char* buffer, size_t buffer_size) {
-    if (ctx->source[ctx->position] == '#') {
-        int length = 0;
-        while (ctx->position < ctx->source_length &&
-               ctx->source[ctx->position] != '\n' &&
-               length < (int)(buffer_size - 1)) {
-            buffer[length++] = ctx->source[ctx->position];
-            ctx->position++;
-            ctx->column++;
+        ctx.position += (size_t)single_length;
+
+        int length = (int)(ctx.position - ctx.token_start);
+        if (!add_token(store, type, sub_kind, ctx.token_start, line, length)) {
+            return false;
         }
-        buffer[length] = '\0';
-        return add_token(parsed, TOKEN_PREPROCESSOR, buffer, start_line, start_column, length);
     }
-    return false;
+
+    return true;
 }
 
 /*
- * Helper to tokenize string and character literals.
- * Returns true if a literal was tokenized, false otherwise.
+ * Tokenize C source code into a standalone Token_t array
  */
-static bool _tokenize_string_char_literal(ParserContext_t* ctx, ParsedFile_t* parsed, char c, int start_line, int start_column, char* buffer, size_t buffer_size) {
-    if (c == '"' || c == '\'') {
-        int length = read_string(ctx, buffer, buffer_size);
-        TokenType_t type = (c == '"') ? TOKEN_STRING : TOKEN_CHAR;
-        return add_token(parsed, type, buffer, start_line, start_column, length);
+Token_t* c_parser_tokenize(const char* content, int* token_count) {
+    if (!content || !token_count) return NULL;
+
+    TokenStore_t store = {0};
+    LineIndex_t line_index = {0};
+    Token_t* result = NULL;
+    if (tokenize_into_store(content, strlen(content), &store, &line_index)) {
+        result = token_store_to_array(&store, &line_index);
+        if (result) *token_count = store.count;
     }
-    return false;
+
+    free_token_store(&store);
+    free_line_index(&line_index);
+    return result;
 }
 
+// =============================================================================
+// PUBLIC API IMPLEMENTATION
+// =============================================================================
+
 /*
- * Helper to tokenize number literals.
- * Returns true if a number was tokenized, false otherwise.
+ * Look up the keyword ID of a word with a perfect hash
  */
-static bool _tokenize_number(ParserContext_t* ctx, ParsedFile_t* parsed, char c, char next_c, int start_line, int start_column, char* buffer, size_t buffer_size) {
-    if (isdigit((unsigned char)c) || (c == '.' && ctx->position + 1 < ctx->source_length && isdigit((unsigned char)next_c))) {
-        int length = read_number(ctx, buffer, buffer_size);
-        return add_token(parsed, TOKEN_NUMBER, buffer, start_line, start_column, length);
+CKeywordId_t c_parser_keyword_id(const char* text, size_t length) {
+    if (!text || length < C_KEYWORD_MIN_LENGTH || length > C_KEYWORD_MAX_LENGTH) return C_KEYWORD_NONE;
+
+    uint32_t slot = c_parser_perfect_hash(text, length, C_KEYWORD_HASH_SEED) & C_KEYWORD_HASH_MASK;
+    uint8_t id = C_KEYWORD_HASH_SLOTS[slot];
+    if (id == 0 || C_KEYWORD_LENGTH[id] != length || memcmp(C_KEYWORD_TEXT[id], text, length) != 0) {
+        return C_KEYWORD_NONE;
     }
-    return false;
+    return (CKeywordId_t)id;
 }
 
 /*
- * Helper to tokenize identifiers and keywords.
- * Returns true if an identifier or keyword was tokenized, false otherwise.
+ * Look up the type keyword ID of a word with a perfect hash
  */
-static bool _tokenize_identifier_keyword(ParserContext_t* ctx, ParsedFile_t* parsed, char c, int start_line, int start_column, char* buffer, size_t buffer_size) {
-    if (isalpha((unsigned char)c) || c == '_') {
-        int length = read_identifier(ctx, buffer, buffer_size);
-        TokenType_t type = c_parser_is_c_keyword(buffer) ? TOKEN_KEYWORD : TOKEN_IDENTIFIER;
-        return add_token(parsed, type, buffer, start_line, start_column, length);
+CTypeKeywordId_t c_parser_type_keyword_id(const char* text, size_t length) {
+    if (!text || length < C_TYPE_KEYWORD_MIN_LENGTH || length > C_TYPE_KEYWORD_MAX_LENGTH) return C_TYPE_NONE;
+
+    uint32_t slot = c_parser_perfect_hash(text, length, C_TYPE_KEYWORD_HASH_SEED) & C_TYPE_KEYWORD_HASH_MASK;
+    uint8_t id = C_TYPE_KEYWORD_HASH_SLOTS[slot];
+    if (id == 0 || C_TYPE_KEYWORD_LENGTH[id] != length || memcmp(C_TYPE_KEYWORD_TEXT[id], text, length) != 0) {
+        return C_TYPE_NONE;
     }
-    return false;
+    return (CTypeKeywordId_t)id;
 }
 
 /*
- * Helper to tokenize operators (single or multi-character).
- * Returns true if an operator was tokenized, false otherwise.
+ * Look up the dangerous function ID of a name with a perfect hash
  */
-static bool _tokenize_operator(ParserContext_t* ctx, ParsedFile_t* parsed, int start_line, int start_column, char* buffer, size_t buffer_size) {
-    int op_length = read_operator(ctx, buffer, buffer_size);
-    if (op_length > 0) {
-        return add_token(parsed, TOKEN_OPERATOR, buffer, start_line, start_column, op_length);
+CDangerousFunctionId_t c_parser_dangerous_function_id(const char* text, size_t length) {
+    if (!text || length < C_DANGEROUS_FUNCTION_MIN_LENGTH || length > C_DANGEROUS_FUNCTION_MAX_LENGTH) {
+        return C_DANGEROUS_NONE;
     }
-    return false;
-}
 
-/*
- * Helper to tokenize single-character punctuation.
- * Returns true if punctuation was tokenized, false otherwise.
- */
-static bool _tokenize_punctuation(ParserContext_t* ctx, ParsedFile_t* parsed, char c, int start_line, int start_column, char* buffer) {
-    if (strchr("(){}[];,.", c)) {
-        buffer[0] = c;
-        buffer[1] = '\0';
-        bool success = add_token(parsed, TOKEN_PUNCTUATION, buffer, start_line, start_column, 1);
-        ctx->position++;
-        ctx->column++;
-        return success;
+    uint32_t slot = c_parser_perfect_hash(text, length, C_DANGEROUS_FUNCTION_HASH_SEED) & C_DANGEROUS_FUNCTION_HASH_MASK;
+    uint8_t id = C_DANGEROUS_FUNCTION_HASH_SLOTS[slot];
+    if (id == 0 || C_DANGEROUS_FUNCTION_LENGTH[id] != length ||
+        memcmp(C_DANGEROUS_FUNCTION_TEXT[id], text, length) != 0) {
+        return C_DANGEROUS_NONE;
     }
-    return false;
+    return (CDangerousFunctionId_t)id;
 }
 
 /*
- * Helper to tokenize newline characters.
- * Returns true if a newline was tokenized, false otherwise.
+ * Check if a word is a C keyword
+ * FIXED: Now also checks for 'inline' keyword
  */
-static bool _tokenize_newline(ParserContext_t* ctx, ParsedFile_t* parsed, int start_line, int start_column) {
-    if (ctx->source[ctx->position] == '\n') {
-        bool success = add_token(parsed, TOKEN_NEWLINE, "\\n", start_line, start_column, 1);
-        ctx->position++;
-        ctx->line++;
-        ctx->column = 1;
-        return success;
-    }
-    return false;
+bool c_parser_is_c_keyword(const char* word) {
+    if (!word) return false;
+    return c_parser_keyword_id(word, strlen(word)) != C_KEYWORD_NONE;
 }
 
 /*
- * Helper to tokenize unknown characters.
- * Returns true if an unknown character was tokenized, false otherwise.
+ * Check if a function name is dangerous and should be replaced
  */
-static bool _tokenize_unknown(ParserContext_t* ctx, ParsedFile_t* parsed, char c, int start_line, int start_column, char* buffer) {
-    // This should be the last resort if no other token type matches
-    buffer[0] = c;
-    buffer[1] = '\0';
-    bool success = add_token(parsed, TOKEN_UNKNOWN, buffer, start_line, start_column, 1);
-    ctx->position++;
-    ctx->column++;
-    return success;
+bool c_parser_is_dangerous_function(const char* func_name) {
+    if (!func_name) return false;
+    return c_parser_dangerous_function_id(func_name, strlen(func_name)) != C_DANGEROUS_NONE;
 }
-/*
- * Helper function to attempt to tokenize the next character based on its type.
- * It tries various token types in a specific order of precedence.
- *
- * `ctx` - The parser context.
- * `parsed` - The ParsedFile_t structure to add tokens to.
- * `buffer` - The buffer for token values.
- * `buffer_size` - The size of the buffer.
- *
- * `bool` - True if a token was successfully identified and added, false otherwise.
- */
-static bool _attempt_tokenize_next_token(ParserContext_t* ctx, ParsedFile_t* parsed, char* buffer, size_t buffer_size) {
-    char c = ctx->source[ctx->position];
-    char next_c = (ctx->position + 1 < ctx->source_length) ? ctx->source[ctx->position + 1] : '\0';
-    int start_line = ctx->line;
-    int start_column = ctx->column;
-
-    // Attempt to tokenize various types in order of precedence
-    if (_tokenize_comment(ctx, parsed, c, next_c, start_line, start_column, buffer, buffer_size)) {
-        return true;
-    }
-    if (_tokenize_preprocessor(ctx, parsed, start_line, start_column, buffer, buffer_size)) {
-        return true;
-    }
-    if (_tokenize_string_char_literal(ctx, parsed, c, start_line, start_column, buffer, buffer_size)) {
-        return true;
-    }
-    if (_tokenize_number(ctx, parsed, c, next_c, start_line, start_column, buffer, buffer_size)) {
-        return true;
-    }
-    if (_tokenize_identifier_keyword(ctx, parsed, c, start_line, start_column, buffer, buffer_size)) {
-        return true;
-    }
-    if (_tokenize_newline(ctx, parsed, start_line, start_column)) {
-        return true;
-    }
-    if (_tokenize_operator(ctx, parsed, start_line, start_column, buffer, buffer_size)) {
-        return true;
-    }
-    if (_tokenize_punctuation(ctx, parsed, c, start_line, start_column, buffer)) {
-        return true;
-    }
-    
-    // If none of the above matched, it's an unknown character
-    if (_tokenize_unknown(ctx, parsed, c, start_line, start_column, buffer)) {
-        return true;
-    }
 
-    return false; // No token was recognized or processed
-}
 /*
- * Tokenize C source code with divine precision
- */
-Token_t* c_parser_tokenize(const char* content, int* token_count) {
-    if (!content || !token_count) return NULL;
-
-    ParsedFile_t* temp_parsed = create_parsed_file("temp");
-    if (!temp_parsed) return NULL;
-
-    ParserContext_t ctx;
-    init_parser_context(&ctx, content);
-
-    char buffer[1024];
-
-    while (ctx.position < ctx.source_length) {
-        skip_whitespace(&ctx);
-
-        if (ctx.position >= ctx.source_length) {
-            break; // Reached end of source after skipping whitespace
-        }
-
-        // Attempt to tokenize the next character
-        if (!_attempt_tokenize_next_token(&ctx, temp_parsed, buffer, sizeof(buffer))) {
-            // This case should ideally not be reached if _tokenize_unknown always progresses
-            // but is here as a safety fallback. It implies an unhandled character
-            // that _tokenize_unknown also failed to process (which shouldn't happen).
-            // For now, we'll just advance to prevent infinite loops.
-            ctx.position++;
-            ctx.column++;
-        }
-    }
-
-    // Transfer tokens to return array
-    *token_count = temp_parsed->token_count;
-    Token_t* result = temp_parsed->tokens;
-    temp_parsed->tokens = NULL;  // Prevent cleanup of tokens by temp_parsed
-    c_parser_free_parsed_file(temp_parsed); // Frees temp_parsed but not tokens
-
-    return result;
+ * Check if a word is a standard C type keyword or common type identifier
+ *
+ * `word` - Word to check (must be null-terminated)
+ *
+ * `bool` - true if word is a type keyword, false otherwise
+ *
+ * -- Returns false if word is NULL
+ * -- Recognizes primitive types (int, char, float, etc.)
+ * -- Includes standard library types (size_t, FILE, etc.)
+ * -- Covers fixed-width integer types (uint32_t, int64_t, etc.)
+ * -- Used for variable declaration detection and type analysis
+ */
+bool c_parser_is_type_keyword(const char* word) {
+    if (!word) return false;
+    return c_parser_type_keyword_id(word, strlen(word)) != C_TYPE_NONE;
 }
 
 // =============================================================================
@@ -887,32 +1600,20 @@ Token_t* c_parser_tokenize(const char* content, int* token_count) {
 /*
  * Check if an identifier+parentheses pattern is a function declaration (for headers)
  * FIXED: Now also checks for brace depth to avoid function calls
+ * `brace_depth` is the depth of `{` before `index`, tracked by the caller's sweep
  */
-static bool is_function_declaration(Token_t* tokens, int token_count, int index) {
-    if (index < 0 || index >= token_count) return false;
+static bool is_function_declaration(const TokenStore_t* ts, int index, int brace_depth) {
+    if (index < 0 || index >= ts->count) return false;
 
-    Token_t* current = &tokens[index];
-    if (current->type != TOKEN_IDENTIFIER) return false;
+    if (ts->kinds[index] != TOKEN_IDENTIFIER) return false;
 
     // Must be followed by '('
-    if (index + 1 >= token_count ||
-        tokens[index + 1].type != TOKEN_PUNCTUATION ||
-        strcmp(tokens[index + 1].value, "(") != 0) {
+    if (index + 1 >= ts->count ||
+        ts->kinds[index + 1] != TOKEN_PUNCTUATION ||
+        ts->sub_kinds[index + 1] != PUNCT_LPAREN) {
         return false;
     }
 
-    // Check if we're inside a function body by counting braces
-    int brace_depth = 0;
-    for (int i = 0; i < index; i++) {
-        if (tokens[i].type == TOKEN_PUNCTUATION) {
-            if (strcmp(tokens[i].value, "{") == 0) {
-                brace_depth++;
-            } else if (strcmp(tokens[i].value, "}") == 0) {
-                brace_depth--;
-            }
-        }
-    }
-    
     // If we're inside braces (brace_depth > 0), this is likely a function call
     if (brace_depth > 0) {
         return false;
@@ -924,35 +1625,31 @@ static bool is_function_declaration(Token_t* tokens, int token_count, int index)
 
     // Check for return type before function name
     for (int i = index - 1; i >= 0 && i >= index - 10; i--) {
-        Token_t* prev = &tokens[i];
-        
-        if (prev->type == TOKEN_KEYWORD || prev->type == TOKEN_IDENTIFIER) {
+        if (ts->kinds[i] == TOKEN_KEYWORD || ts->kinds[i] == TOKEN_IDENTIFIER) {
             has_return_type = true;
             break;
-        } else if (prev->type == TOKEN_NEWLINE) {
+        } else if (ts->kinds[i] == TOKEN_NEWLINE) {
             break;
         }
     }
 
     // Look forward to find semicolon (declaration) vs opening brace (definition)
-    for (int i = index + 1; i < token_count && i < index + 100; i++) {
-        Token_t* next = &tokens[i];
-
-        if (next->type == TOKEN_PUNCTUATION) {
-            if (strcmp(next->value, "(") == 0) {
+    for (int i = index + 1; i < ts->count && i < index + 100; i++) {
+        if (ts->kinds[i] == TOKEN_PUNCTUATION) {
+            if (ts->sub_kinds[i] == PUNCT_LPAREN) {
                 paren_depth++;
-            } else if (strcmp(next->value, ")") == 0) {
+            } else if (ts->sub_kinds[i] == PUNCT_RPAREN) {
                 paren_depth--;
                 if (paren_depth == 0) {
                     // Found matching closing paren, look for semicolon
-                    for (int j = i + 1; j < token_count && j < i + 10; j++) {
-                        if (tokens[j].type == TOKEN_PUNCTUATION && strcmp(tokens[j].value, ";") == 0) {
+                    for (int j = i + 1; j < ts->count && j < i + 10; j++) {
+                        if (ts->kinds[j] == TOKEN_PUNCTUATION && ts->sub_kinds[j] == PUNCT_SEMICOLON) {
                             return has_return_type; // It's a declaration
-                        } else if (tokens[j].type == TOKEN_PUNCTUATION && strcmp(tokens[j].value, "{") == 0) {
+                        } else if (ts->kinds[j] == TOKEN_PUNCTUATION && ts->sub_kinds[j] == PUNCT_LBRACE) {
                             return false; // It's a definition
                         }
                         // Skip whitespace/newlines
-                        if (tokens[j].type != TOKEN_NEWLINE && tokens[j].type != TOKEN_COMMENT_LINE) {
+                        if (ts->kinds[j] != TOKEN_NEWLINE && ts->kinds[j] != TOKEN_COMMENT_LINE) {
                             break;
                         }
                     }
@@ -968,35 +1665,24 @@ static bool is_function_declaration(Token_t* tokens, int token_count, int index)
 /*
  * Check if an identifier+parentheses pattern is a function definition vs call
  * FIXED: Now properly distinguishes function definitions from function calls
+ * `brace_depth` is the depth of `{` before `index`, tracked by the caller's sweep
  */
-static bool is_function_definition(Token_t* tokens, int token_count, int index) {
-    if (index < 0 || index >= token_count) return false;
+static bool is_function_definition(const TokenStore_t* ts, int index, int brace_depth) {
+    if (index < 0 || index >= ts->count) return false;
 
-    Token_t* current = &tokens[index];
-    if (current->type != TOKEN_IDENTIFIER) return false;
+    if (ts->kinds[index] != TOKEN_IDENTIFIER) return false;
 
     // Must be followed by '('
-    if (index + 1 >= token_count ||
-        tokens[index + 1].type != TOKEN_PUNCTUATION ||
-        strcmp(tokens[index + 1].value, "(") != 0) {
+    if (index + 1 >= ts->count ||
+        ts->kinds[index + 1] != TOKEN_PUNCTUATION ||
+        ts->sub_kinds[index + 1] != PUNCT_LPAREN) {
         return false;
     }
 
     // Key insight: Function calls are almost always inside braces {}
-    // Check if we're inside a function body by counting braces
-    int brace_depth = 0;
-    for (int i = 0; i < index; i++) {
-        if (tokens[i].type == TOKEN_PUNCTUATION) {
-            if (strcmp(tokens[i].value, "{") == 0) {
-                brace_depth++;
-            } else if (strcmp(tokens[i].value, "}") == 0) {
-                brace_depth--;
-            }
-        }
-    }
     
     // Debug: uncomment for debugging
-    // printf("DEBUG: %s at index %d, brace_depth = %d\n", current->value, index, brace_depth);
+    // printf("DEBUG: %.*s at index %d, brace_depth = %d\n", ts->lengths[index], src + ts->offsets[index], index, brace_depth);
     
     // If we're inside braces (brace_depth > 0), this is likely a function call
     if (brace_depth > 0) {
@@ -1006,25 +1692,25 @@ static bool is_function_definition(Token_t* tokens, int token_count, int index)
     // Look backward for return type (must be on same line or previous line)
     bool has_return_type = false;
     for (int i = index - 1; i >= 0 && i >= index - 10; i--) {
-        Token_t* prev = &tokens[i];
-
         // Stop at certain punctuation that indicates we've gone too far
-        if (prev->type == TOKEN_PUNCTUATION) {
-            if (strcmp(prev->value, ";") == 0 || strcmp(prev->value, "}") == 0) {
+        if (ts->kinds[i] == TOKEN_PUNCTUATION) {
+            if (ts->sub_kinds[i] == PUNCT_SEMICOLON || ts->sub_kinds[i] == PUNCT_RBRACE) {
                 break;
             }
         }
 
         // Check for return type keywords
-        if (prev->type == TOKEN_KEYWORD) {
-            if (strcmp(prev->value, "int") == 0 || strcmp(prev->value, "void") == 0 ||
-                strcmp(prev->value, "char") == 0 || strcmp(prev->value, "bool") == 0 ||
-                strcmp(prev->value, "float") == 0 || strcmp(prev->value, "double") == 0 ||
-                strcmp(prev->value, "static") == 0 || strcmp(prev->value, "inline") == 0) {
-                has_return_type = true;
-                break;
+        if (ts->kinds[i] == TOKEN_KEYWORD) {
+            switch (ts->sub_kinds[i]) {
+                case KW_INT: case KW_VOID: case KW_CHAR: case KW_FLOAT:
+                case KW_DOUBLE: case KW_STATIC: case KW_INLINE:
+                    has_return_type = true;
+                    break;
+                default:
+                    break;
             }
-        } else if (prev->type == TOKEN_IDENTIFIER) {
+            if (has_return_type) break;
+        } else if (ts->kinds[i] == TOKEN_IDENTIFIER) {
             // Custom type name (like ParsedFile_t)
             has_return_type = true;
             break;
@@ -1040,30 +1726,28 @@ static bool is_function_definition(Token_t* tokens, int token_count, int index)
     bool has_opening_brace = false;
     int paren_depth = 0;
 
-    for (int i = index + 1; i < token_count && i < index + 50; i++) {
-        Token_t* next = &tokens[i];
-
-        if (next->type == TOKEN_PUNCTUATION) {
-            if (strcmp(next->value, "(") == 0) {
+    for (int i = index + 1; i < ts->count && i < index + 50; i++) {
+        if (ts->kinds[i] == TOKEN_PUNCTUATION) {
+            if (ts->sub_kinds[i] == PUNCT_LPAREN) {
                 paren_depth++;
-            } else if (strcmp(next->value, ")") == 0) {
+            } else if (ts->sub_kinds[i] == PUNCT_RPAREN) {
                 paren_depth--;
                 if (paren_depth == 0) {
                     // Found matching closing paren, look for opening brace
-                    for (int j = i + 1; j < token_count && j < i + 10; j++) {
-                        if (tokens[j].type == TOKEN_PUNCTUATION) {
-                            if (strcmp(tokens[j].value, "{") == 0) {
+                    for (int j = i + 1; j < ts->count && j < i + 10; j++) {
+                        if (ts->kinds[j] == TOKEN_PUNCTUATION) {
+                            if (ts->sub_kinds[j] == PUNCT_LBRACE) {
                                 has_opening_brace = true;
                                 break;
-                            } else if (strcmp(tokens[j].value, ";") == 0) {
+                            } else if (ts->sub_kinds[j] == PUNCT_SEMICOLON) {
                                 // Function declaration, not definition
                                 return false;
                             }
                         }
                         // Skip whitespace/newlines/comments
-                        if (tokens[j].type != TOKEN_NEWLINE && 
-                            tokens[j].type != TOKEN_COMMENT_LINE &&
-                            tokens[j].type != TOKEN_COMMENT_BLOCK) {
+                        if (ts->kinds[j] != TOKEN_NEWLINE && 
+                            ts->kinds[j] != TOKEN_COMMENT_LINE &&
+                            ts->kinds[j] != TOKEN_COMMENT_BLOCK) {
                             break;
                         }
                     }
@@ -1080,13 +1764,14 @@ static bool is_function_definition(Token_t* tokens, int token_count, int index)
 /*
  * Extract function parameters from tokens
  */
-static void extract_function_parameters(Token_t* tokens, int token_count, int func_index, FunctionInfo_t* func) {
-    if (!tokens || !func) return;
+static void extract_function_parameters(Arena_t* arena, const char* src, const TokenStore_t* ts,
+                                        int func_index, FunctionInfo_t* func) {
+    if (!ts || !func) return;
 
     // Find the opening parenthesis
     int paren_start = -1;
-    for (int i = func_index + 1; i < token_count && i < func_index + 10; i++) {
-        if (tokens[i].type == TOKEN_PUNCTUATION && strcmp(tokens[i].value, "(") == 0) {
+    for (int i = func_index + 1; i < ts->count && i < func_index + 10; i++) {
+        if (ts->kinds[i] == TOKEN_PUNCTUATION && ts->sub_kinds[i] == PUNCT_LPAREN) {
             paren_start = i;
             break;
         }
@@ -1097,11 +1782,11 @@ static void extract_function_parameters(Token_t* tokens, int token_count, int fu
     // Find the matching closing parenthesis
     int paren_depth = 0;
     int paren_end = -1;
-    for (int i = paren_start; i < token_count; i++) {
-        if (tokens[i].type == TOKEN_PUNCTUATION) {
-            if (strcmp(tokens[i].value, "(") == 0) {
+    for (int i = paren_start; i < ts->count; i++) {
+        if (ts->kinds[i] == TOKEN_PUNCTUATION) {
+            if (ts->sub_kinds[i] == PUNCT_LPAREN) {
                 paren_depth++;
-            } else if (strcmp(tokens[i].value, ")") == 0) {
+            } else if (ts->sub_kinds[i] == PUNCT_RPAREN) {
                 paren_depth--;
                 if (paren_depth == 0) {
                     paren_end = i;
@@ -1118,11 +1803,11 @@ static void extract_function_parameters(Token_t* tokens, int token_count, int fu
     bool has_content = false;
     
     for (int i = paren_start + 1; i < paren_end; i++) {
-        if (tokens[i].type == TOKEN_IDENTIFIER || tokens[i].type == TOKEN_KEYWORD) {
+        if (ts->kinds[i] == TOKEN_IDENTIFIER || ts->kinds[i] == TOKEN_KEYWORD) {
             has_content = true;
-        } else if (tokens[i].type == TOKEN_PUNCTUATION && strcmp(tokens[i].value, ",") == 0) {
+        } else if (ts->kinds[i] == TOKEN_PUNCTUATION && ts->sub_kinds[i] == PUNCT_COMMA) {
             param_count++;
-        } else if (tokens[i].type == TOKEN_OPERATOR && strcmp(tokens[i].value, "...") == 0) {
+        } else if (ts->kinds[i] == TOKEN_OPERATOR && ts->lengths[i] == 3 && memcmp(src + ts->offsets[i], "...", 3) == 0) {
             has_content = true; // Variadic function
         }
     }
@@ -1134,7 +1819,7 @@ static void extract_function_parameters(Token_t* tokens, int token_count, int fu
     // Check for void parameter list
     if (param_count == 1) {
         for (int i = paren_start + 1; i < paren_end; i++) {
-            if (tokens[i].type == TOKEN_KEYWORD && strcmp(tokens[i].value, "void") == 0) {
+            if (ts->kinds[i] == TOKEN_KEYWORD && ts->sub_kinds[i] == KW_VOID) {
                 param_count = 0; // void means no parameters
                 break;
             }
@@ -1145,24 +1830,26 @@ static void extract_function_parameters(Token_t* tokens, int token_count, int fu
     
     // Allocate and extract parameter names (simplified)
     if (param_count > 0) {
-        func->parameters = malloc(sizeof(char*) * param_count);
+        func->parameters = c_parser_arena_alloc(arena, sizeof(char*) * param_count);
         if (func->parameters) {
+            memset(func->parameters, 0, sizeof(char*) * param_count);
             int current_param = 0;
             char param_buffer[256] = {0};
             int buffer_pos = 0;
             
             for (int i = paren_start + 1; i < paren_end && current_param < param_count; i++) {
-                if (tokens[i].type == TOKEN_PUNCTUATION && strcmp(tokens[i].value, ",") == 0) {
+                if (ts->kinds[i] == TOKEN_PUNCTUATION && ts->sub_kinds[i] == PUNCT_COMMA) {
                     param_buffer[buffer_pos] = '\0';
-                    func->parameters[current_param] = strdup(param_buffer);
+                    func->parameters[current_param] = c_parser_arena_strdup(arena, param_buffer);
                     current_param++;
                     buffer_pos = 0;
                     memset(param_buffer, 0, sizeof(param_buffer));
-                } else if (tokens[i].type != TOKEN_NEWLINE) {
-                    if (buffer_pos < sizeof(param_buffer) - 2) {
+                } else if (ts->kinds[i] != TOKEN_NEWLINE) {
+                    if (buffer_pos < (int)sizeof(param_buffer) - 2) {
                         if (buffer_pos > 0) param_buffer[buffer_pos++] = ' ';
-                        strncpy(param_buffer + buffer_pos, tokens[i].value, sizeof(param_buffer) - buffer_pos - 1);
-                        buffer_pos += strlen(tokens[i].value);
+                        Token_t token = token_text_view(ts, i);
+                        buffer_pos += (int)c_parser_token_copy_to(src, &token, param_buffer + buffer_pos,
+                                                                  sizeof(param_buffer) - buffer_pos);
                     }
                 }
             }
@@ -1170,7 +1857,7 @@ static void extract_function_parameters(Token_t* tokens, int token_count, int fu
             // Add the last parameter
             if (current_param < param_count && buffer_pos > 0) {
                 param_buffer[buffer_pos] = '\0';
-                func->parameters[current_param] = strdup(param_buffer);
+                func->parameters[current_param] = c_parser_arena_strdup(arena, param_buffer);
             }
         }
     }
@@ -1179,83 +1866,339 @@ static void extract_function_parameters(Token_t* tokens, int token_count, int fu
 /*
  * Extract return type from tokens before function definition
  */
-static char* extract_return_type(Token_t* tokens, int token_count, int func_index) {
+static char* extract_return_type(const char* src, const TokenStore_t* ts, int func_index) {
     char return_type[256] = {0};
+    size_t length = 0;
     int type_parts = 0;
 
     // Look backwards for return type components, but stop at function boundaries
     for (int i = func_index - 1; i >= 0 && i >= func_index - 5; i--) {
-        Token_t* token = &tokens[i];
+        Token_t token = token_text_view(ts, i);
 
         // Stop at punctuation that indicates end of previous function/statement
-        if (token->type == TOKEN_PUNCTUATION) {
-            if (strcmp(token->value, ";") == 0 || strcmp(token->value, "}") == 0 || 
-                strcmp(token->value, ")") == 0) {
+        if (ts->kinds[i] == TOKEN_PUNCTUATION) {
+            if (ts->sub_kinds[i] == PUNCT_SEMICOLON || ts->sub_kinds[i] == PUNCT_RBRACE || 
+                ts->sub_kinds[i] == PUNCT_RPAREN) {
                 break; // Hit end of previous function or statement
-            } else if (strcmp(token->value, "*") == 0) {
+            } else if (ts->sub_kinds[i] == OP_STAR && length + 1 < sizeof(return_type)) {
                 // Handle pointer indicators
-                char temp[256];
-                snprintf(temp, sizeof(temp), "%s*", return_type);
-                strncpy(return_type, temp, sizeof(return_type) - 1);
+                return_type[length++] = '*';
+                return_type[length] = '\0';
             }
-        } else if (token->type == TOKEN_KEYWORD || token->type == TOKEN_IDENTIFIER) {
+        } else if (ts->kinds[i] == TOKEN_KEYWORD || ts->kinds[i] == TOKEN_IDENTIFIER) {
             // Only accept type keywords, not random identifiers
-            if (token->type == TOKEN_KEYWORD || 
-                (token->type == TOKEN_IDENTIFIER && strstr(token->value, "_t"))) {
-                // Build return type string (in reverse order, so we'll fix it)
-                if (type_parts == 0) {
-                    strncpy(return_type, token->value, sizeof(return_type) - 1);
-                } else {
-                    char temp[256];
-                    snprintf(temp, sizeof(temp), "%s %s", token->value, return_type);
-                    strncpy(return_type, temp, sizeof(return_type) - 1);
-                }
+            if (ts->kinds[i] == TOKEN_KEYWORD || 
+                (ts->kinds[i] == TOKEN_IDENTIFIER && c_parser_token_contains(src, &token, "_t"))) {
+                // Tokens arrive in reverse order, so each one is prepended with a separating space
+                size_t token_length = (size_t)token.length;
+                size_t separator = length > 0 ? 1 : 0;
+                if (token_length + separator + length >= sizeof(return_type)) break;
+
+                memmove(return_type + token_length + separator, return_type, length + 1);
+                memcpy(return_type, c_parser_token_text(src, &token), token_length);
+                if (separator) return_type[token_length] = ' ';
+                length += token_length + separator;
                 type_parts++;
 
                 // Stop after getting one main type part for simplicity
                 if (type_parts >= 1) break;
             }
-        } else if (token->type == TOKEN_NEWLINE || token->type == TOKEN_COMMENT_LINE) {
-            break;  // Stop at line boundaries
-        } else if (token->type == TOKEN_COMMENT_BLOCK) {
+        } else if (ts->kinds[i] == TOKEN_COMMENT_LINE) {
+            break;  // Stop at line comments
+        } else if (ts->kinds[i] == TOKEN_COMMENT_BLOCK) {
             // Skip comment blocks, don't stop the search
             continue;
         }
     }
 
-    return strdup(strlen(return_type) > 0 ? return_type : "unknown");
+    return strdup(length > 0 ? return_type : "unknown");
 }
 
+// =============================================================================
+// CALL SITE TABLE
+// =============================================================================
+
+// Bracket-stack entries for openers that do not start a call; a call's '(' pushes its index
+#define CALL_STACK_GROUP   -1   // '(' of a grouping, cast or declarator
+#define CALL_STACK_BRACKET -2   // '['
+#define CALL_STACK_BRACE   -3   // '{'
+
 /*
- * Parse C source code into structured format with divine understanding
+ * Scratch state for building the call table during the parse sweep
  */
-ParsedFile_t* c_parser_parse_content(const char* content, const char* file_path) {
-    if (!content) return NULL;
+typedef struct {
+    int* stack;             // Open brackets, innermost last
+    int depth;
+    int stack_capacity;
+    int* comma_calls;       // Call owning each top-level argument comma
+    int* comma_tokens;      // Token index of each such comma
+    int comma_count;
+    int comma_capacity;
+    int call_capacity;
+    int pending_call;       // Call whose '(' is the next token, or -1
+} CallScan_t;
 
-    ParsedFile_t* parsed = create_parsed_file(file_path);
-    if (!parsed) return NULL;
+/*
+ * Grow an int array to hold at least `count` items
+ */
+static bool reserve_ints(int** items, int* capacity, int count) {
+    if (count <= *capacity) return true;
 
-    // First tokenize the content
-    int token_count;
-    Token_t* tokens = c_parser_tokenize(content, &token_count);
-    if (!tokens) {
-        c_parser_free_parsed_file(parsed);
+    int new_capacity = *capacity ? *capacity * 2 : 16;
+    while (new_capacity < count) new_capacity *= 2;
+    int* grown = realloc(*items, sizeof(int) * (size_t)new_capacity);
+    if (!grown) return false;
+
+    *items = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/*
+ * Record a call whose callee is token `token_index`; its '(' is the next token
+ */
+static bool add_call_site(ParsedFile_t* parsed, CallScan_t* scan, int token_index, int function_index) {
+    if (parsed->call_count >= scan->call_capacity) {
+        int capacity = scan->call_capacity ? scan->call_capacity * 2 : 64;
+        CallSite_t* calls = realloc(parsed->calls, sizeof(CallSite_t) * (size_t)capacity);
+        if (!calls) return false;
+        parsed->calls = calls;
+        scan->call_capacity = capacity;
+    }
+
+    const TokenStore_t* ts = &parsed->token_store;
+    CallSite_t* call = &parsed->calls[parsed->call_count];
+    call->token_index = token_index;
+    call->close_paren = -1;
+    call->function_index = function_index;
+    call->first_arg = 0;
+    call->arg_count = 0;
+    call->dangerous_id = c_parser_dangerous_function_id(parsed->source + ts->offsets[token_index],
+                                                        (size_t)ts->lengths[token_index]);
+
+    scan->pending_call = parsed->call_count++;
+    return true;
+}
+
+/*
+ * Track brackets and argument commas for the call table - called for every punctuation token
+ */
+static bool call_scan_punctuation(ParsedFile_t* parsed, CallScan_t* scan, int i) {
+    int pending = scan->pending_call;
+    scan->pending_call = -1;
+
+    int top = scan->depth > 0 ? scan->stack[scan->depth - 1] : CALL_STACK_BRACE;
+    switch (parsed->token_store.sub_kinds[i]) {
+        case PUNCT_LPAREN:
+        case PUNCT_LBRACKET:
+        case PUNCT_LBRACE: {
+            if (!reserve_ints(&scan->stack, &scan->stack_capacity, scan->depth + 1)) return false;
+            int entry = CALL_STACK_BRACE;
+            if (parsed->token_store.sub_kinds[i] == PUNCT_LPAREN) {
+                entry = pending >= 0 ? pending : CALL_STACK_GROUP;
+            } else if (parsed->token_store.sub_kinds[i] == PUNCT_LBRACKET) {
+                entry = CALL_STACK_BRACKET;
+            }
+            scan->stack[scan->depth++] = entry;
+            break;
+        }
+        case PUNCT_RPAREN:
+            if (scan->depth > 0 && top >= CALL_STACK_GROUP) {
+                scan->depth--;
+                if (top >= 0) parsed->calls[top].close_paren = i;
+            }
+            break;
+        case PUNCT_RBRACKET:
+            if (scan->depth > 0 && top == CALL_STACK_BRACKET) scan->depth--;
+            break;
+        case PUNCT_RBRACE:
+            // Resynchronize on blocks: anything left open inside them stays unclosed
+            while (scan->depth > 0 && scan->stack[--scan->depth] != CALL_STACK_BRACE) {}
+            break;
+        case PUNCT_COMMA:
+            if (scan->depth > 0 && top >= 0) {
+                int count = scan->comma_count + 1;
+                int capacity = scan->comma_capacity;
+                if (!reserve_ints(&scan->comma_calls, &capacity, count) ||
+                    !reserve_ints(&scan->comma_tokens, &scan->comma_capacity, count)) {
+                    return false;
+                }
+                scan->comma_calls[scan->comma_count] = top;
+                scan->comma_tokens[scan->comma_count] = i;
+                scan->comma_count++;
+            }
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+/*
+ * Turn the commas collected during the sweep into contiguous argument ranges per call
+ */
+static bool finish_call_table(ParsedFile_t* parsed, CallScan_t* scan) {
+    CallSite_t* calls = parsed->calls;
+
+    // Each closed call has one more argument than it has top-level commas, unless it is `f()`
+    for (int c = 0; c < scan->comma_count; c++) {
+        calls[scan->comma_calls[c]].arg_count++;
+    }
+    int total = 0;
+    for (int c = 0; c < parsed->call_count; c++) {
+        CallSite_t* call = &calls[c];
+        if (call->close_paren < 0) {
+            call->arg_count = 0;
+        } else if (call->close_paren > call->token_index + 2 || call->arg_count > 0) {
+            call->arg_count++;
+        }
+        call->first_arg = total;
+        total += call->arg_count;
+    }
+
+    parsed->call_args = total > 0 ? malloc(sizeof(CallArgRange_t) * (size_t)total) : NULL;
+    if (total > 0 && !parsed->call_args) return false;
+    parsed->call_arg_count = total;
+
+    // Commas arrive in token order, so each call's ranges fill left to right
+    int* next_arg = malloc(sizeof(int) * (size_t)(parsed->call_count + 1));
+    if (!next_arg) return false;
+    for (int c = 0; c < parsed->call_count; c++) {
+        CallSite_t* call = &calls[c];
+        next_arg[c] = call->first_arg;
+        if (call->arg_count > 0) {
+            parsed->call_args[call->first_arg].start = call->token_index + 2;
+            parsed->call_args[call->first_arg + call->arg_count - 1].end = call->close_paren;
+        }
+    }
+    for (int c = 0; c < scan->comma_count; c++) {
+        CallSite_t* call = &calls[scan->comma_calls[c]];
+        if (call->close_paren < 0) continue;
+
+        int arg = next_arg[scan->comma_calls[c]]++;
+        parsed->call_args[arg].end = scan->comma_tokens[c];
+        parsed->call_args[arg + 1].start = scan->comma_tokens[c] + 1;
+    }
+
+    free(next_arg);
+    return true;
+}
+
+/*
+ * Release the scratch state of a call scan
+ */
+static void free_call_scan(CallScan_t* scan) {
+    free(scan->stack);
+    free(scan->comma_calls);
+    free(scan->comma_tokens);
+    memset(scan, 0, sizeof(*scan));
+}
+
+// =============================================================================
+// FUNCTION NAME INDEX
+// =============================================================================
+
+/*
+ * Hash a function's name atom for the name index
+ */
+static uint32_t function_atom_hash(Atom_t atom) {
+    uint32_t hash = atom * 2654435761u;
+    return hash ^ (hash >> 16);
+}
+
+/*
+ * Build the open-addressed name index once every function has been recorded
+ *
+ * Only the first function with each name is indexed, so lookups keep
+ * returning what a front-to-back scan of `functions` would.
+ */
+static bool build_function_index(ParsedFile_t* parsed) {
+    if (parsed->function_count == 0) return true;
+
+    // A name that could not be interned leaves lookups to the linear scan
+    for (int i = 0; i < parsed->function_count; i++) {
+        if (parsed->functions[i].name_atom == ATOM_NONE) return true;
+    }
+
+    // At most half full keeps probe runs short
+    size_t size = 16;
+    while (size < (size_t)parsed->function_count * 2) size <<= 1;
+
+    int* slots = calloc(size, sizeof(int));
+    if (!slots) return false;
+    uint32_t mask = (uint32_t)(size - 1);
+
+    for (int i = 0; i < parsed->function_count; i++) {
+        Atom_t atom = parsed->functions[i].name_atom;
+        uint32_t slot = function_atom_hash(atom) & mask;
+        while (slots[slot] != 0 && parsed->functions[slots[slot] - 1].name_atom != atom) {
+            slot = (slot + 1) & mask;
+        }
+        if (slots[slot] == 0) slots[slot] = i + 1;
+    }
+
+    parsed->function_index = slots;
+    parsed->function_index_mask = mask;
+    return true;
+}
+
+/*
+ * Parse an opened source input - the returned structure takes ownership of its buffer
+ */
+ParsedFile_t* c_parser_parse_input(SourceInput_t* input, const char* file_path) {
+    if (!input || !input->data) return NULL;
+
+    // Move the buffer out so the caller's copy is inert whatever happens next
+    SourceInput_t owned = *input;
+    memset(input, 0, sizeof(*input));
+
+    ParsedFile_t* parsed = create_parsed_file(file_path, owned.length);
+    if (!parsed) {
+        c_parser_input_close(&owned);
         return NULL;
     }
 
-    // Copy tokens to parsed structure
-    parsed->tokens = tokens;
-    parsed->token_count = token_count;
-    parsed->token_capacity = token_count;  // Exact fit
+    parsed->input = owned;
+    parsed->source = owned.data;
+    parsed->source_length = owned.length;
+    const char* source = parsed->source;
+
+    // First tokenize the content straight into the parsed file's token store
+    TokenStore_t* ts = &parsed->token_store;
+    if (!tokenize_into_store(source, parsed->source_length, ts, &parsed->line_index)) {
+        c_parser_free_parsed_file(parsed);
+        return NULL;
+    }
+    parsed->token_count = ts->count;
 
-    // Parse high-level structures
-    for (int i = 0; i < token_count; i++) {
-        Token_t* token = &tokens[i];
+    // Parse high-level structures in a single sweep, tracking brace depth as we go
+    // so classifying each `identifier (` candidate never rescans earlier tokens.
+    // Every other `identifier (` is a call and goes into the call table.
+    int brace_depth = 0;
+    int pending_definition = -1;    // Definition whose body '{' has not been seen yet
+    int open_definition = -1;       // Definition whose body encloses the current token
+    int last_block_comment = -1;    // First block comment on the latest line that has one
+    int prior_block_comment = -1;   // The same for the line before that one
+    CallScan_t scan = { .pending_call = -1 };
+    scan.call_capacity = estimate_capacity(parsed->source_length, BYTES_PER_CALL_ESTIMATE, MIN_CALL_CAPACITY);
+    parsed->calls = malloc(sizeof(CallSite_t) * (size_t)scan.call_capacity);
+    bool calls_ok = parsed->calls != NULL;
+    for (int i = 0; i < ts->count; i++) {
+
+        // Remember the nearest comments above so each function can link its docs
+        if (ts->kinds[i] == TOKEN_COMMENT_BLOCK &&
+            (last_block_comment < 0 || ts->lines[last_block_comment] != ts->lines[i])) {
+            prior_block_comment = last_block_comment;
+            last_block_comment = i;
+        }
 
         // Parse include directives
-        if (token->type == TOKEN_PREPROCESSOR && strstr(token->value, "#include")) {
-            char* include_start = strchr(token->value, '<');
-            if (!include_start) include_start = strchr(token->value, '"');
+        if (ts->kinds[i] == TOKEN_PREPROCESSOR && store_token_contains(source, ts, i, "#include")) {
+            char directive[512];
+            store_token_copy_to(source, ts, i, directive, sizeof(directive));
+
+            char* include_start = strchr(directive, '<');
+            if (!include_start) include_start = strchr(directive, '"');
             if (include_start) {
                 char include_name[256];
                 char end_char = (*include_start == '<') ? '>' : '"';
@@ -1274,81 +2217,528 @@ ParsedFile_t* c_parser_parse_content(const char* content, const char* file_path)
         }
 
         // Parse function definitions and declarations
-        if (token->type == TOKEN_IDENTIFIER && i + 1 < token_count) {
-            Token_t* next = &tokens[i + 1];
-            if (next->type == TOKEN_PUNCTUATION && strcmp(next->value, "(") == 0) {
-                bool is_definition = is_function_definition(tokens, token_count, i);
-                bool is_declaration = is_function_declaration(tokens, token_count, i);
+        if (ts->kinds[i] == TOKEN_IDENTIFIER && i + 1 < ts->count) {
+            if (ts->kinds[i + 1] == TOKEN_PUNCTUATION && ts->sub_kinds[i + 1] == PUNCT_LPAREN) {
+                bool is_definition = is_function_definition(ts, i, brace_depth);
+                bool is_declaration = is_function_declaration(ts, i, brace_depth);
                 
                 if (is_definition || is_declaration) {
-                    char* return_type = extract_return_type(tokens, token_count, i);
+                    char func_name[256];
+                    store_token_copy_to(source, ts, i, func_name, sizeof(func_name));
+
+                    char* return_type = extract_return_type(source, ts, i);
                     bool is_static = false;
                     bool is_inline = false;
 
-                    // Check for static/inline modifiers
-                    for (int j = i - 1; j >= 0 && j >= i - 5; j--) {
-                        if (tokens[j].type == TOKEN_KEYWORD) {
-                            if (strcmp(tokens[j].value, "static") == 0) is_static = true;
-                            if (strcmp(tokens[j].value, "inline") == 0) is_inline = true;
-                        }
-                    }
+                    // Check for static/inline modifiers
+                    for (int j = i - 1; j >= 0 && j >= i - 5; j--) {
+                        if (ts->kinds[j] == TOKEN_KEYWORD) {
+                            if (ts->sub_kinds[j] == KW_STATIC) is_static = true;
+                            if (ts->sub_kinds[j] == KW_INLINE) is_inline = true;
+                        }
+                    }
+
+                    bool added = add_function(parsed, func_name, return_type,
+                               ts->lines[i], token_column(ts, &parsed->line_index, i), is_static, is_inline);
+                    
+                    // Extract parameters for the just-added function
+                    if (parsed->function_count > 0) {
+                        FunctionInfo_t* func = &parsed->functions[parsed->function_count - 1];
+                        extract_function_parameters(&parsed->arena, source, ts, i, func);
+                    }
+                    if (added) {
+                        // A comment on the function's own line sits beside it, not above it
+                        int doc_comment = last_block_comment;
+                        if (doc_comment >= 0 && ts->lines[doc_comment] >= ts->lines[i]) {
+                            doc_comment = prior_block_comment;
+                        }
+                        link_function_documentation(parsed, &parsed->functions[parsed->function_count - 1],
+                                                    doc_comment);
+                    }
+                    if (added && is_definition) {
+                        pending_definition = parsed->function_count - 1;
+                    }
+                    
+                    free(return_type);
+                } else if (calls_ok) {
+                    calls_ok = add_call_site(parsed, &scan, i, open_definition);
+                }
+            }
+        }
+
+        // Update depth after classification so it always reflects tokens before `i`
+        if (ts->kinds[i] == TOKEN_PUNCTUATION) {
+            if (calls_ok) {
+                calls_ok = call_scan_punctuation(parsed, &scan, i);
+            }
+
+            if (ts->sub_kinds[i] == PUNCT_LBRACE) {
+                if (brace_depth == 0) {
+                    open_definition = pending_definition;
+                    pending_definition = -1;
+                    if (open_definition >= 0) parsed->functions[open_definition].body_start = i;
+                }
+                brace_depth++;
+            } else if (ts->sub_kinds[i] == PUNCT_RBRACE) {
+                brace_depth--;
+                if (brace_depth <= 0) {
+                    if (open_definition >= 0) parsed->functions[open_definition].body_end = i;
+                    open_definition = -1;
+                }
+            } else if (ts->sub_kinds[i] == PUNCT_SEMICOLON && brace_depth == 0) {
+                pending_definition = -1;
+            }
+        }
+    }
+
+    calls_ok = calls_ok && finish_call_table(parsed, &scan);
+    free_call_scan(&scan);
+    if (!calls_ok || !build_function_index(parsed)) {
+        c_parser_free_parsed_file(parsed);
+        return NULL;
+    }
+
+    return parsed;
+}
+
+/*
+ * Parse C source code into structured format with divine understanding
+ */
+ParsedFile_t* c_parser_parse_content(const char* content, const char* file_path) {
+    if (!content) return NULL;
+
+    // The parsed file owns a single copy of the content; every token is a view into it
+    size_t source_length = strlen(content);
+    char* source = malloc(source_length + 1);
+    if (!source) return NULL;
+    memcpy(source, content, source_length + 1);
+
+    SourceInput_t input = { .data = source, .length = source_length };
+    return c_parser_parse_input(&input, file_path);
+}
+
+/*
+ * Parse a C file from disk with divine file handling
+ */
+ParsedFile_t* c_parser_parse_file(const char* file_path) {
+    SourceInput_t input;
+    if (!c_parser_input_open(file_path, &input)) return NULL;
+
+    if (input.length == 0) {
+        c_parser_input_close(&input);
+        return NULL;
+    }
+
+    // Tokens become views straight into the mapping - no copy of the file is made
+    return c_parser_parse_input(&input, file_path);
+}
+
+// =============================================================================
+// SOURCE INPUT
+// =============================================================================
+
+/*
+ * Read a descriptor to EOF into a null-terminated heap buffer
+ */
+static bool read_input_fd(int fd, size_t size_hint, SourceInput_t* input) {
+    size_t capacity = size_hint + 1;
+    if (capacity < 4096) capacity = 4096;
+
+    char* buffer = malloc(capacity);
+    if (!buffer) return false;
+
+    size_t used = 0;
+    for (;;) {
+        if (used + 1 == capacity) {
+            char* grown = realloc(buffer, capacity * 2);
+            if (!grown) {
+                free(buffer);
+                return false;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
+
+        ssize_t bytes_read = read(fd, buffer + used, capacity - used - 1);
+        if (bytes_read < 0) {
+            if (errno == EINTR) continue;
+            free(buffer);
+            return false;
+        }
+        if (bytes_read == 0) break;
+        used += (size_t)bytes_read;
+    }
+    buffer[used] = '\0';
+
+    input->data = buffer;
+    input->length = strlen(buffer);
+    input->mapping = NULL;
+    input->mapping_length = 0;
+    return true;
+}
+
+/*
+ * Open a source file relative to `dir_fd`, mapping it only when `allow_mapping` is set
+ *
+ * A mapping faults with SIGBUS if the file is truncated while it is read, so
+ * parses kept around indefinitely take a private copy instead.
+ */
+static bool open_source_input(int dir_fd, const char* file_path, SourceInput_t* input, bool allow_mapping) {
+    if (!input) return false;
+    memset(input, 0, sizeof(*input));
+    if (!file_path) return false;
+
+    int fd = openat(dir_fd, file_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || S_ISDIR(st.st_mode)) {
+        close(fd);
+        return false;
+    }
+
+    bool is_regular = S_ISREG(st.st_mode);
+    size_t size = is_regular ? (size_t)st.st_size : 0;
+    long page_size = sysconf(_SC_PAGESIZE);
+    bool opened = false;
+
+    // Only map when the zero-filled tail of the last page can serve as the '\0' sentinel
+    if (allow_mapping && is_regular && size > 0 && page_size > 0 && size % (size_t)page_size != 0) {
+        void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            posix_madvise(mapping, size, POSIX_MADV_SEQUENTIAL);
+            input->data = mapping;
+            input->length = strnlen(mapping, size);
+            input->mapping = mapping;
+            input->mapping_length = size;
+            opened = true;
+        }
+    }
+
+    if (!opened) {
+        opened = read_input_fd(fd, size, input);
+    }
+
+    close(fd);
+    return opened;
+}
+
+/*
+ * Open a source file as a read-only, null-terminated buffer
+ */
+bool c_parser_input_open(const char* file_path, SourceInput_t* input) {
+    return open_source_input(AT_FDCWD, file_path, input, true);
+}
+
+/*
+ * Open a source file relative to an open directory
+ */
+bool c_parser_input_open_at(int dir_fd, const char* file_name, SourceInput_t* input) {
+    return open_source_input(dir_fd, file_name, input, true);
+}
+
+/*
+ * Release a source input's mapping or heap buffer
+ */
+void c_parser_input_close(SourceInput_t* input) {
+    if (!input) return;
+
+    if (input->mapping) {
+        munmap(input->mapping, input->mapping_length);
+    } else {
+        free((void*)input->data);
+    }
+    memset(input, 0, sizeof(*input));
+}
+
+// =============================================================================
+// PARSE CACHE
+// =============================================================================
+
+#define PARSE_CACHE_BUCKETS 1024    // Power of two; chains stay short for any real tree
+
+/*
+ * One file's shared parse, keyed by canonical path and stat identity
+ */
+typedef struct ParseCacheEntry {
+    char* canonical_path;
+    uint32_t hash;                  // Hash of canonical_path
+    dev_t device;
+    ino_t inode;
+    off_t size;
+    struct timespec mtime;
+    ParsedFile_t* parsed;           // Shared parse, NULL if the file failed to load
+    bool loading;                   // Still being parsed by the thread that created it
+    bool cached;                    // Still linked into a bucket
+    bool evict_when_unused;         // Drop from the cache once no handle remains
+    int references;                 // Handles and in-flight acquires, plus one while cached
+    struct ParseCacheEntry* next;   // Bucket chain
+} ParseCacheEntry_t;
+
+static pthread_mutex_t parse_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t parse_cache_loaded = PTHREAD_COND_INITIALIZER;
+static int parse_cache_runs = 0;
+static bool parse_cache_resident = false;  // Keep sources as well as headers, read rather than mapped
+static ParseCacheEntry_t* parse_cache_buckets[PARSE_CACHE_BUCKETS];
+
+/*
+ * Read and parse a file, then resolve its lazily computed state
+ *
+ * Queries build the token view on first use; doing that here makes every
+ * later query read-only, so the parse can be shared. `resident` parses may
+ * outlive any edit to the file, so they copy it instead of mapping it.
+ */
+static ParsedFile_t* load_shareable_file(const char* file_path, bool resident) {
+    SourceInput_t input;
+    if (!open_source_input(AT_FDCWD, file_path, &input, !resident)) return NULL;
+
+    ParsedFile_t* parsed = c_parser_parse_input(&input, file_path);
+    if (!parsed) return NULL;
+
+    c_parser_tokens(parsed);
+    return parsed;
+}
+
+/*
+ * Free a cache entry and the parse it owns
+ */
+static void free_cache_entry(ParseCacheEntry_t* entry) {
+    if (entry->parsed) {
+        entry->parsed->cache_entry = NULL;
+        c_parser_free_parsed_file(entry->parsed);
+    }
+    free(entry->canonical_path);
+    free(entry);
+}
+
+/*
+ * Unlink a cached entry from its bucket - caller holds parse_cache_lock
+ */
+static void unlink_cache_entry(ParseCacheEntry_t* entry) {
+    ParseCacheEntry_t** link = &parse_cache_buckets[entry->hash & (PARSE_CACHE_BUCKETS - 1)];
+    while (*link && *link != entry) link = &(*link)->next;
+    if (*link) *link = entry->next;
+    entry->next = NULL;
+    entry->cached = false;
+}
+
+/*
+ * Drop one reference to an entry, freeing it if that was the last
+ */
+static void drop_cache_reference(ParseCacheEntry_t* entry) {
+    pthread_mutex_lock(&parse_cache_lock);
+    bool last = --entry->references == 0;
+
+    // Only the cache's own reference is left: free it now, on this thread, rather than at run end
+    if (!last && entry->references == 1 && entry->cached && entry->evict_when_unused) {
+        unlink_cache_entry(entry);
+        entry->references = 0;
+        last = true;
+    }
+    pthread_mutex_unlock(&parse_cache_lock);
+
+    if (last) free_cache_entry(entry);
+}
+
+/*
+ * Make a caller's handle: a shallow copy of the shared parse under the caller's own path
+ */
+static ParsedFile_t* make_cache_handle(ParseCacheEntry_t* entry, const char* file_path) {
+    ParsedFile_t* handle = malloc(sizeof(ParsedFile_t));
+    if (!handle) return NULL;
+
+    *handle = *entry->parsed;
+    handle->file_path = strdup(file_path);
+    if (!handle->file_path) {
+        free(handle);
+        return NULL;
+    }
+    handle->cache_entry = entry;
+    return handle;
+}
+
+/*
+ * Start a run-scoped parse cache
+ */
+void c_parser_cache_begin(void) {
+    pthread_mutex_lock(&parse_cache_lock);
+    parse_cache_runs++;
+    pthread_mutex_unlock(&parse_cache_lock);
+}
 
-                    add_function(parsed, token->value, return_type,
-                               token->line, token->column, is_static, is_inline);
-                    
-                    // Extract parameters for the just-added function
-                    if (parsed->function_count > 0) {
-                        FunctionInfo_t* func = &parsed->functions[parsed->function_count - 1];
-                        extract_function_parameters(tokens, token_count, i, func);
-                    }
-                    
-                    // Immediately check for documentation after adding the function
-                    c_parser_has_documentation_for_function(parsed, token->value);
-                    
-                    free(return_type);
+/*
+ * End a run started with c_parser_cache_begin()
+ */
+void c_parser_cache_end(void) {
+    ParseCacheEntry_t* retired = NULL;
+
+    pthread_mutex_lock(&parse_cache_lock);
+    if (parse_cache_runs > 0 && --parse_cache_runs == 0) {
+        // Entries still referenced by a handle live on, detached, until it is released
+        for (int b = 0; b < PARSE_CACHE_BUCKETS; b++) {
+            ParseCacheEntry_t* entry = parse_cache_buckets[b];
+            while (entry) {
+                ParseCacheEntry_t* next = entry->next;
+                entry->cached = false;
+                if (--entry->references == 0) {
+                    entry->next = retired;
+                    retired = entry;
                 }
+                entry = next;
             }
+            parse_cache_buckets[b] = NULL;
         }
     }
+    pthread_mutex_unlock(&parse_cache_lock);
 
-    return parsed;
+    while (retired) {
+        ParseCacheEntry_t* next = retired->next;
+        free_cache_entry(retired);
+        retired = next;
+    }
+
+    // Whatever the run interned goes once the parses using it do
+    retire_atom_table();
 }
 
 /*
- * Parse a C file from disk with divine file handling
+ * Keep every file, not just headers, cached until the outermost run ends
  */
-ParsedFile_t* c_parser_parse_file(const char* file_path) {
+void c_parser_cache_set_resident(bool resident) {
+    pthread_mutex_lock(&parse_cache_lock);
+    parse_cache_resident = resident;
+    pthread_mutex_unlock(&parse_cache_lock);
+}
+
+/*
+ * Get the parsed form of a file, parsing it only on first use within a run
+ */
+ParsedFile_t* c_parser_acquire_file(const char* file_path) {
     if (!file_path) return NULL;
 
-    FILE* file = fopen(file_path, "r");
-    if (!file) return NULL;
+    char* canonical_path = realpath(file_path, NULL);
+    struct stat st;
+    if (!canonical_path || stat(canonical_path, &st) != 0) {
+        free(canonical_path);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&parse_cache_lock);
+    if (parse_cache_runs == 0) {
+        pthread_mutex_unlock(&parse_cache_lock);
+        free(canonical_path);
+        return load_shareable_file(file_path, false);
+    }
 
-    // Get file size
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
+    size_t path_length = strlen(canonical_path);
+    uint32_t hash = c_parser_perfect_hash(canonical_path, path_length, 0);
+    ParseCacheEntry_t** bucket = &parse_cache_buckets[hash & (PARSE_CACHE_BUCKETS - 1)];
 
-    if (file_size <= 0) {
-        fclose(file);
-        return NULL;
+    ParseCacheEntry_t* entry = *bucket;
+    while (entry && !(entry->hash == hash &&
+                      entry->device == st.st_dev && entry->inode == st.st_ino &&
+                      entry->size == st.st_size &&
+                      entry->mtime.tv_sec == st.st_mtim.tv_sec &&
+                      entry->mtime.tv_nsec == st.st_mtim.tv_nsec &&
+                      strcmp(entry->canonical_path, canonical_path) == 0)) {
+        entry = entry->next;
+    }
+
+    if (entry) {
+        // Hold a reference while waiting so the entry cannot be retired underneath us
+        free(canonical_path);
+        entry->references++;
+        while (entry->loading) {
+            pthread_cond_wait(&parse_cache_loaded, &parse_cache_lock);
+        }
+    } else {
+        entry = calloc(1, sizeof(ParseCacheEntry_t));
+        if (!entry) {
+            pthread_mutex_unlock(&parse_cache_lock);
+            free(canonical_path);
+            return load_shareable_file(file_path, false);
+        }
+        entry->canonical_path = canonical_path;
+        entry->hash = hash;
+        entry->device = st.st_dev;
+        entry->inode = st.st_ino;
+        entry->size = st.st_size;
+        entry->mtime = st.st_mtim;
+        entry->loading = true;
+        entry->cached = true;
+        entry->references = 2;  // The cache's own, plus ours
+
+        // Headers are read again by every file that includes them; sources by their own analysis only
+        entry->evict_when_unused = !parse_cache_resident &&
+                                   !(path_length > 2 && strcmp(canonical_path + path_length - 2, ".h") == 0);
+
+        // Older versions of the file can never be asked for again: drop the cache's hold on them,
+        // so a long run (a server) keeps one parse per header however often it is edited
+        ParseCacheEntry_t* superseded = NULL;
+        for (ParseCacheEntry_t** link = bucket; *link; ) {
+            ParseCacheEntry_t* old = *link;
+            if (old->hash != hash || strcmp(old->canonical_path, canonical_path) != 0) {
+                link = &old->next;
+                continue;
+            }
+            *link = old->next;
+            old->next = NULL;
+            old->cached = false;
+            if (--old->references == 0) {
+                old->next = superseded;
+                superseded = old;
+            }
+        }
+
+        entry->next = *bucket;
+        *bucket = entry;
+        bool resident = parse_cache_resident;
+
+        // Parse without the lock; other threads asking for this file wait on the entry
+        pthread_mutex_unlock(&parse_cache_lock);
+        while (superseded) {
+            ParseCacheEntry_t* next = superseded->next;
+            free_cache_entry(superseded);
+            superseded = next;
+        }
+        ParsedFile_t* parsed = load_shareable_file(file_path, resident);
+        pthread_mutex_lock(&parse_cache_lock);
+
+        entry->parsed = parsed;
+        entry->loading = false;
+        pthread_cond_broadcast(&parse_cache_loaded);
     }
 
-    // Read content with divine blessing
-    char* content = malloc(file_size + 1);
-    if (!content) {
-        fclose(file);
+    if (!entry->parsed) {
+        bool last = --entry->references == 0;
+        pthread_mutex_unlock(&parse_cache_lock);
+        if (last) free_cache_entry(entry);
         return NULL;
     }
+    pthread_mutex_unlock(&parse_cache_lock);
+
+    // Our reference now belongs to the handle
+    ParsedFile_t* handle = make_cache_handle(entry, file_path);
+    if (!handle) drop_cache_reference(entry);
+    return handle;
+}
 
-    size_t bytes_read = fread(content, 1, file_size, file);
-    content[bytes_read] = '\0';
-    fclose(file);
+/*
+ * Release a handle from c_parser_acquire_file()
+ */
+void c_parser_release_file(ParsedFile_t* parsed) {
+    if (!parsed) return;
 
-    // Parse content
-    ParsedFile_t* result = c_parser_parse_content(content, file_path);
-    free(content);
+    ParseCacheEntry_t* entry = parsed->cache_entry;
+    if (!entry) {
+        c_parser_free_parsed_file(parsed);
+        return;
+    }
 
-    return result;
+    // The handle only owns its path; everything else belongs to the entry
+    free(parsed->file_path);
+    free(parsed);
+    drop_cache_reference(entry);
 }
 
 // =============================================================================
@@ -1359,11 +2749,7 @@ ParsedFile_t* c_parser_parse_file(const char* file_path) {
  * Free tokens array with compassionate cleanup
  */
 void c_parser_free_tokens(Token_t* tokens, int count) {
-    if (!tokens) return;
-
-    for (int i = 0; i < count; i++) {
-        free(tokens[i].value);
-    }
+    (void)count; // Tokens are views into their source buffer - nothing per-token to free
     free(tokens);
 }
 
@@ -1373,38 +2759,31 @@ void c_parser_free_tokens(Token_t* tokens, int count) {
 void c_parser_free_parsed_file(ParsedFile_t* parsed) {
     if (!parsed) return;
 
+    if (parsed->cache_entry) {
+        c_parser_release_file(parsed);
+        return;
+    }
+
     free(parsed->file_path);
+    c_parser_input_close(&parsed->input);
 
-    // Free tokens
+    // Free the line index and the token array view, if one was built
+    free_line_index(&parsed->line_index);
     if (parsed->tokens) {
         c_parser_free_tokens(parsed->tokens, parsed->token_count);
     }
 
-    // Free functions
-    if (parsed->functions) {
-        for (int i = 0; i < parsed->function_count; i++) {
-            free(parsed->functions[i].name);
-            free(parsed->functions[i].return_type);
-            free(parsed->functions[i].documentation);
-            if (parsed->functions[i].parameters) {
-                for (int j = 0; j < parsed->functions[i].param_count; j++) {
-                    free(parsed->functions[i].parameters[j]);
-                }
-                free(parsed->functions[i].parameters);
-            }
-        }
-        free(parsed->functions);
-    }
-
-    // Free includes
-    if (parsed->includes) {
-        for (int i = 0; i < parsed->include_count; i++) {
-            free(parsed->includes[i]);
-        }
-        free(parsed->includes);
-    }
+    // Every string the functions and includes point at goes with the arena
+    free(parsed->function_index);
+    free(parsed->calls);
+    free(parsed->call_args);
+    c_parser_arena_release(&parsed->arena);
+    release_atom_table(parsed->atoms);
+    parsed->atoms = NULL;
 
-    free(parsed);
+    // The token, function and include arrays can serve this thread's next parse
+    if (keep_pooled_file(parsed)) return;
+    free_pooled_file(parsed);
 }
 
 // =============================================================================
@@ -1417,101 +2796,84 @@ void c_parser_free_parsed_file(ParsedFile_t* parsed) {
 FunctionInfo_t* c_parser_find_function_at_line(ParsedFile_t* parsed, int line) {
     if (!parsed) return NULL;
 
-    for (int i = 0; i < parsed->function_count; i++) {
-        if (parsed->functions[i].line_number == line) {
-            return &parsed->functions[i];
+    // Functions are recorded in source order, so find the first one at or after `line`
+    int low = 0;
+    int high = parsed->function_count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (parsed->functions[mid].line_number < line) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
+
+    if (low < parsed->function_count && parsed->functions[low].line_number == line) {
+        return &parsed->functions[low];
+    }
     return NULL;
 }
 
 /*
- * Check if a function has documentation
+ * Find a function by name through the name index
  */
-bool c_parser_has_documentation_for_function(ParsedFile_t* parsed, const char* func_name) {
-    if (!parsed || !func_name) return false;
+FunctionInfo_t* c_parser_find_function(const ParsedFile_t* parsed, const char* name) {
+    if (!parsed || !name) return NULL;
 
-    // Find the function first
-    FunctionInfo_t* func = NULL;
-    for (int i = 0; i < parsed->function_count; i++) {
-        if (strcmp(parsed->functions[i].name, func_name) == 0) {
-            func = &parsed->functions[i];
-            break;
+    // Structures not built by the parser have no index; fall back to a scan
+    if (!parsed->function_index) {
+        for (int i = 0; i < parsed->function_count; i++) {
+            if (strcmp(parsed->functions[i].name, name) == 0) {
+                return &parsed->functions[i];
+            }
         }
+        return NULL;
     }
 
-    if (!func) return false;
+    // A name the parse never interned cannot belong to any of its functions
+    Atom_t atom = atom_lookup(parsed->atoms, name, strlen(name), false, NULL);
+    return atom != ATOM_NONE ? c_parser_find_function_atom(parsed, atom) : NULL;
+}
 
-    // Check if function already has documentation marked
-    if (func->has_documentation) return true;
+/*
+ * Find a function by interned name through the name index
+ */
+FunctionInfo_t* c_parser_find_function_atom(const ParsedFile_t* parsed, Atom_t name_atom) {
+    if (!parsed || name_atom == ATOM_NONE) return NULL;
 
-    // Look for block comment tokens before the function line (only block comments count as documentation)
-    int func_line = func->line_number;
-    Token_t* nearest_comment = NULL;
-    int nearest_distance = INT_MAX;
-    
-    // Find the nearest block comment before the function within 20 lines (increased range for large docs)
-    for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
-
-        // Look for block comments within 20 lines before the function
-        if (token->line < func_line && token->line >= func_line - 20) {
-            if (token->type == TOKEN_COMMENT_BLOCK) {
-                int distance = func_line - token->line;
-                if (distance < nearest_distance) {
-                    nearest_comment = token;
-                    nearest_distance = distance;
-                }
+    if (!parsed->function_index) {
+        for (int i = 0; i < parsed->function_count; i++) {
+            if (parsed->functions[i].name_atom == name_atom) {
+                return &parsed->functions[i];
             }
         }
+        return NULL;
     }
-    
-    
-    // If we found a comment, check if there are any significant code elements between it and the function
-    if (nearest_comment) {
-        bool has_code_between = false;
-        int comment_start_line = nearest_comment->line;
-        int comment_end_line = comment_start_line;
-        
-        // Count lines in the comment to find where it ends
-        char* comment_text = nearest_comment->value;
-        if (comment_text) {
-            // Count newlines in the comment text to determine how many lines it spans
-            int newline_count = 0;
-            for (char* p = comment_text; *p; p++) {
-                if (*p == '\n') newline_count++;
-            }
-            // The comment ends at its start line plus the number of newlines
-            comment_end_line = comment_start_line + newline_count;
-        }
-        
-        // Check for any significant code tokens between comment end and function
-        for (int i = 0; i < parsed->token_count; i++) {
-            Token_t* token = &parsed->tokens[i];
-            if (token->line > comment_end_line && token->line < func_line) {
-                if (token->type != TOKEN_NEWLINE && 
-                    token->type != TOKEN_COMMENT_LINE && 
-                    token->type != TOKEN_COMMENT_BLOCK &&
-                    token->type != TOKEN_PREPROCESSOR) {
-                    // Found significant code between comment and function
-                    has_code_between = true;
-                    break;
-                }
-            }
-        }
-        
-        // Accept if no code between comment and function, and they're reasonably close
-        int distance = func_line - comment_end_line;
-        
-        
-        if (!has_code_between && distance <= 3) {
-            func->has_documentation = true;
-            func->documentation = strdup(comment_text ? comment_text : "");
-            return true;
-        }
+
+    // An atom from another run's table is looked up again, by its text, in this parse's
+    if (!c_parser_atoms_comparable(name_atom, parsed->functions[0].name_atom)) {
+        const char* name = c_parser_atom_text(name_atom);
+        name_atom = name ? atom_lookup(parsed->atoms, name, strlen(name), false, NULL) : ATOM_NONE;
+        if (name_atom == ATOM_NONE) return NULL;
     }
 
-    return false;
+    uint32_t mask = parsed->function_index_mask;
+    uint32_t slot = function_atom_hash(name_atom) & mask;
+    while (parsed->function_index[slot] != 0) {
+        FunctionInfo_t* func = &parsed->functions[parsed->function_index[slot] - 1];
+        if (func->name_atom == name_atom) return func;
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
+
+/*
+ * Check if a function has documentation
+ */
+bool c_parser_has_documentation_for_function(ParsedFile_t* parsed, const char* func_name) {
+    // Documentation was linked while parsing
+    FunctionInfo_t* func = c_parser_find_function(parsed, func_name);
+    return func ? func->has_documentation : false;
 }
 
 /*
@@ -1521,10 +2883,9 @@ bool c_parser_line_has_pattern(ParsedFile_t* parsed, int line, const char* patte
     if (!parsed || !pattern) return false;
 
     // Look through tokens on the specified line
-    for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
-
-        if (token->line == line && token->value && strstr(token->value, pattern)) {
+    const TokenStore_t* ts = &parsed->token_store;
+    for (int i = first_token_at_line(ts, line); i < ts->count && ts->lines[i] == line; i++) {
+        if (store_token_contains(parsed->source, ts, i, pattern)) {
             return true;
         }
     }
@@ -1565,12 +2926,11 @@ bool c_parser_has_proper_filename_header(ParsedFile_t* parsed, const char* expec
     if (!parsed || !expected_filename) return false;
 
     // Look for first comment token
-    for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
-
-        if (token->type == TOKEN_COMMENT_BLOCK || token->type == TOKEN_COMMENT_LINE) {
+    const TokenStore_t* ts = &parsed->token_store;
+    for (int i = 0; i < ts->count; i++) {
+        if (ts->kinds[i] == TOKEN_COMMENT_BLOCK || ts->kinds[i] == TOKEN_COMMENT_LINE) {
             // Check if it contains the expected filename
-            if (strstr(token->value, expected_filename)) {
+            if (store_token_contains(parsed->source, ts, i, expected_filename)) {
                 return true;
             }
             // If we found a comment but it doesn't have filename, it's wrong
@@ -1578,7 +2938,7 @@ bool c_parser_has_proper_filename_header(ParsedFile_t* parsed, const char* expec
         }
 
         // Skip whitespace and preprocessor
-        if (token->type != TOKEN_NEWLINE && token->type != TOKEN_PREPROCESSOR) {
+        if (ts->kinds[i] != TOKEN_NEWLINE && ts->kinds[i] != TOKEN_PREPROCESSOR) {
             // Found non-comment, non-whitespace content first
             return false;
         }
@@ -1596,32 +2956,35 @@ bool c_parser_has_proper_purpose_line(ParsedFile_t* parsed) {
     int comment_count = 0;
 
     // Look for the second comment in the file
-    for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
-
-        if (token->type == TOKEN_COMMENT_BLOCK || token->type == TOKEN_COMMENT_LINE) {
+    const TokenStore_t* ts = &parsed->token_store;
+    for (int i = 0; i < ts->count; i++) {
+        if (ts->kinds[i] == TOKEN_COMMENT_BLOCK || ts->kinds[i] == TOKEN_COMMENT_LINE) {
             comment_count++;
 
             if (comment_count == 2) {
+                Token_t comment = c_parser_token_at(parsed, i);
+
                 // Reject ONLY the placeholder, accept everything else meaningful
                 // TODO: Add a 'Purpose Wisdom' placeholder generator in story/purpose_lines.h
                 // This will allow for more flexible purpose lines, generated depending on what
                 // the Linter is currently analyzing (e.g. function names, file names, etc.)
-                if (strstr(token->value, "INSERT WISDOM HERE")) {
+                if (c_parser_token_contains(parsed->source, &comment, "INSERT WISDOM HERE")) {
                     return false; // Still using placeholder
                 }
                 
                 // Check for meaningful content (not just whitespace/punctuation)
-                char* content = token->value;
+                const char* content = c_parser_token_text(parsed->source, &comment);
+                int remaining = comment.length;
                 bool has_meaningful_content = false;
                 
                 // Skip comment markers and whitespace
-                while (*content && (*content == '/' || *content == '*' || isspace(*content))) {
+                while (remaining > 0 && (*content == '/' || *content == '*' || isspace((unsigned char)*content))) {
                     content++;
+                    remaining--;
                 }
                 
                 // Check if there's actual meaningful text
-                if (strlen(content) > 0) {
+                if (remaining > 0) {
                     has_meaningful_content = true;
                 }
                 
@@ -1631,8 +2994,8 @@ bool c_parser_has_proper_purpose_line(ParsedFile_t* parsed) {
 
         // If we encounter significant code before finding second comment, fail
         if (comment_count == 1 &&
-            (token->type == TOKEN_KEYWORD || token->type == TOKEN_IDENTIFIER) &&
-            token->line > 5) {
+            (ts->kinds[i] == TOKEN_KEYWORD || ts->kinds[i] == TOKEN_IDENTIFIER) &&
+            ts->lines[i] > 5) {
             return false;
         }
     }
@@ -1666,241 +3029,212 @@ bool c_parser_has_proper_file_headers(ParsedFile_t* parsed) {
 }
 
 /*
- * Analyze function complexity with divine mathematical precision
+ * Measure one function's body from the token range recorded while parsing
  */
-ComplexityAnalysis_t c_parser_analyze_function_complexity(ParsedFile_t* parsed, const char* func_name) {
-    ComplexityAnalysis_t analysis = {0};
-
-    if (!parsed || !func_name) return analysis;
-
-    // Find the function
-    FunctionInfo_t* func = NULL;
-    for (int i = 0; i < parsed->function_count; i++) { // for every function that we have found
-        if (strcmp(parsed->functions[i].name, func_name) == 0) {
-            func = &parsed->functions[i]; // set the function pointer
-            break;
-        }
-    }
-
-    if (!func) return analysis;
+static void measure_function_body(const ParsedFile_t* parsed, const FunctionInfo_t* func,
+                                  ComplexityAnalysis_t* analysis) {
+    memset(analysis, 0, sizeof(*analysis));
 
     int func_start = func->line_number;
     int func_end = func_start;
-    int brace_count = 0;
-    int current_nesting = 0;
+    int current_nesting = 1;
     int max_nesting = 0;
     int return_count = 0;
     int branch_count = 0;
-    bool found_start = false;
-
-    // Find function boundaries and analyze complexity
-    for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
-
-        if (token->line < func_start) continue;
-
-        if (!found_start && token->type == TOKEN_PUNCTUATION && strcmp(token->value, "{") == 0) {
-            found_start = true;
-            brace_count = 1;
-            current_nesting = 1;
-            continue;
-        }
 
-        if (!found_start) continue;
+    // Only kinds and sub-kinds are touched, so the scan streams through two dense arrays
+    const uint8_t* kinds = parsed->token_store.kinds;
+    const uint8_t* sub_kinds = parsed->token_store.sub_kinds;
+    int end = func->body_end >= 0 ? func->body_end : parsed->token_store.count;
+    if (func->body_start >= 0 && func->body_end >= 0) {
+        func_end = parsed->token_store.lines[func->body_end];
+    }
 
-        // Track braces for nesting and function end
-        if (token->type == TOKEN_PUNCTUATION) {
-            if (strcmp(token->value, "{") == 0) {
-                brace_count++;
+    for (int i = func->body_start + 1; func->body_start >= 0 && i < end; i++) {
+        // Track braces for nesting
+        if (kinds[i] == TOKEN_PUNCTUATION) {
+            if (sub_kinds[i] == PUNCT_LBRACE) {
                 current_nesting++;
                 if (current_nesting > max_nesting) {
                     max_nesting = current_nesting;
                 }
-            } else if (strcmp(token->value, "}") == 0) {
-                brace_count--;
+            } else if (sub_kinds[i] == PUNCT_RBRACE) {
                 current_nesting--;
-                if (brace_count == 0) {
-                    func_end = token->line;
-                    break;
-                }
             }
         }
 
         // Count complexity-increasing constructs
-        if (token->type == TOKEN_KEYWORD) {
-            if (strcmp(token->value, "if") == 0 ||
-                strcmp(token->value, "while") == 0 ||
-                strcmp(token->value, "for") == 0 ||
-                strcmp(token->value, "switch") == 0 ||
-                strcmp(token->value, "case") == 0) {
-                branch_count++;
-                analysis.complexity_score++;
-            } else if (strcmp(token->value, "return") == 0) {
-                return_count++;
+        if (kinds[i] == TOKEN_KEYWORD) {
+            switch (sub_kinds[i]) {
+                case KW_IF: case KW_WHILE: case KW_FOR: case KW_SWITCH: case KW_CASE:
+                    branch_count++;
+                    analysis->complexity_score++;
+                    break;
+                case KW_RETURN:
+                    return_count++;
+                    break;
+                default:
+                    break;
             }
         }
 
         // Check for nested operators that increase complexity
-        if (token->type == TOKEN_OPERATOR) {
-            if (strcmp(token->value, "&&") == 0 || strcmp(token->value, "||") == 0) {
-                analysis.complexity_score++;
+        if (kinds[i] == TOKEN_OPERATOR) {
+            if (sub_kinds[i] == OP_LOGICAL_AND || sub_kinds[i] == OP_LOGICAL_OR) {
+                analysis->complexity_score++;
             }
         }
     }
 
-    analysis.nesting_depth = max_nesting;
-    analysis.function_length = func_end - func_start + 1;
-    analysis.has_multiple_returns = (return_count > 1);
-    analysis.has_deep_nesting = (max_nesting > 3);
-    analysis.branch_count = branch_count;
+    analysis->nesting_depth = max_nesting;
+    analysis->function_length = func_end - func_start + 1;
+    analysis->has_multiple_returns = (return_count > 1);
+    analysis->has_deep_nesting = (max_nesting > 3);
+    analysis->branch_count = branch_count;
+}
+
+/*
+ * Analyze function complexity with divine mathematical precision
+ */
+ComplexityAnalysis_t c_parser_analyze_function_complexity(ParsedFile_t* parsed, const char* func_name) {
+    ComplexityAnalysis_t analysis = {0};
+
+    FunctionInfo_t* func = c_parser_find_function(parsed, func_name);
+    if (!func) return analysis;
 
+    measure_function_body(parsed, func, &analysis);
     return analysis;
 }
 
 /*
- * Check if a function's header documentation follows proper 3-line format
+ * Analyze every function's complexity in one pass over their bodies
  */
-bool c_parser_has_proper_header_doc_format(ParsedFile_t* parsed, const char* func_name) {
-    if (!parsed || !func_name) return false;
+bool c_parser_analyze_all_function_complexity(ParsedFile_t* parsed, ComplexityAnalysis_t* results) {
+    if (!parsed || !results) return false;
 
-    // Find the function first
-    FunctionInfo_t* func = NULL;
+    // Bodies are disjoint token ranges, so together they visit each token at most once
     for (int i = 0; i < parsed->function_count; i++) {
-        if (strcmp(parsed->functions[i].name, func_name) == 0) {
-            func = &parsed->functions[i];
-            break;
-        }
+        measure_function_body(parsed, &parsed->functions[i], &results[i]);
     }
-    if (!func) return false;
-
-    // Look for a block comment token right before the function
-    for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
-
-        if (token->line >= func->line_number - 20 && token->line < func->line_number) {
-            if (token->type == TOKEN_COMMENT_BLOCK) {
-                char* comment_copy = strdup(token->value);
-                if (!comment_copy) return false;
-
-                int total_lines = 0;
-                int description_lines = 0;
-                bool has_inappropriate_content = false;
-                bool found_description = false;
-                bool found_blank_line = false;
+    return true;
+}
 
-                char* saveptr;
-                char* line = strtok_r(comment_copy, "\n", &saveptr);
+/*
+ * Check a resolved function's documentation against the one-line format
+ */
+bool c_parser_function_has_proper_doc_format(const ParsedFile_t* parsed, const FunctionInfo_t* func) {
+    if (!parsed || !func) return false;
+    if (func->doc_comment < 0) return true; // No documentation found, so no format to violate
 
-                while (line != NULL) {
-                    total_lines++;
-                    
-                    // Trim leading whitespace and '*' from the line
-                    char* trimmed = line;
-                    while (*trimmed && (isspace((unsigned char)*trimmed) || *trimmed == '*')) {
-                        trimmed++;
-                    }
+    Token_t comment = c_parser_token_at(parsed, func->doc_comment);
+    char* comment_copy = c_parser_token_strdup(parsed->source, &comment);
+    if (!comment_copy) return false;
 
-                    // Check for inappropriate content
-                    if (strstr(trimmed, "piss") || strstr(trimmed, "FIXED:") || strstr(trimmed, "TODO:")) {
-                        has_inappropriate_content = true;
-                    }
+    int total_lines = 0;
+    int description_lines = 0;
+    bool has_inappropriate_content = false;
+    bool found_description = false;
+    bool found_blank_line = false;
 
-                    // Skip opening/closing markers
-                    if (strstr(line, "/*") || strstr(line, "*/")) {
-                        line = strtok_r(NULL, "\n", &saveptr);
-                        continue;
-                    }
+    char* saveptr;
+    char* line = strtok_r(comment_copy, "\n", &saveptr);
 
-                    // Count only the FIRST content line as description
-                    if (strlen(trimmed) > 0) {
-                        if (!found_description) {
-                            description_lines = 1;
-                            found_description = true;
-                        }
-                    } else if (found_description && !found_blank_line) {
-                        // This is the blank line after description
-                        found_blank_line = true;
-                    }
-                    
-                    line = strtok_r(NULL, "\n", &saveptr);
-                }
-                
-                free(comment_copy);
+    while (line != NULL) {
+        total_lines++;
+        
+        // Trim leading whitespace and '*' from the line
+        char* trimmed = line;
+        while (*trimmed && (isspace((unsigned char)*trimmed) || *trimmed == '*')) {
+            trimmed++;
+        }
 
-                // Enforce strict header format: exactly 1 description line, followed by blank line, then parameters
-                // Must have: found_description=true, found_blank_line=true, description_lines=1
-                bool is_valid_format = false;
-                if (found_description && description_lines >= 1 && found_blank_line) {
-                    is_valid_format = true; // Proper header format: one description + blank + details
-                }
+        // Check for inappropriate content
+        if (strstr(trimmed, "piss") || strstr(trimmed, "FIXED:") || strstr(trimmed, "TODO:")) {
+            has_inappropriate_content = true;
+        }
 
-                // A 4-line comment is always invalid
-                if (total_lines == 4) {
-                    is_valid_format = false;
-                }
+        // Skip opening/closing markers
+        if (strstr(line, "/*") || strstr(line, "*/")) {
+            line = strtok_r(NULL, "\n", &saveptr);
+            continue;
+        }
 
-                return (is_valid_format && !has_inappropriate_content);
+        // Count only the FIRST content line as description
+        if (strlen(trimmed) > 0) {
+            if (!found_description) {
+                description_lines = 1;
+                found_description = true;
             }
+        } else if (found_description && !found_blank_line) {
+            // This is the blank line after description
+            found_blank_line = true;
         }
+        
+        line = strtok_r(NULL, "\n", &saveptr);
+    }
+    
+    free(comment_copy);
+
+    // Enforce strict header format: exactly 1 description line, followed by blank line, then parameters
+    // Must have: found_description=true, found_blank_line=true, description_lines=1
+    bool is_valid_format = false;
+    if (found_description && description_lines >= 1 && found_blank_line) {
+        is_valid_format = true; // Proper header format: one description + blank + details
     }
 
-    return true; // No documentation found, so no format to violate
+    // A 4-line comment is always invalid
+    if (total_lines == 4) {
+        is_valid_format = false;
+    }
+
+    return (is_valid_format && !has_inappropriate_content);
+}
+
+/*
+ * Check if a function's header documentation follows proper 3-line format
+ */
+bool c_parser_has_proper_header_doc_format(ParsedFile_t* parsed, const char* func_name) {
+    FunctionInfo_t* func = c_parser_find_function(parsed, func_name);
+    return func ? c_parser_function_has_proper_doc_format(parsed, func) : false;
 }
 
 /*
  * Extract the one-line description from a function's documentation
  */
 char* c_parser_extract_function_description(ParsedFile_t* parsed, const char* func_name) {
-    if (!parsed || !func_name) return NULL;
-
-    // Find the function first
-    FunctionInfo_t* func = NULL;
-    for (int i = 0; i < parsed->function_count; i++) {
-        if (strcmp(parsed->functions[i].name, func_name) == 0) {
-            func = &parsed->functions[i];
-            break;
+    FunctionInfo_t* func = c_parser_find_function(parsed, func_name);
+    if (!func || func->doc_comment < 0) return NULL;
+
+    // The parse already linked the block comment above the function
+    Token_t comment = c_parser_token_at(parsed, func->doc_comment);
+    char* comment_copy = c_parser_token_strdup(parsed->source, &comment);
+    if (!comment_copy) return NULL;
+
+    char* description = NULL;
+    char* saveptr;
+    char* line = strtok_r(comment_copy, "\n", &saveptr);
+
+    while (line != NULL) {
+        char* trimmed = line;
+        while (*trimmed && (isspace((unsigned char)*trimmed) || *trimmed == '*')) {
+            trimmed++;
         }
-    }
-    if (!func) return NULL;
 
-    // Look for a block comment token before the function line
-    for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
-
-        if (token->line >= func->line_number - 10 && token->line < func->line_number) {
-            if (token->type == TOKEN_COMMENT_BLOCK) {
-                char* comment_copy = strdup(token->value);
-                if (!comment_copy) return NULL;
-
-                char* description = NULL;
-                char* saveptr;
-                char* line = strtok_r(comment_copy, "\n", &saveptr);
-
-                while (line != NULL) {
-                    char* trimmed = line;
-                    while (*trimmed && (isspace((unsigned char)*trimmed) || *trimmed == '*')) {
-                        trimmed++;
-                    }
-
-                    // Trim trailing whitespace as well for a clean description
-                    size_t len = strlen(trimmed);
-                    while (len > 0 && isspace((unsigned char)trimmed[len - 1])) {
-                        trimmed[--len] = '\0';
-                    }
-
-                    if (strlen(trimmed) > 0 && !strstr(trimmed, "/*") && !strstr(trimmed, "*/")) {
-                        description = strdup(trimmed);
-                        break; // Found the first line of content, we're done.
-                    }
-                    line = strtok_r(NULL, "\n", &saveptr);
-                }
+        // Trim trailing whitespace as well for a clean description
+        size_t len = strlen(trimmed);
+        while (len > 0 && isspace((unsigned char)trimmed[len - 1])) {
+            trimmed[--len] = '\0';
+        }
 
-                free(comment_copy);
-                return description;
-            }
+        if (strlen(trimmed) > 0 && !strstr(trimmed, "/*") && !strstr(trimmed, "*/")) {
+            description = strdup(trimmed);
+            break; // Found the first line of content, we're done.
         }
+        line = strtok_r(NULL, "\n", &saveptr);
     }
-    return NULL;
+
+    free(comment_copy);
+    return description;
 }
 
 /*
@@ -1932,12 +3266,14 @@ static bool is_dstring_type(const char* type_name) {
 // A more advanced parser would verify the actual type of 'variable'.
 static bool is_dstring_str_access(ParsedFile_t* parsed, int token_idx) {
     // Check for `identifier` -> `str` pattern
-    if (token_idx + 2 < parsed->token_count &&
-        parsed->tokens[token_idx].type == TOKEN_IDENTIFIER &&       // e.g., 'variable'
-        parsed->tokens[token_idx + 1].type == TOKEN_OPERATOR &&     // '->'
-        strcmp(parsed->tokens[token_idx + 1].value, "->") == 0 &&
-        parsed->tokens[token_idx + 2].type == TOKEN_IDENTIFIER &&   // 'str'
-        strcmp(parsed->tokens[token_idx + 2].value, "str") == 0)
+    const TokenStore_t* ts = &parsed->token_store;
+    if (token_idx + 2 < ts->count &&
+        ts->kinds[token_idx] == TOKEN_IDENTIFIER &&         // e.g., 'variable'
+        ts->kinds[token_idx + 1] == TOKEN_OPERATOR &&       // '->'
+        ts->sub_kinds[token_idx + 1] == OP_ARROW &&
+        ts->kinds[token_idx + 2] == TOKEN_IDENTIFIER &&     // 'str'
+        ts->lengths[token_idx + 2] == 3 &&
+        memcmp(parsed->source + ts->offsets[token_idx + 2], "str", 3) == 0)
     {
         // This pattern strongly suggests a dString_t->str access.
         // A truly robust check would involve symbol table lookups to confirm 'variable' is dString_t*.
@@ -1949,19 +3285,20 @@ static bool is_dstring_str_access(ParsedFile_t* parsed, int token_idx) {
 }
 
 // Helper to determine if a token is a string literal (e.g., "hello")
-static bool is_string_literal(const Token_t* token) {
-    return token->type == TOKEN_STRING;
+static bool is_string_literal(const ParsedFile_t* parsed, int token_idx) {
+    return token_idx < parsed->token_store.count && parsed->token_store.kinds[token_idx] == TOKEN_STRING;
 }
 
 // Helper to find the end of a function call's arguments.
 // This function will look for the matching ')' for a given '('
 static int find_matching_paren(ParsedFile_t* parsed, int start_idx) {
+    const TokenStore_t* ts = &parsed->token_store;
     int paren_count = 0;
-    for (int i = start_idx; i < parsed->token_count; ++i) {
-        if (parsed->tokens[i].type == TOKEN_PUNCTUATION) {
-            if (strcmp(parsed->tokens[i].value, "(") == 0) {
+    for (int i = start_idx; i < ts->count; ++i) {
+        if (ts->kinds[i] == TOKEN_PUNCTUATION) {
+            if (ts->sub_kinds[i] == PUNCT_LPAREN) {
                 paren_count++;
-            } else if (strcmp(parsed->tokens[i].value, ")") == 0) {
+            } else if (ts->sub_kinds[i] == PUNCT_RPAREN) {
                 paren_count--;
                 if (paren_count == 0) {
                     return i; // Found matching ')'
@@ -1972,6 +3309,92 @@ static int find_matching_paren(ParsedFile_t* parsed, int start_idx) {
     return -1; // No matching ')' found
 }
 
+/*
+ * Check one strcmp call for an unsafe comparison against dString_t->str
+ */
+bool c_parser_match_unsafe_strcmp(ParsedFile_t* parsed, int token_index, UnsafeStrcmpUsage_t* usage) {
+    if (!parsed || !usage) return false;
+
+    const TokenStore_t* ts = &parsed->token_store;
+    int i = token_index;
+    if (i < 0 || i + 1 >= ts->count) return false;
+
+    // 1. Look for a `strcmp` function call (the next token is an opening parenthesis)
+    if (ts->kinds[i] != TOKEN_IDENTIFIER || ts->lengths[i] != 6 ||
+        memcmp(parsed->source + ts->offsets[i], "strcmp", 6) != 0 ||
+        ts->kinds[i + 1] != TOKEN_PUNCTUATION || ts->sub_kinds[i + 1] != PUNCT_LPAREN) {
+        return false;
+    }
+
+    int start_of_args_idx = i + 2; // Token after '('
+
+    // Find the end of the strcmp call (matching ')')
+    int end_of_call_idx = find_matching_paren(parsed, i + 1);
+    if (end_of_call_idx == -1) {
+        return false; // Malformed call, skip
+    }
+
+    // Try to find the comma separating arguments
+    int comma_idx = -1;
+    for (int j = start_of_args_idx; j < end_of_call_idx; ++j) {
+        if (ts->kinds[j] == TOKEN_PUNCTUATION && ts->sub_kinds[j] == PUNCT_COMMA) {
+            comma_idx = j;
+            break;
+        }
+    }
+
+    if (comma_idx == -1) {
+        return false; // `strcmp` expects two arguments, skip if comma not found
+    }
+
+    // Analyze Argument 1 (from start_of_args_idx to comma_idx - 1)
+    // We'll check the token right before the comma or the ')' if no comma for the first arg
+    bool arg1_is_dstring_str = is_dstring_str_access(parsed, start_of_args_idx);
+    // For string literals, it might be the token at start_of_args_idx itself
+    bool arg1_is_cstring_literal = is_string_literal(parsed, start_of_args_idx);
+
+    // Analyze Argument 2 (from comma_idx + 1 to end_of_call_idx - 1)
+    // We'll check the token right after the comma
+    bool arg2_is_dstring_str = is_dstring_str_access(parsed, comma_idx + 1);
+    bool arg2_is_cstring_literal = is_string_literal(parsed, comma_idx + 1);
+
+    // Check for unsafe patterns: at least one `->str` access in the arguments
+    if (!arg1_is_dstring_str && !arg2_is_dstring_str) {
+        return false;
+    }
+
+    // Now determine the specific type of unsafe usage
+    bool is_dstring_vs_cstring = false;
+    bool is_dstring_vs_dstring = false;
+
+    if (arg1_is_dstring_str && (arg2_is_cstring_literal || !arg2_is_dstring_str)) {
+        is_dstring_vs_cstring = true; // Arg1 is dstring->str, Arg2 is not dstring->str (likely c-string)
+    } else if (arg2_is_dstring_str && (arg1_is_cstring_literal || !arg1_is_dstring_str)) {
+        is_dstring_vs_cstring = true; // Arg2 is dstring->str, Arg1 is not dstring->str (likely c-string)
+    } else if (arg1_is_dstring_str && arg2_is_dstring_str) {
+        is_dstring_vs_dstring = true; // Both are dstring->str
+    }
+
+    if (!is_dstring_vs_cstring && !is_dstring_vs_dstring) {
+        return false;
+    }
+
+    usage->line = ts->lines[i];
+    usage->column = token_column(ts, &parsed->line_index, i);
+    usage->is_dstring_vs_cstring = is_dstring_vs_cstring;
+    usage->is_dstring_vs_dstring = is_dstring_vs_dstring;
+
+    // Extract function name context
+    c_parser_find_containing_function(parsed, ts->lines[i],
+                                      usage->function_name, sizeof(usage->function_name));
+
+    // Extract variable names from the strcmp arguments
+    extract_strcmp_variable_names(parsed, start_of_args_idx, comma_idx, end_of_call_idx,
+                                  usage->variable1, sizeof(usage->variable1),
+                                  usage->variable2, sizeof(usage->variable2));
+    return true;
+}
+
 /*
  * Detects unsafe strcmp(dString_t->str, ...) usages.
  * Populates usages_out with a dynamically allocated array of found usages.
@@ -1993,97 +3416,22 @@ bool c_parser_detect_unsafe_strcmp_dstring_usage(ParsedFile_t* parsed,
         return false; // Memory allocation failed
     }
 
-    for (int i = 0; i < parsed->token_count; ++i) {
-        Token_t* current_token = &parsed->tokens[i];
-
-        // 1. Look for `strcmp` function call
-        if (current_token->type == TOKEN_IDENTIFIER && strcmp(current_token->value, "strcmp") == 0) {
-            // Check if the next token is an opening parenthesis, indicating a function call
-            if (i + 1 < parsed->token_count &&
-                parsed->tokens[i + 1].type == TOKEN_PUNCTUATION &&
-                strcmp(parsed->tokens[i + 1].value, "(") == 0) {
-
-                int start_of_args_idx = i + 2; // Token after '('
-
-                // Find the end of the strcmp call (matching ')')
-                int end_of_call_idx = find_matching_paren(parsed, i + 1);
-                if (end_of_call_idx == -1) {
-                    continue; // Malformed call, skip
-                }
-
-                // Try to find the comma separating arguments
-                int comma_idx = -1;
-                for (int j = start_of_args_idx; j < end_of_call_idx; ++j) {
-                    if (parsed->tokens[j].type == TOKEN_PUNCTUATION && strcmp(parsed->tokens[j].value, ",") == 0) {
-                        comma_idx = j;
-                        break;
-                    }
-                }
-
-                if (comma_idx == -1) {
-                    continue; // `strcmp` expects two arguments, skip if comma not found
-                }
-
-                // Analyze Argument 1 (from start_of_args_idx to comma_idx - 1)
-                // We'll check the token right before the comma or the ')' if no comma for the first arg
-                bool arg1_is_dstring_str = is_dstring_str_access(parsed, start_of_args_idx);
-                // For string literals, it might be the token at start_of_args_idx itself
-                bool arg1_is_cstring_literal = is_string_literal(&parsed->tokens[start_of_args_idx]);
-
-                // Analyze Argument 2 (from comma_idx + 1 to end_of_call_idx - 1)
-                // We'll check the token right after the comma
-                bool arg2_is_dstring_str = is_dstring_str_access(parsed, comma_idx + 1);
-                bool arg2_is_cstring_literal = is_string_literal(&parsed->tokens[comma_idx + 1]);
-
-                // Check for unsafe patterns
-                if (arg1_is_dstring_str || arg2_is_dstring_str) {
-                    // We found at least one `->str` access in `strcmp` arguments.
-                    // Now determine the specific type of unsafe usage.
-
-                    bool is_dstring_vs_cstring = false;
-                    bool is_dstring_vs_dstring = false;
-
-                    if (arg1_is_dstring_str && (arg2_is_cstring_literal || !arg2_is_dstring_str)) {
-                        is_dstring_vs_cstring = true; // Arg1 is dstring->str, Arg2 is not dstring->str (likely c-string)
-                    } else if (arg2_is_dstring_str && (arg1_is_cstring_literal || !arg1_is_dstring_str)) {
-                        is_dstring_vs_cstring = true; // Arg2 is dstring->str, Arg1 is not dstring->str (likely c-string)
-                    } else if (arg1_is_dstring_str && arg2_is_dstring_str) {
-                        is_dstring_vs_dstring = true; // Both are dstring->str
-                    }
-
-                    // Add the violation
-                    if (is_dstring_vs_cstring || is_dstring_vs_dstring) {
-                        if (*count_out >= current_capacity) {
-                            current_capacity *= 2;
-                            UnsafeStrcmpUsage_t* new_usages = realloc(found_usages, sizeof(UnsafeStrcmpUsage_t) * current_capacity);
-                            if (!new_usages) {
-                                free(found_usages);
-                                *usages_out = NULL;
-                                *count_out = 0;
-                                return false; // Reallocation failed
-                            }
-                            found_usages = new_usages;
-                        }
-
-                        found_usages[*count_out].line = current_token->line;
-                        found_usages[*count_out].column = current_token->column;
-                        found_usages[*count_out].is_dstring_vs_cstring = is_dstring_vs_cstring;
-                        found_usages[*count_out].is_dstring_vs_dstring = is_dstring_vs_dstring;
-                        
-                        // Extract function name context
-                        c_parser_find_containing_function(parsed, current_token->line, 
-                                                        found_usages[*count_out].function_name, 
-                                                        sizeof(found_usages[*count_out].function_name));
-                        
-                        // Extract variable names from the strcmp arguments
-                        extract_strcmp_variable_names(parsed, start_of_args_idx, comma_idx, end_of_call_idx,
-                                                    found_usages[*count_out].variable1, sizeof(found_usages[*count_out].variable1),
-                                                    found_usages[*count_out].variable2, sizeof(found_usages[*count_out].variable2));
-                        
-                        (*count_out)++;
-                    }
-                }
+    const TokenStore_t* ts = &parsed->token_store;
+    for (int i = 0; i < ts->count; ++i) {
+        if (*count_out >= current_capacity) {
+            current_capacity *= 2;
+            UnsafeStrcmpUsage_t* new_usages = realloc(found_usages, sizeof(UnsafeStrcmpUsage_t) * current_capacity);
+            if (!new_usages) {
+                free(found_usages);
+                *usages_out = NULL;
+                *count_out = 0;
+                return false; // Reallocation failed
             }
+            found_usages = new_usages;
+        }
+
+        if (c_parser_match_unsafe_strcmp(parsed, i, &found_usages[*count_out])) {
+            (*count_out)++;
         }
     }
 
@@ -2159,15 +3507,16 @@ void extract_base_variable_name(ParsedFile_t* parsed, int start_idx, int end_idx
     
     // First, build the full expression
     for (int i = start_idx; i <= end_idx && i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
+        Token_t token = c_parser_token_at(parsed, i);
         
         // Skip whitespace tokens and newlines
-        if (token->type == TOKEN_NEWLINE) continue;
+        if (token.type == TOKEN_NEWLINE) continue;
         
         // Add token to expression
-        if (expr_pos < sizeof(full_expression) - strlen(token->value) - 1) {
-            strcpy(full_expression + expr_pos, token->value);
-            expr_pos += strlen(token->value);
+        if ((size_t)expr_pos + (size_t)token.length < sizeof(full_expression)) {
+            expr_pos += c_parser_token_copy_to(parsed->source, &token,
+                                               full_expression + expr_pos,
+                                               sizeof(full_expression) - expr_pos);
         }
     }
     
@@ -22,15 +22,16 @@ typedef struct {
 // Forward declarations for helper functions
 static void _process_char_for_whitespace_compression(char current_char, char** write_ptr, bool* seen_non_space_ptr);
 static XRefViolationMetadata_t _get_violation_metadata(XRefViolationType_t type);
-static void _print_formatted_violation(const char* file_path, int line,
+static void _print_formatted_violation(FILE* out, const char* file_path, int line,
                                        const XRefViolationMetadata_t* metadata,
                                        const char* description);
+static int _xref_print_violations(const XRefViolationList_t* xref_violations,
+                                  const char* file_path, FILE* out);
 static bool _xref_parse_files(const char* c_file_path, char* header_path, ParsedFile_t** impl_parsed_out, ParsedFile_t** header_parsed_out);
 static void _xref_check_impl_functions(ParsedFile_t* impl_parsed, ParsedFile_t* header_parsed, const char* header_path, XRefViolationList_t* xref_violations);
 static void _xref_check_header_functions(ParsedFile_t* impl_parsed, ParsedFile_t* header_parsed, const char* c_file_path, XRefViolationList_t* xref_violations);
 static void _xref_free_analysis_resources(XRefViolationList_t* xref_violations, ParsedFile_t* impl_parsed, ParsedFile_t* header_parsed, char* header_path);
 
-static FunctionInfo_t* _find_function_in_parsed_file(const ParsedFile_t* parsed_file, const char* function_name);
 
 /*
  * Helper function to check if a file exists
@@ -267,6 +268,17 @@ static char* normalize_type_string(const char* type_str) {
 bool cross_reference_compare_signatures(const FunctionInfo_t* header_func, const FunctionInfo_t* impl_func) {
     if (!header_func || !impl_func) return false;
     
+    // Parsed functions carry interned names and return types. Within one table equal names
+    // intern to equal atoms, and identical return types normalize identically, so only
+    // differing return type spellings need the normalized comparison below
+    if (c_parser_atoms_comparable(header_func->name_atom, impl_func->name_atom) &&
+        c_parser_atoms_comparable(header_func->return_type_atom, impl_func->return_type_atom)) {
+        if (header_func->name_atom != impl_func->name_atom) return false;
+        if (header_func->return_type_atom == impl_func->return_type_atom) {
+            return header_func->param_count == impl_func->param_count;
+        }
+    }
+    
     // Compare function names - must be exact
     if (strcmp(header_func->name, impl_func->name) != 0) {
         return false;
@@ -452,16 +464,17 @@ static XRefViolationMetadata_t _get_violation_metadata(XRefViolationType_t type)
 /*
  * Helper function to print a cross-reference violation using Metis color system.
  *
+ * `out` - Stream to print to.
  * `file_path` - Path to the file where the violation occurred.
  * `line` - Line number of the violation.
  * `metadata` - Pointer to XRefViolationMetadata_t containing tag and colors.
  * `description` - Human-readable description of the violation.
  */
-static void _print_formatted_violation(const char* file_path, int line,
+static void _print_formatted_violation(FILE* out, const char* file_path, int line,
                                        const XRefViolationMetadata_t* metadata,
                                        const char* description) {
     // Use the proper Metis color format matching the main linter output
-    printf("%s%s:%d:%d:%s %s[%s%s%s]%s %s%s%s\n",
+    fprintf(out, "%s%s:%d:%d:%s %s[%s%s%s]%s %s%s%s\n",
            METIS_CLICKABLE_LINK, file_path, line, 1, METIS_RESET,
            metadata->severity_color,
            metadata->type_color,
@@ -476,6 +489,21 @@ static void _print_formatted_violation(const char* file_path, int line,
 int cross_reference_convert_violations(const XRefViolationList_t* xref_violations,
                                      const char* file_path,
                                      ViolationList_t* violations) {
+    (void)violations;
+    return _xref_print_violations(xref_violations, file_path, stdout);
+}
+
+/*
+ * Helper function to print cross-reference violations to a stream.
+ *
+ * `xref_violations` - The list of cross-reference violations.
+ * `file_path` - File path for the violations.
+ * `out` - Stream to print to.
+ *
+ * `int` - Number of violations printed.
+ */
+static int _xref_print_violations(const XRefViolationList_t* xref_violations,
+                                  const char* file_path, FILE* out) {
     if (!xref_violations || !file_path) return 0;
     
     int converted = 0;
@@ -489,7 +517,7 @@ int cross_reference_convert_violations(const XRefViolationList_t* xref_violation
         int line = xref->impl_line > 0 ? xref->impl_line : xref->header_line;
         line = line > 0 ? line : 1; // Ensure line is at least 1
         
-        _print_formatted_violation(file_path, line, &metadata, xref->description);
+        _print_formatted_violation(out, file_path, line, &metadata, xref->description);
         
         converted++;
     }
@@ -498,27 +526,6 @@ int cross_reference_convert_violations(const XRefViolationList_t* xref_violation
 }
 
 
-/*
- * Helper function to find a function by name in a ParsedFile_t structure.
- *
- * `parsed_file` - The parsed file structure to search within.
- * `function_name` - The name of the function to find.
- *
- * `FunctionInfo_t*` - Pointer to the found FunctionInfo_t, or NULL if not found.
- */
-static FunctionInfo_t* _find_function_in_parsed_file(const ParsedFile_t* parsed_file, const char* function_name) {
-    if (!parsed_file || !function_name) {
-        return NULL;
-    }
-    for (int i = 0; i < parsed_file->function_count; i++) {
-        if (strcmp(parsed_file->functions[i].name, function_name) == 0) {
-            return &parsed_file->functions[i];
-        }
-    }
-    return NULL;
-}
-
-
 /*
  * Helper function to parse the C implementation and header files.
  *
@@ -532,12 +539,15 @@ static FunctionInfo_t* _find_function_in_parsed_file(const ParsedFile_t* parsed_
  */
 static bool _xref_parse_files(const char* c_file_path, char* header_path,
                               ParsedFile_t** impl_parsed_out, ParsedFile_t** header_parsed_out) {
-    *impl_parsed_out = c_parser_parse_file(c_file_path);
-    *header_parsed_out = c_parser_parse_file(header_path);
-
-    if (!*impl_parsed_out || !*header_parsed_out) {
-        if (*impl_parsed_out) c_parser_free_parsed_file(*impl_parsed_out);
-        if (*header_parsed_out) c_parser_free_parsed_file(*header_parsed_out);
+    // Shared with the rest of the run, so the header is parsed once however many files include it
+    *impl_parsed_out = c_parser_acquire_file(c_file_path);
+    *header_parsed_out = c_parser_acquire_file(header_path);
+
+    // An empty file has nothing to cross-reference
+    if (!*impl_parsed_out || !*header_parsed_out ||
+        (*impl_parsed_out)->source_length == 0 || (*header_parsed_out)->source_length == 0) {
+        c_parser_release_file(*impl_parsed_out);
+        c_parser_release_file(*header_parsed_out);
         *impl_parsed_out = NULL;
         *header_parsed_out = NULL;
         return false;
@@ -563,7 +573,7 @@ static void _xref_check_impl_functions(ParsedFile_t* impl_parsed, ParsedFile_t*
             continue;
         }
         
-        FunctionInfo_t* header_func = _find_function_in_parsed_file(header_parsed, impl_func->name);
+        FunctionInfo_t* header_func = c_parser_find_function_atom(header_parsed, impl_func->name_atom);
         
         if (!header_func) {
             // Function implemented but not declared in header
@@ -623,7 +633,7 @@ static void _xref_check_header_functions(ParsedFile_t* impl_parsed, ParsedFile_t
             continue;
         }
         
-        FunctionInfo_t* impl_func = _find_function_in_parsed_file(impl_parsed, header_func->name);
+        FunctionInfo_t* impl_func = c_parser_find_function_atom(impl_parsed, header_func->name_atom);
         
         // Check for missing documentation in header (regardless of implementation)
         if (!header_func->has_documentation) {
@@ -663,15 +673,23 @@ static void _xref_free_analysis_resources(XRefViolationList_t* xref_violations,
                                          ParsedFile_t* header_parsed,
                                          char* header_path) {
     if (xref_violations) cross_reference_free_violations(xref_violations);
-    if (impl_parsed) c_parser_free_parsed_file(impl_parsed);
-    if (header_parsed) c_parser_free_parsed_file(header_parsed);
+    c_parser_release_file(impl_parsed);
+    c_parser_release_file(header_parsed);
     if (header_path) free(header_path);
 }
 /*
  * Perform full cross-reference analysis between a .c file and its header
  */
 int cross_reference_analyze_file(const char* c_file_path, ViolationList_t* violations) {
-    if (!c_file_path) return 0;
+    return cross_reference_analyze_file_to(c_file_path, violations, stdout);
+}
+
+/*
+ * Perform full cross-reference analysis, printing findings to a given stream
+ */
+int cross_reference_analyze_file_to(const char* c_file_path, ViolationList_t* violations, FILE* out) {
+    (void)violations;
+    if (!c_file_path || !out) return 0;
     
     char* header_path = NULL;
     ParsedFile_t* impl_parsed = NULL;
@@ -705,10 +723,34 @@ int cross_reference_analyze_file(const char* c_file_path, ViolationList_t* viola
     _xref_check_header_functions(impl_parsed, header_parsed, c_file_path, xref_violations);
     
     // 6. Convert cross-reference violations to regular linter violations
-    violation_count = cross_reference_convert_violations(xref_violations, c_file_path, violations);
+    violation_count = _xref_print_violations(xref_violations, c_file_path, out);
     
     // 7. Cleanup all allocated resources
     _xref_free_analysis_resources(xref_violations, impl_parsed, header_parsed, header_path);
     
     return violation_count;
-}
\ No newline at end of file
+}
+
+/*
+ * Cross-reference an already parsed .c file against its header, collecting the findings
+ */
+XRefViolationList_t* cross_reference_check_parsed(const char* c_file_path, ParsedFile_t* impl_parsed) {
+    if (!c_file_path || !impl_parsed || impl_parsed->source_length == 0) return NULL;
+
+    char* header_path = cross_reference_find_header_file(c_file_path);
+    if (!header_path) return NULL;
+
+    // The caller owns `impl_parsed`; only the header handle is ours to release
+    ParsedFile_t* header_parsed = c_parser_acquire_file(header_path);
+    XRefViolationList_t* xref_violations = NULL;
+    if (header_parsed && header_parsed->source_length > 0) {
+        xref_violations = cross_reference_init_violations();
+    }
+    if (xref_violations) {
+        _xref_check_impl_functions(impl_parsed, header_parsed, header_path, xref_violations);
+        _xref_check_header_functions(impl_parsed, header_parsed, c_file_path, xref_violations);
+    }
+
+    _xref_free_analysis_resources(NULL, NULL, header_parsed, header_path);
+    return xref_violations;
+}
@@ -0,0 +1,301 @@
+/* metis_ignore.c - .metisignore pattern lists for pruning directory lints */
+// INSERT WISDOM HERE
+
+#define _POSIX_C_SOURCE 200809L  // For openat
+
+#include "metis_ignore.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define METIS_IGNORE_MAX_BYTES (1024 * 1024)   // Larger files are not pattern lists anyone wrote
+
+// =============================================================================
+// WILDCARD MATCHING
+// =============================================================================
+
+/*
+ * Match `c` against the bracket expression starting at pattern[start] ('[')
+ *
+ * `matched` - Set to whether `c` is in the class
+ *
+ * `size_t` - Index just past the closing ']', or 0 if the class is unterminated
+ */
+static size_t match_class(const char* pattern, size_t length, size_t start, char c, bool* matched) {
+    size_t i = start + 1;
+    bool negated = i < length && (pattern[i] == '!' || pattern[i] == '^');
+    if (negated) i++;
+
+    bool found = false;
+    bool first = true;
+    while (i < length && (pattern[i] != ']' || first)) {
+        char low = pattern[i];
+        if (low == '\\' && i + 1 < length) low = pattern[++i];
+
+        char high = low;
+        if (i + 2 < length && pattern[i + 1] == '-' && pattern[i + 2] != ']') {
+            high = pattern[i + 2];
+            if (high == '\\' && i + 3 < length) high = pattern[++i + 2];
+            i += 2;
+        }
+        if ((unsigned char)c >= (unsigned char)low && (unsigned char)c <= (unsigned char)high) found = true;
+        first = false;
+        i++;
+    }
+    if (i >= length) return 0;
+
+    *matched = c != '/' && found != negated;
+    return i + 1;
+}
+
+/*
+ * Match `text` against a wildcard pattern
+ *
+ * `*` and `?` never cross a `/`; `**` between slashes (or at either end)
+ * spans any number of directories.
+ */
+static bool glob_match(const char* pattern, size_t pattern_length, const char* text, size_t text_length) {
+    size_t p = 0;
+    size_t t = 0;
+
+    while (p < pattern_length) {
+        char c = pattern[p];
+
+        if (c == '*') {
+            bool segment_start = p == 0 || pattern[p - 1] == '/';
+            if (p + 1 < pattern_length && pattern[p + 1] == '*' && segment_start) {
+                size_t rest = p + 2;
+                if (rest == pattern_length) return true;    // Trailing `**` matches everything below
+
+                if (pattern[rest] == '/') {
+                    // `**/` matches zero or more whole directories
+                    rest++;
+                    if (glob_match(pattern + rest, pattern_length - rest, text + t, text_length - t)) return true;
+                    for (size_t k = t; k < text_length; k++) {
+                        if (text[k] == '/' &&
+                            glob_match(pattern + rest, pattern_length - rest, text + k + 1, text_length - k - 1)) {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+            }
+
+            // Any other run of stars is one `*`: try every split that stays within this segment
+            while (p < pattern_length && pattern[p] == '*') p++;
+            for (size_t k = t; ; k++) {
+                if (glob_match(pattern + p, pattern_length - p, text + k, text_length - k)) return true;
+                if (k >= text_length || text[k] == '/') return false;
+            }
+        }
+
+        if (t >= text_length) return false;
+
+        if (c == '?') {
+            if (text[t] == '/') return false;
+        } else if (c == '[') {
+            bool matched = false;
+            size_t next = match_class(pattern, pattern_length, p, text[t], &matched);
+            if (next > 0) {
+                if (!matched) return false;
+                p = next;
+                t++;
+                continue;
+            }
+            if (text[t] != '[') return false;   // Unterminated: a literal '['
+        } else {
+            if (c == '\\' && p + 1 < pattern_length) c = pattern[++p];
+            if (text[t] != c) return false;
+        }
+        p++;
+        t++;
+    }
+    return t == text_length;
+}
+
+// =============================================================================
+// COMPILING
+// =============================================================================
+
+/*
+ * Whether a pattern needs the wildcard matcher
+ */
+static bool has_wildcards(const char* pattern, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (pattern[i] == '*' || pattern[i] == '?' || pattern[i] == '[' || pattern[i] == '\\') return true;
+    }
+    return false;
+}
+
+/*
+ * Compile one line, already stripped of its newline, into `rule`
+ *
+ * `bool` - true if the line holds a pattern, false for blanks and comments
+ */
+static bool compile_rule(char* line, size_t length, MetisIgnoreRule_t* rule) {
+    if (length > 0 && line[length - 1] == '\r') length--;
+
+    // Trailing spaces are dropped unless escaped
+    while (length > 0 && line[length - 1] == ' ' && !(length > 1 && line[length - 2] == '\\')) length--;
+    if (length == 0 || line[0] == '#') return false;
+
+    memset(rule, 0, sizeof(*rule));
+    if (line[0] == '!') {
+        rule->negated = true;
+        line++;
+        length--;
+    } else if (line[0] == '\\' && length > 1 && (line[1] == '!' || line[1] == '#')) {
+        line++;
+        length--;
+    }
+
+    if (length > 0 && line[length - 1] == '/') {
+        rule->directory_only = true;
+        length--;
+    }
+    if (length > 0 && line[0] == '/') {
+        rule->anchored = true;
+        line++;
+        length--;
+    }
+    if (length == 0) return false;
+    if (memchr(line, '/', length)) rule->anchored = true;
+
+    rule->pattern = line;
+    rule->length = length;
+    if (!has_wildcards(line, length)) {
+        rule->kind = METIS_IGNORE_RULE_EXACT;
+    } else if (line[0] == '*' && length > 1 && !has_wildcards(line + 1, length - 1) && !rule->anchored) {
+        rule->kind = METIS_IGNORE_RULE_SUFFIX;
+    } else {
+        rule->kind = METIS_IGNORE_RULE_GLOB;
+    }
+    return true;
+}
+
+/*
+ * Compile .metisignore text into a pattern list
+ */
+MetisIgnore_t* metis_ignore_compile(const char* text, size_t length) {
+    if (!text || length == 0) return NULL;
+
+    MetisIgnore_t* ignore = calloc(1, sizeof(MetisIgnore_t));
+    if (!ignore) return NULL;
+
+    // Patterns point into one private copy of the text
+    ignore->text = malloc(length + 1);
+    int capacity = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] == '\n') capacity++;
+    }
+    ignore->rules = malloc(sizeof(MetisIgnoreRule_t) * (size_t)capacity);
+    if (!ignore->text || !ignore->rules) {
+        metis_ignore_free(ignore);
+        return NULL;
+    }
+    memcpy(ignore->text, text, length);
+    ignore->text[length] = '\0';
+
+    char* line = ignore->text;
+    char* end = ignore->text + length;
+    while (line < end) {
+        char* newline = memchr(line, '\n', (size_t)(end - line));
+        size_t line_length = newline ? (size_t)(newline - line) : (size_t)(end - line);
+        if (compile_rule(line, line_length, &ignore->rules[ignore->count])) ignore->count++;
+        line += line_length + 1;
+    }
+
+    if (ignore->count == 0) {
+        metis_ignore_free(ignore);
+        return NULL;
+    }
+    return ignore;
+}
+
+/*
+ * Read and compile the .metisignore in an open directory
+ */
+MetisIgnore_t* metis_ignore_load_at(int dir_fd) {
+    int fd = openat(dir_fd, METIS_IGNORE_FILE, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    size_t capacity = 4096;
+    size_t used = 0;
+    char* text = malloc(capacity);
+    while (text) {
+        if (used == capacity) {
+            char* grown = capacity < METIS_IGNORE_MAX_BYTES ? realloc(text, capacity * 2) : NULL;
+            if (!grown) {
+                free(text);
+                text = NULL;
+                break;
+            }
+            text = grown;
+            capacity *= 2;
+        }
+
+        ssize_t bytes_read = read(fd, text + used, capacity - used);
+        if (bytes_read < 0 && errno == EINTR) continue;
+        if (bytes_read <= 0) break;
+        used += (size_t)bytes_read;
+    }
+    close(fd);
+
+    MetisIgnore_t* ignore = text ? metis_ignore_compile(text, used) : NULL;
+    free(text);
+    return ignore;
+}
+
+// =============================================================================
+// MATCHING
+// =============================================================================
+
+/*
+ * Match a path against a pattern list
+ */
+MetisIgnoreMatch_t metis_ignore_match(const MetisIgnore_t* ignore, const char* relative_path, bool is_directory) {
+    if (!ignore || !relative_path) return METIS_IGNORE_NO_MATCH;
+
+    size_t path_length = strlen(relative_path);
+    const char* slash = strrchr(relative_path, '/');
+    const char* name = slash ? slash + 1 : relative_path;
+    size_t name_length = path_length - (size_t)(name - relative_path);
+
+    // The last matching pattern wins, so search from the bottom of the file up
+    for (int i = ignore->count - 1; i >= 0; i--) {
+        const MetisIgnoreRule_t* rule = &ignore->rules[i];
+        if (rule->directory_only && !is_directory) continue;
+
+        const char* subject = rule->anchored ? relative_path : name;
+        size_t subject_length = rule->anchored ? path_length : name_length;
+
+        bool matched;
+        switch (rule->kind) {
+            case METIS_IGNORE_RULE_EXACT:
+                matched = subject_length == rule->length && memcmp(subject, rule->pattern, rule->length) == 0;
+                break;
+            case METIS_IGNORE_RULE_SUFFIX:
+                matched = subject_length >= rule->length - 1 &&
+                          memcmp(subject + subject_length - (rule->length - 1), rule->pattern + 1, rule->length - 1) == 0;
+                break;
+            default:
+                matched = glob_match(rule->pattern, rule->length, subject, subject_length);
+                break;
+        }
+        if (matched) return rule->negated ? METIS_IGNORE_INCLUDED : METIS_IGNORE_EXCLUDED;
+    }
+    return METIS_IGNORE_NO_MATCH;
+}
+
+/*
+ * Free a pattern list
+ */
+void metis_ignore_free(MetisIgnore_t* ignore) {
+    if (!ignore) return;
+
+    free(ignore->rules);
+    free(ignore->text);
+    free(ignore);
+}
@@ -2,6 +2,7 @@
 // INSERT WISDOM HERE
 
 #define _POSIX_C_SOURCE 200809L  // For strdup
+#define _DEFAULT_SOURCE          // For d_type and DT_* in the directory walk
 
 #include "metis_linter.h"
 #include "metis_config.h"
@@ -9,14 +10,21 @@
 #include "metis_colors.h"
 #include "c_parser.h"
 #include "cross_reference.h"
+#include "cli_utils.h"
+#include "metis_ignore.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <ctype.h>
 #include <sys/stat.h>
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <unistd.h>
 
 // =============================================================================
 // DIVINE VIOLATION TRACKING
@@ -61,6 +69,7 @@ typedef struct ViolationList {
     LintViolation_t* violations;
     int count;
     int capacity;
+    Arena_t arena;          // Owns every violation's strings
 } ViolationList_t;
 
 // =============================================================================
@@ -82,6 +91,7 @@ static ViolationList_t* create_violation_list(void) {
 
     list->count = 0;
     list->capacity = 100;
+    list->arena = (Arena_t){0};
     return list;
 }
 
@@ -101,12 +111,19 @@ static void add_violation(ViolationList_t* list, const char* file_path, int line
         if (!list->violations) return;
     }
 
+    // Consecutive violations almost always share a path, so only a change of file is copied.
+    // The list outlives the parse cache run (findings are read after it ends), so no atoms
     LintViolation_t* v = &list->violations[list->count];
-    v->file_path = strdup(file_path);
+    LintViolation_t* previous = list->count > 0 ? &list->violations[list->count - 1] : NULL;
+    if (previous && previous->file_path && strcmp(previous->file_path, file_path) == 0) {
+        v->file_path = previous->file_path;
+    } else {
+        v->file_path = c_parser_arena_strdup(&list->arena, file_path);
+    }
     v->line_number = line_number;
     v->column = column;
-    v->violation_message = strdup(message);
-    v->suggestion = suggestion ? strdup(suggestion) : NULL;
+    v->violation_message = c_parser_arena_strdup(&list->arena, message);
+    v->suggestion = c_parser_arena_strdup(&list->arena, suggestion);
     v->type = type;
     v->severity = severity;
     list->count++;
@@ -118,17 +135,77 @@ static void add_violation(ViolationList_t* list, const char* file_path, int line
 static void free_violation_list(ViolationList_t* list) {
     if (!list) return;
 
-    for (int i = 0; i < list->count; i++) {
-        free(list->violations[i].file_path);
-        free(list->violations[i].violation_message);
-        if (list->violations[i].suggestion) {
-            free(list->violations[i].suggestion);
-        }
-    }
+    c_parser_arena_release(&list->arena);
     free(list->violations);
     free(list);
 }
 
+/*
+ * Move every violation from `src` to the end of `dst`, then free `src`
+ */
+static void move_violations(ViolationList_t* dst, ViolationList_t* src) {
+    if (!src) return;
+    if (!dst) {
+        free_violation_list(src);
+        return;
+    }
+
+    if (dst->count + src->count > dst->capacity) {
+        int capacity = dst->capacity;
+        while (capacity < dst->count + src->count) capacity *= 2;
+        LintViolation_t* grown = realloc(dst->violations, sizeof(LintViolation_t) * capacity);
+        if (!grown) {
+            free_violation_list(src);
+            return;
+        }
+        dst->violations = grown;
+        dst->capacity = capacity;
+    }
+
+    // The strings change hands with the structs, along with the arena holding them
+    memcpy(dst->violations + dst->count, src->violations, sizeof(LintViolation_t) * src->count);
+    dst->count += src->count;
+    c_parser_arena_adopt(&dst->arena, &src->arena);
+    free(src->violations);
+    free(src);
+}
+
+// =============================================================================
+// PER-FILE ANALYSIS RESULTS
+// =============================================================================
+
+/*
+ * Everything analyzing one file produces, kept until the main thread reports it
+ *
+ * Analysis itself neither prints nor touches the fragment engine, so it can run
+ * on any thread; report_file_analysis() replays the result in serial order.
+ */
+typedef struct {
+    const char* file_path;              // File analyzed (not owned)
+    bool readable;                      // false if the file could not be opened
+    ViolationList_t* violations;        // NULL if the list could not be allocated
+    UnsafeStrcmpUsage_t* strcmp_usages; // Pending contextual fragments, in detection order
+    int strcmp_usage_count;
+    char* output;                       // Text printed during analysis (cross-reference findings)
+    size_t output_length;
+} FileAnalysis_t;
+
+/*
+ * Free a file analysis result
+ */
+static void free_file_analysis(FileAnalysis_t* analysis) {
+    if (!analysis) return;
+
+    free_violation_list(analysis->violations);
+    free(analysis->strcmp_usages);
+    free(analysis->output);
+    analysis->violations = NULL;
+    analysis->strcmp_usages = NULL;
+    analysis->strcmp_usage_count = 0;
+    analysis->output = NULL;
+    analysis->output_length = 0;
+}
+
 // =============================================================================
 // DIVINE DOCUMENTATION ANALYSIS
 // =============================================================================
@@ -190,7 +267,7 @@ static int check_function_docs_with_parser(ParsedFile_t* parsed, ViolationList_t
             continue;
         }
 
-        if (!c_parser_has_documentation_for_function(parsed, func->name)) {
+        if (!func->has_documentation) {
             char message[128];
             snprintf(message, sizeof(message),
                     "Function '%s' lacks documentation", func->name);
@@ -207,125 +284,198 @@ static int check_function_docs_with_parser(ParsedFile_t* parsed, ViolationList_t
 }
 
 // =============================================================================
-// DAEDALUS OPPORTUNITY DETECTION
+// TOKEN RULE ENGINE
 // =============================================================================
 
 /*
- * Check for dangerous functions with token-level precision
+ * Token events a rule can register interest in
  */
-static int check_daedalus_with_parser(ParsedFile_t* parsed, ViolationList_t* violations) {
-    if (!parsed || !violations) return 0;
+typedef enum {
+    RULE_EVENT_CALL,        // Call expression, from the parser's call table
+    RULE_EVENT_COMMENT,     // Line or block comment
+    RULE_EVENT_KEYWORD,     // C keyword
+    RULE_EVENT_BRACE,       // '{' or '}'
+    RULE_EVENT_COUNT
+} RuleEvent_t;
 
-    int issues_found = 0;
-    const char* file_path = parsed->file_path;
+#define RULE_EVENT_BIT(event) (1u << (event))
 
-    // Check for dangerous function usage in tokens
-    for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
+/*
+ * One rule's view of the file while the sweep runs
+ */
+typedef struct {
+    ParsedFile_t* parsed;
+    FileAnalysis_t* analysis;       // For results other than violations
+    const CallSite_t* call;         // Call being visited, for RULE_EVENT_CALL
+    ViolationList_t* violations;    // Created on the rule's first finding
+    int issues_found;
+} RuleContext_t;
 
-        if (token->type == TOKEN_IDENTIFIER &&
-            c_parser_is_dangerous_function(token->value)) {
+/*
+ * A token-level rule: called for every token raising one of its events
+ */
+typedef struct {
+    const char* name;
+    unsigned events;                                    // RULE_EVENT_BIT() mask
+    void (*visit)(RuleContext_t* ctx, int token_index);
+} TokenRule_t;
 
-            // Make sure it's a function call (next token should be '(')
-            if (i + 1 < parsed->token_count &&
-                parsed->tokens[i + 1].type == TOKEN_PUNCTUATION &&
-                strcmp(parsed->tokens[i + 1].value, "(") == 0) {
+/*
+ * Record a rule finding at a token
+ */
+static void rule_add_violation(RuleContext_t* ctx, int line, int column, const char* message,
+                               const char* suggestion, ViolationType_t type, Severity_t severity) {
+    if (!ctx->violations) {
+        ctx->violations = create_violation_list();
+        if (!ctx->violations) return;
+    }
+    add_violation(ctx->violations, ctx->parsed->file_path, line, column,
+                  message, suggestion, type, severity);
+    ctx->issues_found++;
+}
 
-                char message[128];
-                snprintf(message, sizeof(message),
-                        "Unsafe function '%s()' detected", token->value);
-
-                const char* suggestion = NULL;
-
-                // Provide specific Daedalus suggestions with divine precision
-                if (strcmp(token->value, "malloc") == 0) {
-                    suggestion = "Use d_InitArray() for dynamic growth or d_InitStaticArray() for fixed capacity";
-                } else if (strcmp(token->value, "realloc") == 0) {
-                    suggestion = "Use d_ResizeArray() or d_GrowArray() for safe memory expansion";
-                } else if (strcmp(token->value, "free") == 0) {
-                    suggestion = "Use d_DestroyArray() or d_DestroyStaticArray() for automatic cleanup";
-                } else if (strcmp(token->value, "calloc") == 0) {
-                    suggestion = "Use d_InitArray() which zero-initializes elements automatically";
-                    
-                // String Function Replacements
-                } else if (strcmp(token->value, "strcpy") == 0) {
-                    suggestion = "Use d_SetString() or d_AppendString() for safe string assignment";
-                } else if (strcmp(token->value, "strncpy") == 0) {
-                    suggestion = "Use d_SetString() or d_AppendStringN() for bounded string copying";
-                } else if (strcmp(token->value, "strcat") == 0) {
-                    suggestion = "Use d_AppendString() for safe string concatenation";
-                } else if (strcmp(token->value, "strncat") == 0) {
-                    suggestion = "Use d_AppendStringN() for bounded string concatenation";
-                } else if (strcmp(token->value, "strcmp") == 0) {
-                    suggestion = "Use d_CompareStrings() or d_CompareStringToCString() for dString_t objects";
-                } else if (strcmp(token->value, "strncmp") == 0) {
-                    suggestion = "Use d_CompareStrings() with d_SliceString() for bounded comparison";
-                } else if (strcmp(token->value, "strlen") == 0) {
-                    suggestion = "Use d_GetStringLength() for dString_t objects";
-                } else if (strcmp(token->value, "strdup") == 0) {
-                    suggestion = "Create new dString_t with d_InitString() and d_SetString()";
-
-                // Printf Family Replacements  
-                } else if (strcmp(token->value, "printf") == 0) {
-                    suggestion = "Use d_LogInfoF() for structured, filterable output";
-                } else if (strcmp(token->value, "fprintf") == 0) {
-                    suggestion = "Use d_LogInfoF() with file handlers or d_FormatString() to dString_t";
-                } else if (strcmp(token->value, "sprintf") == 0) {
-                    suggestion = "Use d_FormatString() for safe string formatting";
-                } else if (strcmp(token->value, "snprintf") == 0) {
-                    suggestion = "Use d_FormatString() which automatically manages buffer size";
-                } else if (strcmp(token->value, "vprintf") == 0) {
-                    suggestion = "Use Daedalus logging system with d_LogF() variants";
-                } else if (strcmp(token->value, "vsprintf") == 0) {
-                    suggestion = "Use d_FormatString() which handles variadic arguments safely";
-
-                // Input Function Replacements
-                } else if (strcmp(token->value, "gets") == 0) {
-                    suggestion = "Use d_AppendString() with safe input validation";
-                } else if (strcmp(token->value, "fgets") == 0) {
-                    suggestion = "Use d_CreateStringFromFile() or d_AppendString() with bounds checking";
-                } else if (strcmp(token->value, "scanf") == 0) {
-                    suggestion = "Use d_LogDebugF() for debugging and proper input validation";
-                } else if (strcmp(token->value, "sscanf") == 0) {
-                    suggestion = "Use d_SplitString() and d_CompareStringToCString() for parsing";
-
-                // File Operations
-                } else if (strcmp(token->value, "fopen") == 0) {
-                    suggestion = "Consider d_CreateStringFromFile() for simple file reading";
-                } else if (strcmp(token->value, "tmpnam") == 0 || strcmp(token->value, "tempnam") == 0) {
-                    suggestion = "Use secure temporary file creation with proper cleanup";
-
-                // Memory Functions
-                } else if (strcmp(token->value, "memcpy") == 0) {
-                    suggestion = "Use d_AppendString() for string data or verify bounds manually";
-                } else if (strcmp(token->value, "memmove") == 0) {
-                    suggestion = "Use d_SliceString() and d_AppendString() for string manipulation";
-                } else if (strcmp(token->value, "memset") == 0) {
-                    suggestion = "Use d_ClearString() for string data or d_InitArray() for zero-initialization";
-
-                // Array/Buffer Operations
-                } else if (strcmp(token->value, "qsort") == 0) {
-                    suggestion = "Use d_SortArray() or d_SortStaticArray() with built-in comparison functions";
-                } else if (strcmp(token->value, "bsearch") == 0) {
-                    suggestion = "Use d_FindInArray() or d_FindInStaticArray() with sorted arrays";
-
-                // Character Classification (less critical but worth mentioning)
-                } else if (strstr(token->value, "to") == token->value && strlen(token->value) > 2) {
-                    // toupper, tolower, etc.
-                    suggestion = "Consider using d_FormatString() with format specifiers for case conversion";
+/*
+ * The sweep event a token raises, or RULE_EVENT_COUNT if it raises none
+ *
+ * Calls are not swept; they come from the call table the parser already built.
+ */
+static RuleEvent_t token_rule_event(const TokenStore_t* ts, int i) {
+    switch (ts->kinds[i]) {
+        case TOKEN_COMMENT_LINE:
+        case TOKEN_COMMENT_BLOCK:
+            return RULE_EVENT_COMMENT;
+        case TOKEN_KEYWORD:
+            return RULE_EVENT_KEYWORD;
+        case TOKEN_PUNCTUATION:
+            if (ts->sub_kinds[i] == PUNCT_LBRACE || ts->sub_kinds[i] == PUNCT_RBRACE) {
+                return RULE_EVENT_BRACE;
+            }
+            return RULE_EVENT_COUNT;
+        default:
+            return RULE_EVENT_COUNT;
+    }
+}
 
-                } else {
-                    suggestion = "Consider using Daedalus library alternatives for safety";
-                }
+// =============================================================================
+// DAEDALUS OPPORTUNITY DETECTION
+// =============================================================================
 
-                add_violation(violations, file_path, token->line, token->column,
-                            message, suggestion, DAEDALUS_SUGGESTION, SEVERITY_INFO);
-                issues_found++;
-            }
-        }
+/*
+ * Flag calls to dangerous functions that Daedalus has safer replacements for
+ */
+static void visit_daedalus_call(RuleContext_t* ctx, int i) {
+    ParsedFile_t* parsed = ctx->parsed;
+
+    // The parser resolved the callee against the dangerous set when it recorded the call
+    CDangerousFunctionId_t dangerous = ctx->call->dangerous_id;
+    if (dangerous == C_DANGEROUS_NONE) return;
+
+    Token_t token = c_parser_token_at(parsed, i);
+    char message[128];
+    snprintf(message, sizeof(message),
+            "Unsafe function '%.*s()' detected",
+            token.length, c_parser_token_text(parsed->source, &token));
+
+    const char* suggestion = NULL;
+
+    // Provide specific Daedalus suggestions with divine precision
+    switch (dangerous) {
+        // Memory Management Replacements
+        case C_DANGEROUS_MALLOC:
+            suggestion = "Use d_InitArray() for dynamic growth or d_InitStaticArray() for fixed capacity";
+            break;
+        case C_DANGEROUS_REALLOC:
+            suggestion = "Use d_ResizeArray() or d_GrowArray() for safe memory expansion";
+            break;
+        case C_DANGEROUS_FREE:
+            suggestion = "Use d_DestroyArray() or d_DestroyStaticArray() for automatic cleanup";
+            break;
+        case C_DANGEROUS_CALLOC:
+            suggestion = "Use d_InitArray() which zero-initializes elements automatically";
+            break;
+
+        // String Function Replacements
+        case C_DANGEROUS_STRCPY:
+            suggestion = "Use d_SetString() or d_AppendString() for safe string assignment";
+            break;
+        case C_DANGEROUS_STRNCPY:
+            suggestion = "Use d_SetString() or d_AppendStringN() for bounded string copying";
+            break;
+        case C_DANGEROUS_STRCAT:
+            suggestion = "Use d_AppendString() for safe string concatenation";
+            break;
+        case C_DANGEROUS_STRNCAT:
+            suggestion = "Use d_AppendStringN() for bounded string concatenation";
+            break;
+        case C_DANGEROUS_STRLEN:
+            suggestion = "Use d_GetStringLength() for dString_t objects";
+            break;
+
+        // Printf Family Replacements
+        case C_DANGEROUS_PRINTF:
+            suggestion = "Use d_LogInfoF() for structured, filterable output";
+            break;
+        case C_DANGEROUS_FPRINTF:
+            suggestion = "Use d_LogInfoF() with file handlers or d_FormatString() to dString_t";
+            break;
+        case C_DANGEROUS_SPRINTF:
+            suggestion = "Use d_FormatString() for safe string formatting";
+            break;
+        case C_DANGEROUS_SNPRINTF:
+            suggestion = "Use d_FormatString() which automatically manages buffer size";
+            break;
+        case C_DANGEROUS_VSPRINTF:
+            suggestion = "Use d_FormatString() which handles variadic arguments safely";
+            break;
+
+        // Input Function Replacements
+        case C_DANGEROUS_GETS:
+            suggestion = "Use d_AppendString() with safe input validation";
+            break;
+
+        default:
+            suggestion = "Consider using Daedalus library alternatives for safety";
+            break;
     }
 
-    return issues_found;
+    rule_add_violation(ctx, token.line, token.column, message, suggestion,
+                       DAEDALUS_SUGGESTION, SEVERITY_INFO);
+}
+
+/*
+ * Flag strcmp on a dString_t's str member and keep the usage for contextual fragments
+ */
+static void visit_unsafe_strcmp_call(RuleContext_t* ctx, int i) {
+    UnsafeStrcmpUsage_t usage;
+    if (!c_parser_match_unsafe_strcmp(ctx->parsed, i, &usage)) return;
+
+    FileAnalysis_t* analysis = ctx->analysis;
+    UnsafeStrcmpUsage_t* usages = realloc(analysis->strcmp_usages,
+                                          sizeof(UnsafeStrcmpUsage_t) * (analysis->strcmp_usage_count + 1));
+    if (!usages) return;
+    usages[analysis->strcmp_usage_count++] = usage;
+    analysis->strcmp_usages = usages;
+
+    char message[256];
+    char suggestion[512];
+
+    if (usage.is_dstring_vs_cstring) {
+        snprintf(message, sizeof(message), "Unsafe `strcmp` with `dString_t->str` and C-string detected");
+        snprintf(suggestion, sizeof(suggestion), "Replace `strcmp(%s, %s)` with `d_CompareStringToCString(%s, %s)`", 
+                usage.variable1, usage.variable2,
+                usage.variable1, usage.variable2);
+    } else if (usage.is_dstring_vs_dstring) {
+        snprintf(message, sizeof(message), "Unsafe `strcmp` between two `dString_t` objects detected");
+        snprintf(suggestion, sizeof(suggestion), "Replace `strcmp(%s, %s)` with `d_CompareStrings(%s, %s)`", 
+                usage.variable1, usage.variable2,
+                usage.variable1, usage.variable2);
+    } else {
+        snprintf(message, sizeof(message), "Unsafe `strcmp` usage with `dString_t->str` detected");
+        snprintf(suggestion, sizeof(suggestion), "Consider using `d_CompareStrings()` or `d_CompareStringToCString()`");
+    }
+
+    rule_add_violation(ctx, usage.line, usage.column, message, suggestion,
+                       DAEDALUS_SUGGESTION, SEVERITY_WARNING);
 }
 
 // =============================================================================
@@ -333,44 +483,31 @@ static int check_daedalus_with_parser(ParsedFile_t* parsed, ViolationList_t* vio
 // =============================================================================
 
 /*
- * Check for philosophical violations in comments
+ * Flag philosophical markers (TODO, FIXME, ...) in a comment
  */
-static int check_philosophy_with_parser(ParsedFile_t* parsed, ViolationList_t* violations) {
-    if (!parsed || !violations) return 0;
-
-    int issues_found = 0;
-    const char* file_path = parsed->file_path;
-
-    // Check comment tokens for philosophical markers
-    for (int i = 0; i < parsed->token_count; i++) {
-        Token_t* token = &parsed->tokens[i];
-
-        if (token->type == TOKEN_COMMENT_LINE || token->type == TOKEN_COMMENT_BLOCK) {
-            struct WisdomPattern {
-                const char* pattern;
-                const char* message;
-                const char* suggestion;
-            } patterns[] = {
-                {"TODO", "TODO comment found", "Consider creating a proper issue or fixing immediately"},
-                {"FIXME", "FIXME comment found", "This indicates known broken code - prioritize fixing"},
-                {"HACK", "HACK comment found", "Replace this hack with a proper solution"},
-                {"XXX", "XXX marker found", "This usually indicates problematic code"},
-                {NULL, NULL, NULL}
-            };
-
-            for (int j = 0; patterns[j].pattern; j++) {
-                if (strstr(token->value, patterns[j].pattern)) {
-                    add_violation(violations, file_path, token->line, token->column,
-                                patterns[j].message, patterns[j].suggestion,
-                                PHILOSOPHICAL_VIOLATION, SEVERITY_INFO);
-                    issues_found++;
-                    break; // Only report one pattern per comment
-                }
-            }
+static void visit_philosophy_comment(RuleContext_t* ctx, int i) {
+    ParsedFile_t* parsed = ctx->parsed;
+    Token_t token = c_parser_token_at(parsed, i);
+    static const struct WisdomPattern {
+        const char* pattern;
+        const char* message;
+        const char* suggestion;
+    } patterns[] = {
+        {"TODO", "TODO comment found", "Consider creating a proper issue or fixing immediately"},
+        {"FIXME", "FIXME comment found", "This indicates known broken code - prioritize fixing"},
+        {"HACK", "HACK comment found", "Replace this hack with a proper solution"},
+        {"XXX", "XXX marker found", "This usually indicates problematic code"},
+        {NULL, NULL, NULL}
+    };
+
+    for (int j = 0; patterns[j].pattern; j++) {
+        if (c_parser_token_contains(parsed->source, &token, patterns[j].pattern)) {
+            rule_add_violation(ctx, token.line, token.column,
+                               patterns[j].message, patterns[j].suggestion,
+                               PHILOSOPHICAL_VIOLATION, SEVERITY_INFO);
+            break; // Only report one pattern per comment
         }
     }
-
-    return issues_found;
 }
 
 /*
@@ -381,12 +518,16 @@ static int check_complexity_wisdom(ParsedFile_t* parsed, ViolationList_t* violat
 
     int issues_found = 0;
     const char* file_path = parsed->file_path;
+    if (parsed->function_count == 0) return 0;
+
+    // Measure every function in one pass over their bodies, then judge each
+    ComplexityAnalysis_t* analyses = malloc(sizeof(ComplexityAnalysis_t) * parsed->function_count);
+    if (!analyses) return 0;
+    c_parser_analyze_all_function_complexity(parsed, analyses);
 
-    // Analyze each function for complexity
     for (int i = 0; i < parsed->function_count; i++) {
         FunctionInfo_t* func = &parsed->functions[i];
-
-        ComplexityAnalysis_t analysis = c_parser_analyze_function_complexity(parsed, func->name);
+        ComplexityAnalysis_t analysis = analyses[i];
 
         // Check for overly complex functions
         if (analysis.complexity_score > 10) {
@@ -431,6 +572,75 @@ static int check_complexity_wisdom(ParsedFile_t* parsed, ViolationList_t* violat
         }
     }
 
+    free(analyses);
+    return issues_found;
+}
+
+// =============================================================================
+// FUSED RULE SWEEP
+// =============================================================================
+
+/*
+ * Token-level rules, in reporting order; a new rule adds a row here, not a pass
+ */
+static const TokenRule_t TOKEN_RULES[] = {
+    { "daedalus",      RULE_EVENT_BIT(RULE_EVENT_CALL),    visit_daedalus_call },
+    { "unsafe-strcmp", RULE_EVENT_BIT(RULE_EVENT_CALL),    visit_unsafe_strcmp_call },
+    { "philosophy",    RULE_EVENT_BIT(RULE_EVENT_COMMENT), visit_philosophy_comment },
+};
+
+#define TOKEN_RULE_COUNT ((int)(sizeof(TOKEN_RULES) / sizeof(TOKEN_RULES[0])))
+
+/*
+ * Run every token rule over the file in a single sweep
+ *
+ * Call rules walk the parser's call table; the other events share one token
+ * sweep, skipped entirely when no rule wants it. Each rule's findings are kept
+ * apart and appended in table order afterwards, so reports read rule by rule.
+ */
+static int run_token_rules(ParsedFile_t* parsed, FileAnalysis_t* analysis) {
+    if (!parsed || !analysis) return 0;
+
+    RuleContext_t contexts[TOKEN_RULE_COUNT];
+    int dispatch[RULE_EVENT_COUNT][TOKEN_RULE_COUNT];
+    int dispatch_count[RULE_EVENT_COUNT] = {0};
+    unsigned swept_events = 0;
+
+    for (int r = 0; r < TOKEN_RULE_COUNT; r++) {
+        contexts[r] = (RuleContext_t){ .parsed = parsed, .analysis = analysis };
+        for (int event = 0; event < RULE_EVENT_COUNT; event++) {
+            if (TOKEN_RULES[r].events & RULE_EVENT_BIT(event)) {
+                dispatch[event][dispatch_count[event]++] = r;
+                if (event != RULE_EVENT_CALL) swept_events |= RULE_EVENT_BIT(event);
+            }
+        }
+    }
+
+    for (int c = 0; c < parsed->call_count && dispatch_count[RULE_EVENT_CALL] > 0; c++) {
+        const CallSite_t* call = &parsed->calls[c];
+        for (int d = 0; d < dispatch_count[RULE_EVENT_CALL]; d++) {
+            int r = dispatch[RULE_EVENT_CALL][d];
+            contexts[r].call = call;
+            TOKEN_RULES[r].visit(&contexts[r], call->token_index);
+        }
+    }
+
+    const TokenStore_t* ts = &parsed->token_store;
+    for (int i = 0; i < ts->count && swept_events != 0; i++) {
+        RuleEvent_t event = token_rule_event(ts, i);
+        if (event == RULE_EVENT_COUNT) continue;
+
+        for (int d = 0; d < dispatch_count[event]; d++) {
+            int r = dispatch[event][d];
+            TOKEN_RULES[r].visit(&contexts[r], i);
+        }
+    }
+
+    int issues_found = 0;
+    for (int r = 0; r < TOKEN_RULE_COUNT; r++) {
+        move_violations(analysis->violations, contexts[r].violations);
+        issues_found += contexts[r].issues_found;
+    }
     return issues_found;
 }
 
@@ -456,8 +666,8 @@ static int check_header_doc_format_with_parser(ParsedFile_t* parsed, ViolationLi
             continue;
         }
 
-        if (c_parser_has_documentation_for_function(parsed, func->name)) {
-            if (!c_parser_has_proper_header_doc_format(parsed, func->name)) {
+        if (func->has_documentation) {
+            if (!c_parser_function_has_proper_doc_format(parsed, func)) {
                 char message[256];
                 snprintf(message, sizeof(message),
                         "Function '%s' documentation violates one-line format",
@@ -481,66 +691,52 @@ static char* find_header_file(const char* c_file_path) {
     if (!c_file_path) return NULL;
 
     // Extract directory and base name
-    char* last_slash = strrchr(c_file_path, '/');
+    const char* last_slash = strrchr(c_file_path, '/');
     if (!last_slash) last_slash = strrchr(c_file_path, '\\');
 
     const char* base_name = last_slash ? last_slash + 1 : c_file_path;
+    size_t dir_len = last_slash ? (size_t)(last_slash - c_file_path) + 1 : 0;
 
     // Remove .c extension
-    char base_no_ext[256];
-    strncpy(base_no_ext, base_name, sizeof(base_no_ext) - 1);
-    base_no_ext[sizeof(base_no_ext) - 1] = '\0';
-
-    char* dot = strrchr(base_no_ext, '.');
-    if (dot) *dot = '\0';
-
-    // Try include/ directory first
-    char include_path[512];
-    if (last_slash) {
-        // Extract directory part
-        int dir_len = last_slash - c_file_path + 1;
-        strncpy(include_path, c_file_path, dir_len);
-        include_path[dir_len] = '\0';
-
-        // Go up one level and try include/
-        char* parent_slash = include_path + dir_len - 2; // Back up before the trailing slash
-        while (parent_slash > include_path && *parent_slash != '/' && *parent_slash != '\\') {
-            parent_slash--;
-        }
-        if (parent_slash > include_path) {
-            parent_slash[1] = '\0'; // Keep the slash
-            strcat(include_path, "include/");
-            strcat(include_path, base_no_ext);
-            strcat(include_path, ".h");
-
-            // Check if this file exists
-            FILE* test = fopen(include_path, "r");
-            if (test) {
-                fclose(test);
-                return strdup(include_path);
-            }
+    const char* dot = strrchr(base_name, '.');
+    size_t base_len = dot ? (size_t)(dot - base_name) : strlen(base_name);
+
+    // Sized for the longest candidate, so deep paths are never truncated
+    char* candidate = malloc(dir_len + sizeof("include/") - 1 + base_len + sizeof(".h"));
+    if (!candidate) return NULL;
+
+    // Try include/ directory first: go up one level from the source's directory
+    size_t parent_len = dir_len >= 2 ? dir_len - 2 : 0;
+    while (parent_len > 0 && c_file_path[parent_len] != '/' && c_file_path[parent_len] != '\\') {
+        parent_len--;
+    }
+    if (parent_len > 0) {
+        memcpy(candidate, c_file_path, parent_len + 1); // Keep the slash
+        memcpy(candidate + parent_len + 1, "include/", sizeof("include/") - 1);
+        memcpy(candidate + parent_len + sizeof("include/"), base_name, base_len);
+        memcpy(candidate + parent_len + sizeof("include/") + base_len, ".h", sizeof(".h"));
+
+        // Check if this file exists
+        FILE* test = fopen(candidate, "r");
+        if (test) {
+            fclose(test);
+            return candidate;
         }
     }
 
     // Try same directory as source file
-    char same_dir_path[512];
-    if (last_slash) {
-        int dir_len = last_slash - c_file_path + 1;
-        strncpy(same_dir_path, c_file_path, dir_len);
-        same_dir_path[dir_len] = '\0';
-        strcat(same_dir_path, base_no_ext);
-        strcat(same_dir_path, ".h");
-    } else {
-        snprintf(same_dir_path, sizeof(same_dir_path), "%s.h", base_no_ext);
-    }
+    memcpy(candidate, c_file_path, dir_len);
+    memcpy(candidate + dir_len, base_name, base_len);
+    memcpy(candidate + dir_len + base_len, ".h", sizeof(".h"));
 
     // Check if this file exists
-    FILE* test = fopen(same_dir_path, "r");
+    FILE* test = fopen(candidate, "r");
     if (test) {
         fclose(test);
-        return strdup(same_dir_path);
+        return candidate;
     }
 
+    free(candidate);
     return NULL; // No header file found
 }
 
@@ -562,8 +758,8 @@ static int check_corresponding_header_format(const char* c_file_path, ViolationL
         return 0; // No header file found, that's okay
     }
 
-    // Parse the header file
-    ParsedFile_t* header_parsed = c_parser_parse_file(header_path);
+    // Parse the header file, or share the parse if another file already needed it
+    ParsedFile_t* header_parsed = c_parser_acquire_file(header_path);
     if (!header_parsed) {
         free(header_path);
         return 0;
@@ -578,8 +774,8 @@ static int check_corresponding_header_format(const char* c_file_path, ViolationL
         // Skip static functions in headers (shouldn't be there anyway)
         if (func->is_static) continue;
 
-        if (c_parser_has_documentation_for_function(header_parsed, func->name)) {
-            if (!c_parser_has_proper_header_doc_format(header_parsed, func->name)) {
+        if (func->has_documentation) {
+            if (!c_parser_function_has_proper_doc_format(header_parsed, func)) {
                 char message[256];
                 snprintf(message, sizeof(message),
                         "Function '%s' header documentation violates one-line format (in %s)",
@@ -594,19 +790,62 @@ static int check_corresponding_header_format(const char* c_file_path, ViolationL
         }
     }
 
-    c_parser_free_parsed_file(header_parsed);
+    c_parser_release_file(header_parsed);
     free(header_path);
     return issues_found;
 }
 
+/*
+ * Fragment engine violation type for an unsafe strcmp usage
+ */
+static const char* strcmp_violation_type(const UnsafeStrcmpUsage_t* usage) {
+    if (usage->is_dstring_vs_cstring) return "unsafe_strcmp_dstring_cstring";
+    if (usage->is_dstring_vs_dstring) return "unsafe_strcmp_dstring_dstring";
+    return "unsafe_strcmp_generic";
+}
+
+/*
+ * Cross-reference a parsed .c file against its header, adding findings as violations
+ *
+ * Findings with only a header line are about the header, so they are located there.
+ */
+static int add_cross_reference_violations(const char* file_path, ParsedFile_t* parsed, ViolationList_t* violations) {
+    XRefViolationList_t* xref_violations = cross_reference_check_parsed(file_path, parsed);
+    if (!xref_violations) return 0;
+
+    char* header_path = NULL;
+    int count = xref_violations->violation_count;
+    for (int i = 0; i < count; i++) {
+        const XRefViolation_t* xref = &xref_violations->violations[i];
+        int line = xref->impl_line > 0 ? xref->impl_line : xref->header_line;
+
+        const char* location = file_path;
+        if (xref->impl_line <= 0 && xref->header_line > 0) {
+            if (!header_path) header_path = cross_reference_find_header_file(file_path);
+            if (header_path) location = header_path;
+        }
+
+        // Same categories the printed form uses: doc mismatches are Docs/info, the rest Header/warning
+        bool docs = xref->violation_type == XREF_DOC_INCONSISTENCY;
+        add_violation(violations, location, line > 0 ? line : 1, 1, xref->description, NULL,
+                      docs ? DOCS_VIOLATION : HEADER_VIOLATION, docs ? SEVERITY_INFO : SEVERITY_WARNING);
+    }
+    free(header_path);
+    cross_reference_free_violations(xref_violations);
+    return count;
+}
+
 /*
  * Analyze file content using divine parser wisdom
+ *
+ * `parsed` is NULL when the file could be read but not parsed.
+ * Anything printed goes to `out`, and contextual fragments are left in `analysis`.
+ * With `out` NULL nothing is printed: cross-reference findings become violations.
  */
-static int analyze_file_content(const char* file_path, const char* content, ViolationList_t* violations) {
-    if (!file_path || !content || !violations) return 0;
+static int analyze_file_content(const char* file_path, ParsedFile_t* parsed, FileAnalysis_t* analysis, FILE* out) {
+    if (!file_path || !analysis || !analysis->violations) return 0;
+    ViolationList_t* violations = analysis->violations;
 
-    // Parse the content using the divine C parser
-    ParsedFile_t* parsed = c_parser_parse_content(content, file_path);
     if (!parsed) {
         // If parsing fails, we can't do much analysis
         char message[256];
@@ -635,104 +874,25 @@ static int analyze_file_content(const char* file_path, const char* content, Viol
     // (This check remains as it correctly targets .c files looking for their .h counterparts)
     issues_found += check_corresponding_header_format(file_path, violations);
 
-    // Enhanced Daedalus opportunities detection
-    issues_found += check_daedalus_with_parser(parsed, violations);
-
-    // New: Check for unsafe strcmp(dString_t->str, ...) usage with enhanced contextual fragments
-    UnsafeStrcmpUsage_t* unsafe_strcmp_usages = NULL;
-    int unsafe_strcmp_count = 0;
-    if (c_parser_detect_unsafe_strcmp_dstring_usage(parsed, &unsafe_strcmp_usages, &unsafe_strcmp_count)) {
-        for (int i = 0; i < unsafe_strcmp_count; i++) {
-            char message[256];
-            char suggestion[512];
-            const char* violation_type = "unsafe_strcmp_generic";
-            
-            if (unsafe_strcmp_usages[i].is_dstring_vs_cstring) {
-                snprintf(message, sizeof(message), "Unsafe `strcmp` with `dString_t->str` and C-string detected");
-                snprintf(suggestion, sizeof(suggestion), "Replace `strcmp(%s, %s)` with `d_CompareStringToCString(%s, %s)`", 
-                        unsafe_strcmp_usages[i].variable1, unsafe_strcmp_usages[i].variable2,
-                        unsafe_strcmp_usages[i].variable1, unsafe_strcmp_usages[i].variable2);
-                violation_type = "unsafe_strcmp_dstring_cstring";
-            } else if (unsafe_strcmp_usages[i].is_dstring_vs_dstring) {
-                snprintf(message, sizeof(message), "Unsafe `strcmp` between two `dString_t` objects detected");
-                snprintf(suggestion, sizeof(suggestion), "Replace `strcmp(%s, %s)` with `d_CompareStrings(%s, %s)`", 
-                        unsafe_strcmp_usages[i].variable1, unsafe_strcmp_usages[i].variable2,
-                        unsafe_strcmp_usages[i].variable1, unsafe_strcmp_usages[i].variable2);
-                violation_type = "unsafe_strcmp_dstring_dstring";
-            } else {
-                snprintf(message, sizeof(message), "Unsafe `strcmp` usage with `dString_t->str` detected");
-                snprintf(suggestion, sizeof(suggestion), "Consider using `d_CompareStrings()` or `d_CompareStringToCString()`");
-            }
-            
-            add_violation(violations, file_path, unsafe_strcmp_usages[i].line, unsafe_strcmp_usages[i].column,
-                          message, suggestion, DAEDALUS_SUGGESTION, SEVERITY_WARNING);
-            issues_found++;
-            
-            // Deliver enhanced contextual fragment for this specific unsafe strcmp pattern
-            FragmentContext_t fragment_context = {
-                .variable1 = unsafe_strcmp_usages[i].variable1,
-                .variable2 = unsafe_strcmp_usages[i].variable2,
-                .function_name = unsafe_strcmp_usages[i].function_name,
-                .file_name = file_path,
-                .violation_type = violation_type
-            };
-            metis_deliver_contextual_fragment(&fragment_context);
-        }
-        free(unsafe_strcmp_usages);
-    }
-
-    // Enhanced philosophical wisdom analysis
-    issues_found += check_philosophy_with_parser(parsed, violations);
+    // Daedalus opportunities, unsafe strcmp(dString_t->str, ...) and philosophical markers
+    // share one token sweep; strcmp usages stay in `analysis` for contextual fragments
+    free(analysis->strcmp_usages);
+    analysis->strcmp_usages = NULL;
+    analysis->strcmp_usage_count = 0;
+    issues_found += run_token_rules(parsed, analysis);
 
     // Complexity wisdom analysis
     issues_found += check_complexity_wisdom(parsed, violations);
 
     // Cross-reference analysis for .c files (check against their headers)  
     if (ext && strcmp(ext, ".c") == 0) {
-        issues_found += cross_reference_analyze_file(file_path, violations);
+        issues_found += out ? cross_reference_analyze_file_to(file_path, violations, out)
+                            : add_cross_reference_violations(file_path, parsed, violations);
     }
 
-    c_parser_free_parsed_file(parsed);
     return issues_found;
 }
 
-/*
- * Read file content with compassionate error handling
- */
-static char* read_file_content(const char* file_path) {
-    FILE* file = fopen(file_path, "r");
-    if (!file) return NULL;
-
-    // Get file size
-    fseek(file, 0, SEEK_END);
-    long file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    if (file_size <= 0) {
-        fclose(file);
-        // Return empty string for empty files instead of NULL
-        char* empty_content = malloc(1);
-        if (empty_content) {
-            empty_content[0] = '\0';
-        }
-        return empty_content;
-    }
-
-    // Allocate buffer with divine blessing
-    char* content = malloc(file_size + 1);
-    if (!content) {
-        fclose(file);
-        return NULL;
-    }
-
-    // Read content
-    size_t bytes_read = fread(content, 1, file_size, file);
-    content[bytes_read] = '\0';
-
-    fclose(file);
-    return content;
-}
-
 // =============================================================================
 // COLOR AND DISPLAY UTILITIES
 // =============================================================================
@@ -775,29 +935,368 @@ static const char* get_type_name(ViolationType_t type) {
     }
 }
 
+// =============================================================================
+// PERSISTENT RESULT CACHE
+// =============================================================================
+
+#define RESULT_CACHE_FORMAT 1   // Bump whenever the entry layout or analysis output changes
+
+static char* result_cache_dir = NULL;  // NULL while the cache is disabled
+
 /*
- * Read and validate file content with compassionate error handling
+ * Enable or disable the on-disk result cache
  */
-static char* read_and_validate_file(const char* file_path) {
-    printf("%s🔍 Analyzing:%s %s%s%s\n",
-           METIS_INFO, METIS_RESET,
-           METIS_CLICKABLE_LINK, file_path, METIS_RESET);
+void metis_linter_set_cache_dir(const char* cache_dir) {
+    free(result_cache_dir);
+    result_cache_dir = cache_dir ? strdup(cache_dir) : NULL;
+}
 
-    char* content = read_file_content(file_path);
-    if (!content) {
-        printf("%s💀 Error:%s Cannot read file %s\n",
-               METIS_ERROR, METIS_RESET, file_path);
+/*
+ * Fold bytes into a running 64-bit hash, a word at a time
+ */
+static uint64_t cache_hash_bytes(uint64_t hash, const void* data, size_t length) {
+    const unsigned char* bytes = data;
+    hash ^= (uint64_t)length * 0x9e3779b97f4a7c15ull;
+
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 0xff51afd7ed558ccdull;
+        hash ^= hash >> 32;
+    }
+    for (; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
     }
-    return content;
+    return hash;
 }
 
 /*
- * Analyze file content and populate violations list
+ * Fold a string into a running hash; NULL hashes differently from ""
  */
-static int analyze_file_violations(const char* file_path, const char* content, ViolationList_t* violations) {
-    if (!file_path || !content || !violations) return 0;
-    
-    return analyze_file_content(file_path, content, violations);
+static uint64_t cache_hash_string(uint64_t hash, const char* text) {
+    if (!text) return cache_hash_bytes(hash, "\xff", 1);
+    return cache_hash_bytes(hash, text, strlen(text));
+}
+
+/*
+ * Fold a file's path and contents into a running hash
+ *
+ * `bool` - false if the file could not be read
+ */
+static bool cache_hash_file(uint64_t* hash, const char* file_path) {
+    SourceInput_t input;
+    if (!c_parser_input_open(file_path, &input)) return false;
+
+    *hash = cache_hash_string(*hash, file_path);
+    *hash = cache_hash_bytes(*hash, input.data, input.length);
+    c_parser_input_close(&input);
+    return true;
+}
+
+/*
+ * Fold a resolved header into a running hash, or a marker if there is none
+ */
+static bool cache_hash_header(uint64_t* hash, char* header_path) {
+    bool hashed = header_path ? cache_hash_file(hash, header_path) : true;
+    if (!header_path) *hash = cache_hash_string(*hash, NULL);
+    free(header_path);
+    return hashed;
+}
+
+/*
+ * Compute the cache key for a file: everything its analysis result depends on
+ *
+ * Covers the linter version, the config, the file's path and bytes and, for
+ * .c files, both headers the analysis reads (they are resolved differently).
+ */
+static bool compute_cache_key(const char* file_path, uint64_t* key_out) {
+    uint64_t key = cache_hash_string(0xcbf29ce484222325ull, METIS_VERSION);
+    int format = RESULT_CACHE_FORMAT;
+    key = cache_hash_bytes(key, &format, sizeof(format));
+
+    MetisConfig_t* config = metis_config_get();
+    if (config) {
+        int settings[] = {
+            config->strictness,
+            config->enable_memory_fragments, config->enable_docs_fragments,
+            config->enable_daedalus_fragments, config->enable_emscripten_fragments,
+            config->enable_philosophical_fragments
+        };
+        key = cache_hash_bytes(key, settings, sizeof(settings));
+    }
+
+    if (!cache_hash_file(&key, file_path)) return false;
+
+    const char* ext = strrchr(file_path, '.');
+    if (ext && strcmp(ext, ".c") == 0) {
+        if (!cache_hash_header(&key, find_header_file(file_path)) ||
+            !cache_hash_header(&key, cross_reference_find_header_file(file_path))) {
+            return false;
+        }
+    }
+
+    *key_out = key;
+    return true;
+}
+
+/*
+ * Path of the entry holding a file's cached result
+ *
+ * `bool` - false if the path does not fit in `size`, in which case the file is not cached
+ */
+static bool cache_entry_path(const char* file_path, char* buffer, size_t size) {
+    int length = snprintf(buffer, size, "%s/%016llx", result_cache_dir,
+                          (unsigned long long)cache_hash_string(0, file_path));
+    return length >= 0 && (size_t)length < size;
+}
+
+/*
+ * Write a length-prefixed string to a cache entry; NULL is written as "-"
+ */
+static void cache_write_string(FILE* out, const char* text, size_t length) {
+    if (!text) {
+        fputs("-\n", out);
+        return;
+    }
+    fprintf(out, "%zu\n", length);
+    fwrite(text, 1, length, out);
+    fputc('\n', out);
+}
+
+/*
+ * Read a string written by cache_write_string()
+ *
+ * `bool` - false on a malformed entry; `*text_out` is NULL for a written NULL
+ */
+static bool cache_read_string(FILE* in, char** text_out, size_t* length_out) {
+    *text_out = NULL;
+    if (length_out) *length_out = 0;
+
+    int first = fgetc(in);
+    if (first == '-') return fgetc(in) == '\n';
+    if (first == EOF || ungetc(first, in) == EOF) return false;
+
+    size_t length = 0;
+    if (fscanf(in, "%zu", &length) != 1 || fgetc(in) != '\n') return false;
+
+    char* text = malloc(length + 1);
+    if (!text) return false;
+    if (fread(text, 1, length, in) != length || fgetc(in) != '\n') {
+        free(text);
+        return false;
+    }
+    text[length] = '\0';
+
+    *text_out = text;
+    if (length_out) *length_out = length;
+    return true;
+}
+
+/*
+ * Read one cached violation into the analysis
+ */
+static bool cache_read_violation(FILE* in, FileAnalysis_t* analysis) {
+    int line = 0, column = 0, type = 0, severity = 0;
+    if (fscanf(in, "%d %d %d %d", &line, &column, &type, &severity) != 4 || fgetc(in) != '\n') {
+        return false;
+    }
+
+    char* file_path = NULL;
+    char* message = NULL;
+    char* suggestion = NULL;
+    bool ok = cache_read_string(in, &file_path, NULL) && file_path &&
+              cache_read_string(in, &message, NULL) && message &&
+              cache_read_string(in, &suggestion, NULL);
+    if (ok) {
+        add_violation(analysis->violations, file_path, line, column, message, suggestion,
+                      (ViolationType_t)type, (Severity_t)severity);
+    }
+
+    free(file_path);
+    free(message);
+    free(suggestion);
+    return ok;
+}
+
+/*
+ * Read one cached unsafe strcmp usage
+ */
+static bool cache_read_strcmp_usage(FILE* in, UnsafeStrcmpUsage_t* usage) {
+    int vs_cstring = 0, vs_dstring = 0;
+    if (fscanf(in, "%d %d %d %d", &usage->line, &usage->column, &vs_cstring, &vs_dstring) != 4 ||
+        fgetc(in) != '\n') {
+        return false;
+    }
+    usage->is_dstring_vs_cstring = vs_cstring != 0;
+    usage->is_dstring_vs_dstring = vs_dstring != 0;
+
+    char* fields[3] = {0};
+    bool ok = cache_read_string(in, &fields[0], NULL) && fields[0] &&
+              cache_read_string(in, &fields[1], NULL) && fields[1] &&
+              cache_read_string(in, &fields[2], NULL) && fields[2];
+    if (ok) {
+        snprintf(usage->function_name, sizeof(usage->function_name), "%s", fields[0]);
+        snprintf(usage->variable1, sizeof(usage->variable1), "%s", fields[1]);
+        snprintf(usage->variable2, sizeof(usage->variable2), "%s", fields[2]);
+    }
+
+    for (int i = 0; i < 3; i++) free(fields[i]);
+    return ok;
+}
+
+/*
+ * Replay a file's analysis from the cache without reading its tokens
+ *
+ * `bool` - true on a hit; on a miss `analysis` is left untouched
+ */
+static bool load_cached_analysis(FileAnalysis_t* analysis, uint64_t key) {
+    char entry_path[1024];
+    if (!cache_entry_path(analysis->file_path, entry_path, sizeof(entry_path))) return false;
+
+    FILE* in = fopen(entry_path, "rb");
+    if (!in) return false;
+
+    FileAnalysis_t cached = { .file_path = analysis->file_path, .readable = true };
+    unsigned long long stored_key = 0;
+    int format = 0;
+    char* stored_path = NULL;
+    int violation_count = 0;
+    int usage_count = 0;
+
+    // The path is checked too, since entry names are only a hash of it
+    bool ok = fscanf(in, "metis-cache %d %llx", &format, &stored_key) == 2 && fgetc(in) == '\n' &&
+              format == RESULT_CACHE_FORMAT && stored_key == key &&
+              cache_read_string(in, &stored_path, NULL) && stored_path &&
+              strcmp(stored_path, analysis->file_path) == 0 &&
+              fscanf(in, "%d %d", &violation_count, &usage_count) == 2 && fgetc(in) == '\n' &&
+              violation_count >= 0 && usage_count >= 0;
+    free(stored_path);
+
+    if (ok) {
+        cached.violations = create_violation_list();
+        cached.strcmp_usages = calloc((size_t)usage_count + 1, sizeof(UnsafeStrcmpUsage_t));
+        ok = cached.violations && cached.strcmp_usages;
+    }
+    for (int i = 0; ok && i < violation_count; i++) {
+        ok = cache_read_violation(in, &cached);
+    }
+    for (int i = 0; ok && i < usage_count; i++) {
+        ok = cache_read_strcmp_usage(in, &cached.strcmp_usages[i]);
+    }
+    cached.strcmp_usage_count = usage_count;
+    ok = ok && cache_read_string(in, &cached.output, &cached.output_length);
+    fclose(in);
+
+    if (!ok || cached.violations->count != violation_count) {
+        free_file_analysis(&cached);
+        return false;
+    }
+
+    *analysis = cached;
+    return true;
+}
+
+/*
+ * Store a file's analysis in the cache
+ *
+ * Written to a temporary file and renamed into place, so concurrent runs and
+ * workers only ever see complete entries. Failures just leave the cache cold.
+ */
+static void store_cached_analysis(const FileAnalysis_t* analysis, uint64_t key) {
+    char entry_path[1024];
+    char temp_path[1100];
+    if (!cache_entry_path(analysis->file_path, entry_path, sizeof(entry_path))) return;
+    snprintf(temp_path, sizeof(temp_path), "%s.XXXXXX", entry_path);  // Fits: entry_path is under 1024
+
+    if (mkdir(result_cache_dir, 0755) != 0 && errno != EEXIST) return;
+    int fd = mkstemp(temp_path);
+    if (fd < 0) return;
+    FILE* out = fdopen(fd, "wb");
+    if (!out) {
+        close(fd);
+        unlink(temp_path);
+        return;
+    }
+
+    const ViolationList_t* violations = analysis->violations;
+    fprintf(out, "metis-cache %d %016llx\n", RESULT_CACHE_FORMAT, (unsigned long long)key);
+    cache_write_string(out, analysis->file_path, strlen(analysis->file_path));
+    fprintf(out, "%d %d\n", violations->count, analysis->strcmp_usage_count);
+
+    for (int i = 0; i < violations->count; i++) {
+        const LintViolation_t* v = &violations->violations[i];
+        fprintf(out, "%d %d %d %d\n", v->line_number, v->column, (int)v->type, (int)v->severity);
+        cache_write_string(out, v->file_path, strlen(v->file_path));
+        cache_write_string(out, v->violation_message, strlen(v->violation_message));
+        cache_write_string(out, v->suggestion, v->suggestion ? strlen(v->suggestion) : 0);
+    }
+
+    for (int i = 0; i < analysis->strcmp_usage_count; i++) {
+        const UnsafeStrcmpUsage_t* usage = &analysis->strcmp_usages[i];
+        fprintf(out, "%d %d %d %d\n", usage->line, usage->column,
+                usage->is_dstring_vs_cstring, usage->is_dstring_vs_dstring);
+        cache_write_string(out, usage->function_name, strlen(usage->function_name));
+        cache_write_string(out, usage->variable1, strlen(usage->variable1));
+        cache_write_string(out, usage->variable2, strlen(usage->variable2));
+    }
+
+    cache_write_string(out, analysis->output ? analysis->output : "", analysis->output_length);
+
+    bool written = !ferror(out);
+    if (fclose(out) != 0 || !written || rename(temp_path, entry_path) != 0) {
+        unlink(temp_path);
+    }
+}
+
+/*
+ * Read and analyze one file without printing or delivering fragments
+ *
+ * `dir_fd` - Open directory holding the file, or -1 to open file_path as given
+ * `file_name` - The file's name within `dir_fd`
+ *
+ * Safe to run on any thread; the result is reported by report_file_analysis()
+ */
+static void analyze_file(FileAnalysis_t* analysis, int dir_fd, const char* file_name) {
+    ParsedFile_t* parsed = NULL;
+    uint64_t cache_key = 0;
+    bool cacheable = false;
+
+    if (dir_fd >= 0) {
+        // Its path is too long to open, so read it relative to the directory the walk found it in.
+        // Such a file is neither cached nor shared, since both are keyed by path
+        SourceInput_t input;
+        analysis->readable = c_parser_input_open_at(dir_fd, file_name, &input);
+        if (!analysis->readable) return;
+        parsed = c_parser_parse_input(&input, analysis->file_path);
+    } else {
+        // Unchanged files (and headers) replay their last result without being parsed
+        cacheable = result_cache_dir && compute_cache_key(analysis->file_path, &cache_key);
+        if (cacheable && load_cached_analysis(analysis, cache_key)) return;
+
+        // Shared with any file of this run that includes it; empty files parse as empty
+        parsed = c_parser_acquire_file(analysis->file_path);
+        analysis->readable = parsed != NULL;
+        if (!parsed) {
+            // Tell an unreadable file apart from one that failed to parse
+            SourceInput_t input;
+            analysis->readable = c_parser_input_open(analysis->file_path, &input);
+            c_parser_input_close(&input);
+            if (!analysis->readable) return;
+        }
+    }
+
+    analysis->violations = create_violation_list();
+    FILE* out = open_memstream(&analysis->output, &analysis->output_length);
+    bool analyzed = analysis->violations && out;
+    if (analyzed) {
+        analyze_file_content(analysis->file_path, parsed, analysis, out);
+    }
+
+    if (out) fclose(out);
+    c_parser_release_file(parsed);
+
+    if (cacheable && analyzed) store_cached_analysis(analysis, cache_key);
 }
 
 /*
@@ -1216,45 +1715,168 @@ static bool initialize_linting_session(void) {
     return true;
 }
 /*
- * Main file linting function
+ * Print one file's analysis and deliver its fragments, in the order serial linting did
+ *
+ * Must run on the main thread: it prints and updates the fragment engine
  */
-int metis_lint_file(const char* file_path) {
-    if (!file_path) return -1;
-
+static int report_file_analysis(FileAnalysis_t* analysis) {
     // Initialize session
     if (!initialize_linting_session()) {
         return -1;
     }
 
-    // Read and validate file
-    char* content = read_and_validate_file(file_path);
-    if (!content) {
+    printf("%s🔍 Analyzing:%s %s%s%s\n",
+           METIS_INFO, METIS_RESET,
+           METIS_CLICKABLE_LINK, analysis->file_path, METIS_RESET);
+
+    if (!analysis->readable) {
+        printf("%s💀 Error:%s Cannot read file %s\n",
+               METIS_ERROR, METIS_RESET, analysis->file_path);
         return -1;
     }
-
-    // Create violation list
-    ViolationList_t* violations = create_violation_list();
-    if (!violations) {
-        free(content);
+    if (!analysis->violations) {
         return -1;
     }
 
-    // Analyze violations
-    analyze_file_violations(file_path, content, violations);
-    free(content);
+    // Enhanced contextual fragments for each unsafe strcmp pattern
+    for (int i = 0; i < analysis->strcmp_usage_count; i++) {
+        const UnsafeStrcmpUsage_t* usage = &analysis->strcmp_usages[i];
+        FragmentContext_t fragment_context = {
+            .variable1 = usage->variable1,
+            .variable2 = usage->variable2,
+            .function_name = usage->function_name,
+            .file_name = analysis->file_path,
+            .violation_type = strcmp_violation_type(usage)
+        };
+        metis_deliver_contextual_fragment(&fragment_context);
+    }
+
+    // Cross-reference findings printed during analysis
+    if (analysis->output_length > 0) {
+        fwrite(analysis->output, 1, analysis->output_length, stdout);
+    }
 
     // Report violations
-    report_violations(violations, file_path);
+    report_violations(analysis->violations, analysis->file_path);
     
     // Deliver contextual fragments
-    deliver_contextual_fragments(violations);
+    deliver_contextual_fragments(analysis->violations);
 
-    // Cleanup and return result
-    int violation_count = violations->count;
-    free_violation_list(violations);
+    return analysis->violations->count;
+}
+
+/*
+ * Main file linting function
+ */
+int metis_lint_file(const char* file_path) {
+    if (!file_path) return -1;
+
+    FileAnalysis_t analysis = { .file_path = file_path };
+    c_parser_cache_begin();
+    analyze_file(&analysis, -1, NULL);
+    c_parser_cache_end();
+    int violation_count = report_file_analysis(&analysis);
+    free_file_analysis(&analysis);
     return violation_count;
 }
 
+/*
+ * Category name reported for a violation type by metis_linter_analyze()
+ */
+static const char* finding_category(ViolationType_t type) {
+    switch (type) {
+        case DOCS_VIOLATION: return "docs";
+        case DAEDALUS_SUGGESTION: return "daedalus";
+        case PHILOSOPHICAL_VIOLATION: return "philosophy";
+        case HEADER_VIOLATION: return "header";
+        default: return "unknown";
+    }
+}
+
+/*
+ * Analyze one file or in-memory buffer into findings, without printing or delivering fragments
+ */
+bool metis_linter_analyze(const char* file_path, const char* content, size_t length, MetisFindings_t* findings) {
+    if (!findings) return false;
+    memset(findings, 0, sizeof(*findings));
+    if (!file_path) return false;
+
+    FileAnalysis_t analysis = { .file_path = file_path };
+    ParsedFile_t* parsed = NULL;
+    if (content) {
+        // The parse owns a null-terminated copy, as if the buffer had been read from disk
+        size_t used = strnlen(content, length);
+        char* source = malloc(used + 1);
+        if (!source) return false;
+        memcpy(source, content, used);
+        source[used] = '\0';
+
+        SourceInput_t input = { .data = source, .length = used };
+        parsed = c_parser_parse_input(&input, file_path);
+        analysis.readable = true;
+    } else {
+        parsed = c_parser_acquire_file(file_path);
+        analysis.readable = parsed != NULL;
+        if (!parsed) {
+            SourceInput_t input;
+            analysis.readable = c_parser_input_open(file_path, &input);
+            c_parser_input_close(&input);
+        }
+    }
+
+    if (analysis.readable) {
+        analysis.violations = create_violation_list();
+        if (analysis.violations) analyze_file_content(file_path, parsed, &analysis, NULL);
+    }
+    if (content) {
+        c_parser_free_parsed_file(parsed);
+    } else {
+        c_parser_release_file(parsed);
+    }
+
+    findings->readable = analysis.readable;
+    if (analysis.readable && !analysis.violations) return false;
+
+    ViolationList_t* violations = analysis.violations;
+    analysis.violations = NULL;
+    free_file_analysis(&analysis);
+    if (!violations) return true;
+
+    // Findings point at the violation list's strings, so the list is kept as their storage
+    findings->findings = malloc(sizeof(MetisFinding_t) * (violations->count > 0 ? violations->count : 1));
+    if (!findings->findings) {
+        free_violation_list(violations);
+        return false;
+    }
+    for (int i = 0; i < violations->count; i++) {
+        const LintViolation_t* v = &violations->violations[i];
+        findings->findings[i] = (MetisFinding_t){
+            .file_path = v->file_path,
+            .line = v->line_number,
+            .column = v->column,
+            .message = v->violation_message,
+            .suggestion = v->suggestion,
+            .category = finding_category(v->type),
+            .severity = v->severity == SEVERITY_ERROR ? METIS_FINDING_ERROR
+                      : v->severity == SEVERITY_WARNING ? METIS_FINDING_WARNING : METIS_FINDING_INFO
+        };
+    }
+    findings->count = violations->count;
+    findings->storage = violations;
+    return true;
+}
+
+/*
+ * Free the findings of metis_linter_analyze()
+ */
+void metis_linter_free_findings(MetisFindings_t* findings) {
+    if (!findings) return;
+
+    free(findings->findings);
+    free_violation_list(findings->storage);
+    memset(findings, 0, sizeof(*findings));
+}
+
 /*
  * Check if file should be analyzed (enhanced)
  */
@@ -1269,71 +1891,573 @@ static bool should_analyze_file(const char* file_path) {
     return (strcmp(ext, ".c") == 0 || strcmp(ext, ".h") == 0 || strcmp(ext, ".cpp") == 0);
 }
 
+// =============================================================================
+// PARALLEL DIRECTORY LINTING
+// =============================================================================
+
 /*
- * Recursively lint directory with divine organization
+ * Steps of a directory lint, in the order they are reported
  */
-int metis_lint_directory(const char* dir_path) {
-    if (!dir_path) return -1;
+typedef enum {
+    LINT_STEP_ENTER_DIR,    // Directory header, fragment session reset
+    LINT_STEP_LEAVE_DIR,    // Directory summary
+    LINT_STEP_BAD_DIR,      // Subdirectory that could not be opened
+    LINT_STEP_LOOP_DIR,     // Symlinked subdirectory leading back into the walk
+    LINT_STEP_FILE          // File to analyze and report
+} LintStepKind_t;
 
-    DIR* dir = opendir(dir_path);
-    if (!dir) {
-        printf("%s💀 Error:%s Cannot open directory %s\n",
-               METIS_ERROR, METIS_RESET, dir_path);
-        return -1;
+typedef struct {
+    LintStepKind_t kind;
+    char* path;
+    FileAnalysis_t analysis;    // LINT_STEP_FILE only
+    bool analyzed;              // Set by the worker that analyzed the file
+    int dir_fd;                 // LINT_STEP_FILE: held directory to open `name` in, -1 to open `path`
+    const char* name;           // Last component of `path`
+} LintStep_t;
+
+/*
+ * Directory lint plan: the walk flattened into steps, files listed by path within each directory
+ */
+typedef struct {
+    LintStep_t* steps;
+    int count;
+    int capacity;
+    int file_count;
+    bool incomplete;            // An allocation failed, so some entries are missing
+
+    // Directories kept open for files whose paths are too long to open
+    int* held_dirs;
+    int held_dir_count;
+    int held_dir_capacity;
+
+    // Work queue shared with the worker threads
+    int next_step;              // Next step a worker should look at
+    pthread_mutex_t lock;
+    pthread_cond_t analyzed;
+} LintPlan_t;
+
+/*
+ * Append a step to the plan, taking ownership of `path`
+ */
+static bool add_lint_step(LintPlan_t* plan, LintStepKind_t kind, char* path) {
+    if (!path) {
+        plan->incomplete = true;
+        return false;
     }
 
-    // Initialize fragment engine and reset session for directory scan
-    metis_fragment_engine_init();
-    metis_reset_session_fragments();
+    if (plan->count >= plan->capacity) {
+        int new_capacity = plan->capacity ? plan->capacity * 2 : 64;
+        LintStep_t* grown = realloc(plan->steps, sizeof(LintStep_t) * new_capacity);
+        if (!grown) {
+            free(path);
+            plan->incomplete = true;
+            return false;
+        }
+        plan->steps = grown;
+        plan->capacity = new_capacity;
+    }
 
-    int total_violations = 0;
-    int files_analyzed = 0;
-    struct dirent* entry;
+    LintStep_t* step = &plan->steps[plan->count++];
+    memset(step, 0, sizeof(*step));
+    step->kind = kind;
+    step->path = path;
+    step->analysis.file_path = path;
+    step->dir_fd = -1;
+    const char* slash = strrchr(path, '/');
+    step->name = slash ? slash + 1 : path;
+    if (kind == LINT_STEP_FILE) plan->file_count++;
+    return true;
+}
 
-    printf("%s🏛️ Analyzing directory:%s %s%s%s\n", // Replaced \u{1f3db}\ufe0f with 🏛️
-           METIS_INFO, METIS_RESET,
-           METIS_CLICKABLE_LINK, dir_path, METIS_RESET);
+/*
+ * What a directory entry is, as far as the walk cares
+ */
+typedef enum {
+    WALK_ENTRY_UNKNOWN,     // Symlink, or a filesystem without d_type: resolve with fstatat()
+    WALK_ENTRY_DIR,
+    WALK_ENTRY_OTHER
+} WalkEntryType_t;
+
+typedef struct {
+    char* name;
+    WalkEntryType_t type;
+} WalkEntry_t;
+
+/*
+ * One open directory on the walk stack
+ */
+typedef struct {
+    DIR* dir;               // Held open so children are opened relative to it
+    char* path;             // Path as reported; ownership passes to the leave step
+    WalkEntry_t* entries;   // Sorted by name
+    int count;
+    int next;               // Next entry to visit
+    dev_t device;           // Identity, for symlink loop detection
+    ino_t inode;
+    MetisIgnore_t* ignore;  // This directory's .metisignore, NULL if it has none
+    int held_fd;            // Copy of the directory kept in the plan, -1 until a file needs it
+} WalkFrame_t;
+
+static int walk_max_depth = -1;    // Deepest subdirectory level to enter, -1 for no limit
+
+/*
+ * Limit how many directory levels below the root a directory lint enters
+ */
+void metis_linter_set_max_depth(int max_depth) {
+    walk_max_depth = max_depth < 0 ? -1 : max_depth;
+}
+
+/*
+ * qsort comparator for walk entries, by name
+ */
+static int compare_walk_entries(const void* a, const void* b) {
+    return strcmp(((const WalkEntry_t*)a)->name, ((const WalkEntry_t*)b)->name);
+}
+
+/*
+ * Classify a directory entry from d_type, where the filesystem provides it
+ */
+static WalkEntryType_t walk_entry_type(const struct dirent* entry) {
+#ifdef DT_UNKNOWN
+    if (entry->d_type == DT_DIR) return WALK_ENTRY_DIR;
+    if (entry->d_type != DT_UNKNOWN && entry->d_type != DT_LNK) return WALK_ENTRY_OTHER;
+#else
+    (void)entry;
+#endif
+    return WALK_ENTRY_UNKNOWN;
+}
+
+/*
+ * Join a directory path and an entry name into a new string
+ */
+static char* join_walk_path(const char* dir_path, const char* name) {
+    size_t dir_length = strlen(dir_path);
+    size_t name_length = strlen(name);
+    char* path = malloc(dir_length + name_length + 2);
+    if (!path) return NULL;
+
+    memcpy(path, dir_path, dir_length);
+    path[dir_length] = '/';
+    memcpy(path + dir_length + 1, name, name_length + 1);
+    return path;
+}
+
+/*
+ * Release a frame's directory and entry names (not its path)
+ */
+static void close_walk_frame(WalkFrame_t* frame) {
+    for (int i = frame->next; i < frame->count; i++) {
+        free(frame->entries[i].name);
+    }
+    free(frame->entries);
+    if (frame->dir) closedir(frame->dir);
+    metis_ignore_free(frame->ignore);
+    frame->entries = NULL;
+    frame->dir = NULL;
+    frame->ignore = NULL;
+}
+
+typedef enum {
+    WALK_OPEN_OK,
+    WALK_OPEN_FAILED,
+    WALK_OPEN_LOOP,         // The directory is already on the stack
+    WALK_OPEN_NO_MEMORY     // The listing could not be stored
+} WalkOpenResult_t;
 
-    while ((entry = readdir(dir)) != NULL) {
+/*
+ * Open `name` relative to `parent_fd` and read its entries in name order
+ *
+ * `ancestors` - Frames already on the stack, checked for a symlink loop
+ * `ancestor_count` - Number of them
+ *
+ * Entries are read completely before anything is visited, so the walk's
+ * output never depends on readdir() order. A .metisignore is only opened
+ * when the listing shows one.
+ */
+static WalkOpenResult_t open_walk_frame(WalkFrame_t* frame, int parent_fd, const char* name,
+                                        const WalkFrame_t* ancestors, int ancestor_count) {
+    memset(frame, 0, sizeof(*frame));
+    frame->held_fd = -1;
+
+    int fd = openat(parent_fd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return WALK_OPEN_FAILED;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return WALK_OPEN_FAILED;
+    }
+    for (int i = 0; i < ancestor_count; i++) {
+        if (ancestors[i].device == st.st_dev && ancestors[i].inode == st.st_ino) {
+            close(fd);
+            return WALK_OPEN_LOOP;
+        }
+    }
+    frame->device = st.st_dev;
+    frame->inode = st.st_ino;
+
+    frame->dir = fdopendir(fd);
+    if (!frame->dir) {
+        close(fd);
+        return WALK_OPEN_FAILED;
+    }
+
+    int capacity = 0;
+    bool has_ignore_file = false;
+    struct dirent* entry;
+    while ((entry = readdir(frame->dir)) != NULL) {
         // Skip . and ..
         if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
             continue;
         }
+        if (strcmp(entry->d_name, METIS_IGNORE_FILE) == 0) has_ignore_file = true;
+
+        if (frame->count >= capacity) {
+            int new_capacity = capacity ? capacity * 2 : 32;
+            WalkEntry_t* grown = realloc(frame->entries, sizeof(WalkEntry_t) * new_capacity);
+            if (!grown) return WALK_OPEN_NO_MEMORY;
+            frame->entries = grown;
+            capacity = new_capacity;
+        }
+        frame->entries[frame->count].name = strdup(entry->d_name);
+        frame->entries[frame->count].type = walk_entry_type(entry);
+        if (!frame->entries[frame->count].name) return WALK_OPEN_NO_MEMORY;
+        frame->count++;
+    }
+
+    if (frame->count > 1) {
+        qsort(frame->entries, frame->count, sizeof(WalkEntry_t), compare_walk_entries);
+    }
+    if (has_ignore_file) frame->ignore = metis_ignore_load_at(dirfd(frame->dir));
+    return WALK_OPEN_OK;
+}
+
+/*
+ * Check a path against the .metisignore files of every directory on the stack
+ *
+ * The innermost file with a matching pattern decides, as with nested .gitignore files.
+ */
+static bool walk_is_ignored(const WalkFrame_t* stack, int depth, const char* full_path, bool is_directory) {
+    for (int i = depth - 1; i >= 0; i--) {
+        if (!stack[i].ignore) continue;
+
+        const char* relative_path = full_path + strlen(stack[i].path) + 1;
+        MetisIgnoreMatch_t match = metis_ignore_match(stack[i].ignore, relative_path, is_directory);
+        if (match != METIS_IGNORE_NO_MATCH) return match == METIS_IGNORE_EXCLUDED;
+    }
+    return false;
+}
+
+/*
+ * Keep a frame's directory open until the lint ends, so files too deep to open by path can be read
+ *
+ * `int` - The held descriptor, or -1 if it could not be kept
+ */
+static int hold_walk_directory(LintPlan_t* plan, WalkFrame_t* frame) {
+    if (frame->held_fd >= 0) return frame->held_fd;
+
+    if (plan->held_dir_count >= plan->held_dir_capacity) {
+        int new_capacity = plan->held_dir_capacity ? plan->held_dir_capacity * 2 : 8;
+        int* grown = realloc(plan->held_dirs, sizeof(int) * new_capacity);
+        if (!grown) return -1;
+        plan->held_dirs = grown;
+        plan->held_dir_capacity = new_capacity;
+    }
+
+    int fd = fcntl(dirfd(frame->dir), F_DUPFD_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    plan->held_dirs[plan->held_dir_count++] = fd;
+    frame->held_fd = fd;
+    return fd;
+}
+
+/*
+ * Walk a directory tree into the plan, visiting entries in name order so reports are deterministic
+ *
+ * The walk keeps its own stack of open directories instead of recursing, opens
+ * each one relative to its parent with openat(), and only stats entries whose
+ * d_type does not already say what they are. Symlinked directories are
+ * followed unless they lead back to a directory already on the stack.
+ * Directories excluded by a .metisignore are never opened. Files whose path
+ * is too long to open keep their directory open, to be read relative to it.
+ */
+static bool plan_directory(LintPlan_t* plan, const char* dir_path) {
+    WalkFrame_t* stack = malloc(sizeof(WalkFrame_t) * 16);
+    if (!stack) return false;
+    int stack_capacity = 16;
+
+    if (open_walk_frame(&stack[0], AT_FDCWD, dir_path, NULL, 0) != WALK_OPEN_OK ||
+        !(stack[0].path = strdup(dir_path))) {
+        close_walk_frame(&stack[0]);
+        free(stack);
+        return false;
+    }
+    add_lint_step(plan, LINT_STEP_ENTER_DIR, strdup(dir_path));
+    int depth = 1;
 
-        // Build full path
-        char full_path[1024];
-        snprintf(full_path, sizeof(full_path), "%s/%s", dir_path, entry->d_name);
+    while (depth > 0) {
+        WalkFrame_t* frame = &stack[depth - 1];
 
-        struct stat path_stat;
-        if (stat(full_path, &path_stat) != 0) {
+        if (frame->next >= frame->count) {
+            close_walk_frame(frame);
+            add_lint_step(plan, LINT_STEP_LEAVE_DIR, frame->path);
+            depth--;
             continue;
         }
 
-        if (S_ISDIR(path_stat.st_mode)) {
-            // Recursively process subdirectory
-            int subdir_violations = metis_lint_directory(full_path);
-            if (subdir_violations > 0) {
-                total_violations += subdir_violations;
+        WalkEntry_t* entry = &frame->entries[frame->next++];
+        char* full_path = join_walk_path(frame->path, entry->name);
+        WalkEntryType_t type = entry->type;
+
+        // Symlinks and filesystems without d_type need a stat to tell directories apart
+        if (full_path && type == WALK_ENTRY_UNKNOWN) {
+            struct stat st;
+            if (fstatat(dirfd(frame->dir), entry->name, &st, 0) == 0) {
+                type = S_ISDIR(st.st_mode) ? WALK_ENTRY_DIR : WALK_ENTRY_OTHER;
             }
-        } else if (should_analyze_file(full_path)) {
-            // Analyze file
-            int file_violations = metis_lint_file(full_path);
-            files_analyzed++;
-            if (file_violations > 0) {
-                total_violations += file_violations;
+        }
+
+        if (!full_path || type == WALK_ENTRY_UNKNOWN) {
+            free(full_path);
+        } else if (type == WALK_ENTRY_OTHER) {
+            if (should_analyze_file(entry->name) && !walk_is_ignored(stack, depth, full_path, false)) {
+                bool too_long = strlen(full_path) >= PATH_MAX;
+                if (add_lint_step(plan, LINT_STEP_FILE, full_path) && too_long) {
+                    plan->steps[plan->count - 1].dir_fd = hold_walk_directory(plan, frame);
+                }
+            } else {
+                free(full_path);
+            }
+        } else if ((walk_max_depth >= 0 && depth > walk_max_depth) || walk_is_ignored(stack, depth, full_path, true)) {
+            free(full_path);
+        } else {
+            if (depth >= stack_capacity) {
+                WalkFrame_t* grown = realloc(stack, sizeof(WalkFrame_t) * stack_capacity * 2);
+                if (grown) {
+                    stack = grown;
+                    stack_capacity *= 2;
+                    frame = &stack[depth - 1];
+                }
+            }
+
+            WalkOpenResult_t opened = WALK_OPEN_NO_MEMORY;
+            if (depth < stack_capacity) {
+                opened = open_walk_frame(&stack[depth], dirfd(frame->dir), entry->name, stack, depth);
+                if (opened != WALK_OPEN_OK) close_walk_frame(&stack[depth]);
+            }
+            if (opened == WALK_OPEN_NO_MEMORY) plan->incomplete = true;
+
+            if (opened == WALK_OPEN_OK) {
+                stack[depth].path = full_path;
+                add_lint_step(plan, LINT_STEP_ENTER_DIR, strdup(full_path));
+                depth++;
+            } else {
+                add_lint_step(plan, opened == WALK_OPEN_LOOP ? LINT_STEP_LOOP_DIR : LINT_STEP_BAD_DIR, full_path);
             }
         }
+        free(entry->name);
     }
 
-    closedir(dir);
+    free(stack);
+    return true;
+}
+
+/*
+ * Worker thread: claim files in plan order and analyze them
+ */
+static void* lint_worker(void* arg) {
+    LintPlan_t* plan = arg;
+
+    // Each file's parse buffers are handed to the next file this worker claims
+    c_parser_pool_begin();
+
+    for (;;) {
+        LintStep_t* step = NULL;
 
-    // Summary for directory
-    if (files_analyzed > 0) {
-        printf("\n%s📊 Directory summary:%s %d files analyzed, %d total issues\n", // Replaced \u{1f4ca} with 📊
-               METIS_INFO, METIS_RESET, files_analyzed, total_violations);
+        pthread_mutex_lock(&plan->lock);
+        while (plan->next_step < plan->count && plan->steps[plan->next_step].kind != LINT_STEP_FILE) {
+            plan->next_step++;
+        }
+        if (plan->next_step < plan->count) {
+            step = &plan->steps[plan->next_step++];
+        }
+        pthread_mutex_unlock(&plan->lock);
+
+        if (!step) {
+            c_parser_pool_end();
+            return NULL;
+        }
+
+        analyze_file(&step->analysis, step->dir_fd, step->name);
+
+        pthread_mutex_lock(&plan->lock);
+        step->analyzed = true;
+        pthread_cond_broadcast(&plan->analyzed);
+        pthread_mutex_unlock(&plan->lock);
     }
+}
 
-    return total_violations;
+/*
+ * Number of worker threads to use for a `jobs` request (0 or less = one per core)
+ */
+static int resolve_job_count(int jobs, int file_count) {
+    if (jobs <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = cores > 0 ? (int)cores : 1;
+    }
+    if (jobs > file_count) jobs = file_count;
+    return jobs > 0 ? jobs : 1;
+}
+
+/*
+ * Per-directory totals while replaying the plan
+ */
+typedef struct {
+    int files_analyzed;
+    int total_violations;
+} LintDirTotals_t;
+
+/*
+ * Recursively lint directory with divine organization
+ */
+int metis_lint_directory(const char* dir_path) {
+    return metis_lint_directory_jobs(dir_path, 0);
+}
+
+/*
+ * Recursively lint directory, analyzing files on `jobs` worker threads
+ */
+int metis_lint_directory_jobs(const char* dir_path, int jobs) {
+    if (!dir_path) return -1;
+
+    LintPlan_t plan = {0};
+    if (!plan_directory(&plan, dir_path)) {
+        printf("%s💀 Error:%s Cannot open directory %s\n",
+               METIS_ERROR, METIS_RESET, dir_path);
+        return -1;
+    }
+
+    // Headers and implementations are parsed once per run, whichever file asks first
+    c_parser_cache_begin();
+    c_parser_pool_begin();
+
+    // Analysis runs ahead on the workers; printing, fragments and metis.mind stay on this thread
+    int worker_count = resolve_job_count(jobs, plan.file_count);
+    pthread_t* workers = NULL;
+    int started = 0;
+    if (worker_count > 1) {
+        pthread_mutex_init(&plan.lock, NULL);
+        pthread_cond_init(&plan.analyzed, NULL);
+        workers = malloc(sizeof(pthread_t) * worker_count);
+        for (int i = 0; workers && i < worker_count; i++) {
+            if (pthread_create(&workers[i], NULL, lint_worker, &plan) != 0) break;
+            started++;
+        }
+    }
+
+    // Steps nest like the directories they came from, so a stack of totals mirrors the recursion
+    LintDirTotals_t* totals = calloc(plan.count + 1, sizeof(LintDirTotals_t));
+    int depth = 0;
+    int result = 0;
+
+    for (int i = 0; i < plan.count; i++) {
+        LintStep_t* step = &plan.steps[i];
+
+        switch (step->kind) {
+            case LINT_STEP_ENTER_DIR:
+                // Initialize fragment engine and reset session for directory scan
+                metis_fragment_engine_init();
+                metis_reset_session_fragments();
+
+                printf("%s🏛️ Analyzing directory:%s %s%s%s\n", // Replaced \u{1f3db}\ufe0f with 🏛️
+                       METIS_INFO, METIS_RESET,
+                       METIS_CLICKABLE_LINK, step->path, METIS_RESET);
+                depth++;
+                if (totals) totals[depth] = (LintDirTotals_t){0};
+                break;
+
+            case LINT_STEP_BAD_DIR:
+                printf("%s💀 Error:%s Cannot open directory %s\n",
+                       METIS_ERROR, METIS_RESET, step->path);
+                break;
+
+            case LINT_STEP_LOOP_DIR:
+                printf("%s⚠️ Skipping:%s %s leads back into a directory already being analyzed\n",
+                       METIS_WARNING, METIS_RESET, step->path);
+                break;
+
+            case LINT_STEP_FILE: {
+                if (started > 0) {
+                    pthread_mutex_lock(&plan.lock);
+                    while (!step->analyzed) {
+                        pthread_cond_wait(&plan.analyzed, &plan.lock);
+                    }
+                    pthread_mutex_unlock(&plan.lock);
+                } else {
+                    analyze_file(&step->analysis, step->dir_fd, step->name);
+                }
+
+                int file_violations = report_file_analysis(&step->analysis);
+                free_file_analysis(&step->analysis);
+                if (totals) {
+                    totals[depth].files_analyzed++;
+                    if (file_violations > 0) {
+                        totals[depth].total_violations += file_violations;
+                    }
+                }
+                break;
+            }
+
+            case LINT_STEP_LEAVE_DIR: {
+                LintDirTotals_t dir_totals = totals ? totals[depth] : (LintDirTotals_t){0};
+
+                // Summary for directory
+                if (dir_totals.files_analyzed > 0) {
+                    printf("\n%s📊 Directory summary:%s %d files analyzed, %d total issues\n", // Replaced \u{1f4ca} with 📊
+                           METIS_INFO, METIS_RESET, dir_totals.files_analyzed, dir_totals.total_violations);
+                }
+
+                depth--;
+                if (depth > 0) {
+                    if (totals && dir_totals.total_violations > 0) {
+                        totals[depth].total_violations += dir_totals.total_violations;
+                    }
+                } else {
+                    result = dir_totals.total_violations;
+                }
+                break;
+            }
+        }
+    }
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    if (worker_count > 1) {
+        pthread_cond_destroy(&plan.analyzed);
+        pthread_mutex_destroy(&plan.lock);
+    }
+    free(workers);
+    free(totals);
+    c_parser_cache_end();
+    c_parser_pool_end();
+
+    for (int i = 0; i < plan.count; i++) {
+        free(plan.steps[i].path);
+    }
+    free(plan.steps);
+    for (int i = 0; i < plan.held_dir_count; i++) {
+        close(plan.held_dirs[i]);
+    }
+    free(plan.held_dirs);
+
+    // A listing cut short by an allocation failure must not pass for a clean lint
+    if (plan.incomplete) {
+        printf("%s💀 Error:%s Ran out of memory listing %s; some files were not analyzed\n",
+               METIS_ERROR, METIS_RESET, dir_path);
+        return -1;
+    }
+    return result;
 }
 
 /*
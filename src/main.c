@@ -30,6 +30,15 @@ int main(int argc, char* argv[]) {
 
     metis_colors_enable(args->enable_colors);
 
+    // A running server answers single-file lints without paying for startup
+    if (args->socket_path && strcmp(args->command, "lint") == 0) {
+        int result = metis_cmd_lint_via_server(args);
+        if (result >= 0) {
+            metis_cli_free_arguments(args);
+            return result;
+        }
+    }
+
     // Handle commands that don't require initialization
     if (!metis_cmd_requires_init(args->command)) {
         int result = metis_cmd_execute(args);
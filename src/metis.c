@@ -0,0 +1,242 @@
+/* metis.c - Public library API: lint files or buffers into diagnostics without printing */
+// INSERT WISDOM HERE
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "metis.h"
+#include "metis_linter.h"
+#include "c_parser.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define METIS_ERROR_MESSAGE_SIZE 512
+
+// Each thread keeps its own last error, so concurrent callers never see each other's
+static _Thread_local char last_error[METIS_ERROR_MESSAGE_SIZE];
+
+/*
+ * Record a formatted error for metis_get_last_error() and return `result`
+ */
+static MetisResult set_last_error(MetisResult result, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsnprintf(last_error, sizeof(last_error), format, args);
+    va_end(args);
+    return result;
+}
+
+/*
+ * Per-file findings backing a report's diagnostics
+ */
+typedef struct {
+    MetisFindings_t* files;
+    size_t count;
+} ReportStorage_t;
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+/*
+ * Initialize METIS with configuration options
+ *
+ * Linting keeps no global state, so this only validates `config`; calling it is optional.
+ */
+MetisResult metis_init(const MetisConfig* config) {
+    last_error[0] = '\0';
+    if (!config) return METIS_SUCCESS;
+
+    if (config->config_file && access(config->config_file, R_OK) != 0) {
+        return set_last_error(METIS_ERROR_CONFIG_INVALID, "Cannot read config file %s", config->config_file);
+    }
+    if (config->indent_size < 0 || config->max_line_length < 0) {
+        return set_last_error(METIS_ERROR_CONFIG_INVALID, "Indent size and line length must not be negative");
+    }
+    return METIS_SUCCESS;
+}
+
+/*
+ * Get the last error message
+ */
+const char* metis_get_last_error(void) {
+    return last_error[0] ? last_error : NULL;
+}
+
+/*
+ * Clean up METIS resources
+ */
+void metis_cleanup(void) {
+    last_error[0] = '\0';
+}
+
+// =============================================================================
+// LINTING
+// =============================================================================
+
+/*
+ * Whether `options` filter out a finding
+ */
+static bool is_filtered(const MetisFinding_t* finding, const MetisLintOptions* options) {
+    if (!options) return false;
+    if (options->ignore_warnings && finding->severity != METIS_FINDING_ERROR) return true;
+
+    for (size_t i = 0; i < options->ignore_count; i++) {
+        if (options->ignore_rules[i] && strcmp(options->ignore_rules[i], finding->category) == 0) return true;
+    }
+    return false;
+}
+
+/*
+ * Map a linter finding severity to the public one
+ */
+static MetisSeverity diagnostic_severity(MetisFindingSeverity_t severity) {
+    switch (severity) {
+        case METIS_FINDING_ERROR: return METIS_SEVERITY_ERROR;
+        case METIS_FINDING_WARNING: return METIS_SEVERITY_WARNING;
+        default: return METIS_SEVERITY_INFO;
+    }
+}
+
+/*
+ * Flatten every file's findings into the report's diagnostic array
+ */
+static bool fill_diagnostics(MetisLintReport* report, const ReportStorage_t* storage,
+                             const MetisLintOptions* options) {
+    size_t total = 0;
+    for (size_t i = 0; i < storage->count; i++) {
+        total += (size_t)storage->files[i].count;
+    }
+
+    report->diagnostics = malloc(sizeof(MetisDiagnostic) * (total > 0 ? total : 1));
+    if (!report->diagnostics) return false;
+
+    for (size_t i = 0; i < storage->count; i++) {
+        const MetisFindings_t* file = &storage->files[i];
+        for (int j = 0; j < file->count; j++) {
+            const MetisFinding_t* finding = &file->findings[j];
+            if (is_filtered(finding, options)) continue;
+
+            report->diagnostics[report->count++] = (MetisDiagnostic){
+                .severity = diagnostic_severity(finding->severity),
+                .location = {
+                    .file = finding->file_path,
+                    .line = finding->line > 0 ? (size_t)finding->line : 1,
+                    .column = finding->column > 0 ? (size_t)finding->column : 1
+                },
+                .message = finding->message,
+                .rule_id = finding->category,
+                .suggestion = finding->suggestion
+            };
+        }
+    }
+    return true;
+}
+
+/*
+ * Analyze in-memory buffers (or files, where `content` is NULL)
+ */
+MetisResult metis_lint_sources(const MetisSource* sources, size_t source_count,
+                               const MetisLintOptions* options, MetisLintReport* report) {
+    if (!report) return set_last_error(METIS_ERROR_INVALID_ARGUMENT, "No report to fill");
+    memset(report, 0, sizeof(*report));
+    if (!sources && source_count > 0) {
+        return set_last_error(METIS_ERROR_INVALID_ARGUMENT, "No sources given");
+    }
+    if (options && options->ignore_count > 0 && !options->ignore_rules) {
+        return set_last_error(METIS_ERROR_INVALID_ARGUMENT, "ignore_count is set without ignore_rules");
+    }
+    for (size_t i = 0; i < source_count; i++) {
+        if (!sources[i].path) {
+            return set_last_error(METIS_ERROR_INVALID_ARGUMENT, "Source %zu has no path", i);
+        }
+    }
+
+    ReportStorage_t* storage = calloc(1, sizeof(ReportStorage_t));
+    if (storage) storage->files = calloc(source_count > 0 ? source_count : 1, sizeof(MetisFindings_t));
+    if (!storage || !storage->files) {
+        free(storage);
+        return set_last_error(METIS_ERROR_MEMORY, "Out of memory");
+    }
+    report->storage = storage;
+
+    // One parse cache run per call: headers shared by these sources are parsed once
+    MetisResult result = METIS_SUCCESS;
+    const char* unreadable = NULL;
+    c_parser_cache_begin();
+    c_parser_pool_begin();
+    for (size_t i = 0; i < source_count && result == METIS_SUCCESS; i++) {
+        MetisFindings_t* file = &storage->files[storage->count];
+        if (!metis_linter_analyze(sources[i].path, sources[i].content, sources[i].length, file)) {
+            result = set_last_error(METIS_ERROR_MEMORY, "Out of memory analyzing %s", sources[i].path);
+            metis_linter_free_findings(file);
+            break;
+        }
+        storage->count++;
+
+        if (file->readable) {
+            report->files_analyzed++;
+        } else {
+            report->files_unreadable++;
+            if (!unreadable) unreadable = sources[i].path;
+        }
+    }
+    c_parser_pool_end();
+    c_parser_cache_end();
+
+    if (result == METIS_SUCCESS && !fill_diagnostics(report, storage, options)) {
+        result = set_last_error(METIS_ERROR_MEMORY, "Out of memory");
+    }
+    if (result != METIS_SUCCESS) {
+        metis_lint_report_free(report);
+        return result;
+    }
+
+    if (unreadable) {
+        return set_last_error(METIS_ERROR_FILE_NOT_FOUND, "Cannot read file %s", unreadable);
+    }
+    last_error[0] = '\0';
+    return METIS_SUCCESS;
+}
+
+/*
+ * Analyze source files for linting issues
+ */
+MetisResult metis_lint(const char** files, size_t file_count, const MetisLintOptions* options,
+                       MetisLintReport* report) {
+    if (!report) return set_last_error(METIS_ERROR_INVALID_ARGUMENT, "No report to fill");
+    memset(report, 0, sizeof(*report));
+    if (!files && file_count > 0) {
+        return set_last_error(METIS_ERROR_INVALID_ARGUMENT, "No files given");
+    }
+
+    MetisSource* sources = calloc(file_count > 0 ? file_count : 1, sizeof(MetisSource));
+    if (!sources) return set_last_error(METIS_ERROR_MEMORY, "Out of memory");
+    for (size_t i = 0; i < file_count; i++) {
+        sources[i].path = files[i];
+    }
+
+    MetisResult result = metis_lint_sources(sources, file_count, options, report);
+    free(sources);
+    return result;
+}
+
+/*
+ * Free the diagnostics of a metis_lint() call
+ */
+void metis_lint_report_free(MetisLintReport* report) {
+    if (!report) return;
+
+    ReportStorage_t* storage = report->storage;
+    if (storage) {
+        for (size_t i = 0; i < storage->count; i++) {
+            metis_linter_free_findings(&storage->files[i]);
+        }
+        free(storage->files);
+        free(storage);
+    }
+    free(report->diagnostics);
+    memset(report, 0, sizeof(*report));
+}
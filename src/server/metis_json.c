@@ -0,0 +1,424 @@
+/* metis_json.c - Minimal JSON reader and writer for the server and editor protocols */
+// INSERT WISDOM HERE
+
+#include "metis_json.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define JSON_MAX_DEPTH 64
+
+/*
+ * Cursor over the text being parsed
+ */
+typedef struct {
+    const char* text;
+    size_t length;
+    size_t position;
+    Arena_t* arena;
+    int depth;
+} JsonParser_t;
+
+static bool parse_value(JsonParser_t* parser, MetisJson_t* value);
+
+// =============================================================================
+// READING
+// =============================================================================
+
+/*
+ * Skip JSON whitespace
+ */
+static void skip_whitespace(JsonParser_t* parser) {
+    while (parser->position < parser->length) {
+        char c = parser->text[parser->position];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') return;
+        parser->position++;
+    }
+}
+
+/*
+ * Consume `word` if the text continues with it
+ */
+static bool consume_word(JsonParser_t* parser, const char* word) {
+    size_t length = strlen(word);
+    if (parser->length - parser->position < length ||
+        memcmp(parser->text + parser->position, word, length) != 0) {
+        return false;
+    }
+    parser->position += length;
+    return true;
+}
+
+/*
+ * Read four hex digits of a \u escape
+ */
+static bool read_hex4(JsonParser_t* parser, unsigned* code) {
+    if (parser->length - parser->position < 4) return false;
+
+    *code = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = parser->text[parser->position++];
+        *code <<= 4;
+        if (c >= '0' && c <= '9') *code |= (unsigned)(c - '0');
+        else if (c >= 'a' && c <= 'f') *code |= (unsigned)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') *code |= (unsigned)(c - 'A' + 10);
+        else return false;
+    }
+    return true;
+}
+
+/*
+ * Append a code point to `out` as UTF-8, returning the bytes written
+ */
+static size_t encode_utf8(unsigned code, char* out) {
+    if (code < 0x80) {
+        out[0] = (char)code;
+        return 1;
+    }
+    if (code < 0x800) {
+        out[0] = (char)(0xC0 | (code >> 6));
+        out[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    }
+    if (code < 0x10000) {
+        out[0] = (char)(0xE0 | (code >> 12));
+        out[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (code >> 18));
+    out[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+/*
+ * Parse a quoted string at the cursor into the arena
+ *
+ * Unescaped text is never longer than its escaped form, so one allocation of
+ * the raw length is always enough.
+ */
+static bool parse_string(JsonParser_t* parser, const char** string_out, size_t* length_out) {
+    if (parser->position >= parser->length || parser->text[parser->position] != '"') return false;
+    parser->position++;
+
+    // Plain strings (the common case) are copied in one go
+    size_t start = parser->position;
+    const char* quote = memchr(parser->text + start, '"', parser->length - start);
+    if (!quote) return false;
+    size_t raw_length = (size_t)(quote - (parser->text + start));
+    if (!memchr(parser->text + start, '\\', raw_length)) {
+        for (size_t i = 0; i < raw_length; i++) {
+            if ((unsigned char)parser->text[start + i] < 0x20) return false;
+        }
+        char* copy = c_parser_arena_strndup(parser->arena, parser->text + start, raw_length);
+        if (!copy) return false;
+        parser->position = start + raw_length + 1;
+        *string_out = copy;
+        *length_out = raw_length;
+        return true;
+    }
+
+    // The first quote may be escaped: find the closing one to size the copy
+    size_t end = start;
+    while (end < parser->length && parser->text[end] != '"') {
+        end += parser->text[end] == '\\' ? 2 : 1;
+    }
+    if (end >= parser->length) return false;
+
+    char* out = c_parser_arena_alloc(parser->arena, end - start + 1);
+    if (!out) return false;
+    size_t used = 0;
+
+    while (parser->position < parser->length) {
+        unsigned char c = (unsigned char)parser->text[parser->position++];
+        if (c == '"') {
+            out[used] = '\0';
+            *string_out = out;
+            *length_out = used;
+            return true;
+        }
+        if (c < 0x20) return false;
+        if (c != '\\') {
+            out[used++] = (char)c;
+            continue;
+        }
+
+        if (parser->position >= parser->length) return false;
+        char escape = parser->text[parser->position++];
+        switch (escape) {
+            case '"': out[used++] = '"'; break;
+            case '\\': out[used++] = '\\'; break;
+            case '/': out[used++] = '/'; break;
+            case 'b': out[used++] = '\b'; break;
+            case 'f': out[used++] = '\f'; break;
+            case 'n': out[used++] = '\n'; break;
+            case 'r': out[used++] = '\r'; break;
+            case 't': out[used++] = '\t'; break;
+            case 'u': {
+                unsigned code;
+                if (!read_hex4(parser, &code)) return false;
+
+                // A high surrogate followed by a low one is a single code point; strays become U+FFFD
+                if (code >= 0xD800 && code <= 0xDBFF) {
+                    unsigned low;
+                    size_t saved = parser->position;
+                    if (consume_word(parser, "\\u") && read_hex4(parser, &low) && low >= 0xDC00 && low <= 0xDFFF) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    } else {
+                        parser->position = saved;
+                        code = 0xFFFD;
+                    }
+                } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                    code = 0xFFFD;
+                }
+                used += encode_utf8(code, out + used);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+/*
+ * Parse a number at the cursor
+ */
+static bool parse_number(JsonParser_t* parser, double* number) {
+    size_t start = parser->position;
+    if (parser->position < parser->length && parser->text[parser->position] == '-') parser->position++;
+
+    size_t digits = parser->position;
+    while (parser->position < parser->length) {
+        char c = parser->text[parser->position];
+        if (!((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')) break;
+        parser->position++;
+    }
+    if (parser->position == digits) return false;
+
+    // strtod is laxer than JSON about the integer part: ".5" and "01" are not numbers
+    const char* integer = parser->text + digits;
+    if (integer[0] < '0' || integer[0] > '9') return false;
+    if (integer[0] == '0' && parser->position > digits + 1 && integer[1] >= '0' && integer[1] <= '9') return false;
+
+    // strtod needs a terminated copy; numbers are short
+    char buffer[64];
+    size_t length = parser->position - start;
+    if (length >= sizeof(buffer)) return false;
+    memcpy(buffer, parser->text + start, length);
+    buffer[length] = '\0';
+
+    char* end = NULL;
+    *number = strtod(buffer, &end);
+    return end == buffer + length && isfinite(*number);
+}
+
+/*
+ * Parse an array or object body after its opening bracket
+ *
+ * Members are collected in a scratch buffer and copied into the arena once
+ * their count is known.
+ */
+static bool parse_container(JsonParser_t* parser, MetisJson_t* value, bool is_object) {
+    char close = is_object ? '}' : ']';
+    if (++parser->depth > JSON_MAX_DEPTH) return false;
+
+    MetisJson_t* items = NULL;
+    const char** keys = NULL;
+    int count = 0;
+    int capacity = 0;
+    bool ok = false;
+
+    skip_whitespace(parser);
+    if (parser->position < parser->length && parser->text[parser->position] == close) {
+        parser->position++;
+        ok = true;
+    }
+
+    while (!ok) {
+        if (count >= capacity) {
+            int new_capacity = capacity ? capacity * 2 : 8;
+            MetisJson_t* grown_items = realloc(items, sizeof(MetisJson_t) * new_capacity);
+            if (grown_items) items = grown_items;
+            const char** grown_keys = is_object ? realloc(keys, sizeof(char*) * new_capacity) : NULL;
+            if (grown_keys) keys = grown_keys;
+            if (!grown_items || (is_object && !grown_keys)) break;
+            capacity = new_capacity;
+        }
+
+        skip_whitespace(parser);
+        if (is_object) {
+            size_t key_length;
+            if (!parse_string(parser, &keys[count], &key_length)) break;
+            skip_whitespace(parser);
+            if (parser->position >= parser->length || parser->text[parser->position] != ':') break;
+            parser->position++;
+        }
+        if (!parse_value(parser, &items[count])) break;
+        count++;
+
+        skip_whitespace(parser);
+        if (parser->position >= parser->length) break;
+        char c = parser->text[parser->position++];
+        if (c == close) {
+            ok = true;
+        } else if (c != ',') {
+            break;
+        }
+    }
+
+    if (ok && count > 0) {
+        value->items = c_parser_arena_alloc(parser->arena, sizeof(MetisJson_t) * count);
+        value->keys = is_object ? c_parser_arena_alloc(parser->arena, sizeof(char*) * count) : NULL;
+        if (!value->items || (is_object && !value->keys)) {
+            ok = false;
+        } else {
+            memcpy(value->items, items, sizeof(MetisJson_t) * count);
+            if (is_object) memcpy(value->keys, keys, sizeof(char*) * count);
+            value->count = count;
+        }
+    }
+
+    free(items);
+    free(keys);
+    parser->depth--;
+    return ok;
+}
+
+/*
+ * Parse any value at the cursor
+ */
+static bool parse_value(JsonParser_t* parser, MetisJson_t* value) {
+    memset(value, 0, sizeof(*value));
+    skip_whitespace(parser);
+    if (parser->position >= parser->length) return false;
+
+    switch (parser->text[parser->position]) {
+        case '{':
+            parser->position++;
+            value->type = METIS_JSON_OBJECT;
+            return parse_container(parser, value, true);
+        case '[':
+            parser->position++;
+            value->type = METIS_JSON_ARRAY;
+            return parse_container(parser, value, false);
+        case '"':
+            value->type = METIS_JSON_STRING;
+            return parse_string(parser, &value->string, &value->length);
+        case 't':
+            value->type = METIS_JSON_BOOL;
+            value->boolean = true;
+            return consume_word(parser, "true");
+        case 'f':
+            value->type = METIS_JSON_BOOL;
+            return consume_word(parser, "false");
+        case 'n':
+            value->type = METIS_JSON_NULL;
+            return consume_word(parser, "null");
+        default:
+            value->type = METIS_JSON_NUMBER;
+            return parse_number(parser, &value->number);
+    }
+}
+
+/*
+ * Parse one JSON text
+ */
+bool metis_json_parse(const char* text, size_t length, MetisJsonDocument_t* document) {
+    if (!document) return false;
+    memset(document, 0, sizeof(*document));
+    if (!text) return false;
+
+    document->root = c_parser_arena_alloc(&document->arena, sizeof(MetisJson_t));
+    if (!document->root) return false;
+
+    JsonParser_t parser = { .text = text, .length = length, .arena = &document->arena };
+    if (!parse_value(&parser, document->root)) return false;
+
+    skip_whitespace(&parser);
+    return parser.position == parser.length;
+}
+
+/*
+ * Free a parsed document
+ */
+void metis_json_free(MetisJsonDocument_t* document) {
+    if (!document) return;
+
+    c_parser_arena_release(&document->arena);
+    document->root = NULL;
+}
+
+/*
+ * Look up an object member by key
+ */
+const MetisJson_t* metis_json_get(const MetisJson_t* object, const char* key) {
+    if (!object || object->type != METIS_JSON_OBJECT || !key) return NULL;
+
+    // Duplicate keys resolve to the last one, as most JSON readers do
+    for (int i = object->count - 1; i >= 0; i--) {
+        if (strcmp(object->keys[i], key) == 0) return &object->items[i];
+    }
+    return NULL;
+}
+
+/*
+ * Read a member as a string
+ */
+const char* metis_json_get_string(const MetisJson_t* object, const char* key) {
+    const MetisJson_t* value = metis_json_get(object, key);
+    return value && value->type == METIS_JSON_STRING ? value->string : NULL;
+}
+
+/*
+ * Read a member as a number
+ */
+double metis_json_get_number(const MetisJson_t* object, const char* key, double fallback) {
+    const MetisJson_t* value = metis_json_get(object, key);
+    return value && value->type == METIS_JSON_NUMBER ? value->number : fallback;
+}
+
+/*
+ * Read a member as a boolean
+ */
+bool metis_json_get_bool(const MetisJson_t* object, const char* key, bool fallback) {
+    const MetisJson_t* value = metis_json_get(object, key);
+    return value && value->type == METIS_JSON_BOOL ? value->boolean : fallback;
+}
+
+// =============================================================================
+// WRITING
+// =============================================================================
+
+/*
+ * Write `length` bytes of text as a quoted, escaped JSON string
+ */
+void metis_json_write_string(FILE* out, const char* text, size_t length) {
+    if (!out) return;
+    if (!text) {
+        fputs("null", out);
+        return;
+    }
+
+    fputc('"', out);
+    size_t run = 0;     // Start of the pending run of bytes that need no escaping
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        fwrite(text + run, 1, i - run, out);
+        run = i + 1;
+        switch (c) {
+            case '"': fputs("\\\"", out); break;
+            case '\\': fputs("\\\\", out); break;
+            case '\n': fputs("\\n", out); break;
+            case '\r': fputs("\\r", out); break;
+            case '\t': fputs("\\t", out); break;
+            default: fprintf(out, "\\u%04x", c); break;
+        }
+    }
+    fwrite(text + run, 1, length - run, out);
+    fputc('"', out);
+}
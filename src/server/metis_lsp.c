@@ -0,0 +1,808 @@
+/* metis_lsp.c - Language Server Protocol front end: open buffers linted on a worker thread */
+// INSERT WISDOM HERE
+
+#define _POSIX_C_SOURCE 200809L  // For open_memstream, sigaction and strdup
+
+#include "metis_lsp.h"
+#include "metis_json.h"
+#include "metis_linter.h"
+#include "cli_utils.h"
+#include "c_parser.h"
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+#define LSP_READ_CHUNK 65536
+#define LSP_MAX_MESSAGE_BYTES (256u * 1024 * 1024)
+
+// JSON-RPC and LSP error codes
+#define LSP_INVALID_REQUEST -32600
+#define LSP_METHOD_NOT_FOUND -32601
+#define LSP_SERVER_NOT_INITIALIZED -32002
+
+// LSP DiagnosticSeverity
+#define LSP_SEVERITY_ERROR 1
+#define LSP_SEVERITY_WARNING 2
+#define LSP_SEVERITY_INFORMATION 3
+
+/*
+ * One buffer the client has open
+ */
+typedef struct LspDocument {
+    char* uri;
+    char* path;                 // What the linter sees: decoded file:// path, else the URI
+    char* text;
+    size_t length;
+    size_t capacity;
+    int version;
+    unsigned generation;        // Bumped by every change
+    unsigned linted_generation; // Generation last handed to the worker
+    unsigned long dirty_since;  // Order in which buffers became dirty, oldest linted first
+    struct LspDocument* next;
+} LspDocument_t;
+
+/*
+ * Session state shared by the reader (calling thread) and the lint worker
+ *
+ * Lock order: `lock` before `output_lock`, never the reverse.
+ */
+typedef struct {
+    FILE* output;
+    pthread_mutex_t output_lock;    // One message at a time on `output`
+    pthread_mutex_t lock;           // Guards everything below
+    pthread_cond_t work;
+    LspDocument_t* documents;
+    unsigned long change_counter;
+    bool utf8_positions;
+    bool stopping;
+    bool output_failed;             // The client stopped reading; give up (guarded by output_lock)
+} LspServer_t;
+
+/*
+ * A buffer copied out for the worker, so analysis runs without holding the lock
+ */
+typedef struct {
+    char* uri;
+    char* path;
+    char* text;
+    size_t length;
+    int version;
+    bool utf8_positions;
+} LspSnapshot_t;
+
+// =============================================================================
+// MESSAGES
+// =============================================================================
+
+/*
+ * Buffered reader over the client's descriptor
+ */
+typedef struct {
+    int fd;
+    char* buffer;
+    size_t used;
+    size_t capacity;
+    size_t consumed;    // Bytes of `buffer` already returned
+} LspReader_t;
+
+/*
+ * Read more input into the reader; false at end of input or on error
+ */
+static bool fill_reader(LspReader_t* reader) {
+    if (reader->consumed > 0) {
+        memmove(reader->buffer, reader->buffer + reader->consumed, reader->used - reader->consumed);
+        reader->used -= reader->consumed;
+        reader->consumed = 0;
+    }
+    if (reader->capacity - reader->used < LSP_READ_CHUNK) {
+        if (reader->capacity > LSP_MAX_MESSAGE_BYTES) return false;
+        char* grown = realloc(reader->buffer, reader->capacity + LSP_READ_CHUNK * 4);
+        if (!grown) return false;
+        reader->buffer = grown;
+        reader->capacity += LSP_READ_CHUNK * 4;
+    }
+
+    for (;;) {
+        ssize_t bytes_read = read(reader->fd, reader->buffer + reader->used, reader->capacity - reader->used);
+        if (bytes_read < 0 && errno == EINTR) continue;
+        if (bytes_read <= 0) return false;
+        reader->used += (size_t)bytes_read;
+        return true;
+    }
+}
+
+/*
+ * Read one framed message body
+ *
+ * `const char*` - Body inside the reader's buffer, valid until the next call,
+ *                 or NULL at end of input
+ */
+static const char* read_message(LspReader_t* reader, size_t* length_out) {
+    for (;;) {
+        // Headers end at a blank line; only Content-Length matters
+        char* start = reader->buffer + reader->consumed;
+        size_t available = reader->used - reader->consumed;
+        char* headers_end = NULL;
+        for (size_t i = 0; available >= 4 && i <= available - 4; i++) {
+            if (memcmp(start + i, "\r\n\r\n", 4) == 0) {
+                headers_end = start + i;
+                break;
+            }
+        }
+
+        if (headers_end) {
+            size_t body_length = 0;
+            bool has_length = false;
+            for (char* line = start; line < headers_end; ) {
+                char* line_end = line;
+                while (line_end < headers_end && *line_end != '\r') line_end++;
+                if (line_end - line > 15 && strncasecmp(line, "Content-Length:", 15) == 0) {
+                    body_length = (size_t)strtoull(line + 15, NULL, 10);
+                    has_length = true;
+                }
+                line = line_end + 2;
+            }
+            if (!has_length || body_length > LSP_MAX_MESSAGE_BYTES) return NULL;
+
+            size_t header_length = (size_t)(headers_end - start) + 4;
+            while (reader->used - reader->consumed < header_length + body_length) {
+                if (!fill_reader(reader)) return NULL;
+            }
+
+            const char* body = reader->buffer + reader->consumed + header_length;
+            reader->consumed += header_length + body_length;
+            *length_out = body_length;
+            return body;
+        }
+
+        if (!fill_reader(reader)) return NULL;
+    }
+}
+
+/*
+ * Frame and send one message body
+ *
+ * -- Takes output_lock unless the caller already holds it
+ */
+static void send_message(LspServer_t* server, const char* body, size_t length, bool locked) {
+    if (!locked) pthread_mutex_lock(&server->output_lock);
+    if (!server->output_failed) {
+        fprintf(server->output, "Content-Length: %zu\r\n\r\n", length);
+        fwrite(body, 1, length, server->output);
+        if (fflush(server->output) != 0 || ferror(server->output)) server->output_failed = true;
+    }
+    if (!locked) pthread_mutex_unlock(&server->output_lock);
+}
+
+/*
+ * Whether writing to the client has failed
+ */
+static bool output_failed(LspServer_t* server) {
+    pthread_mutex_lock(&server->output_lock);
+    bool failed = server->output_failed;
+    pthread_mutex_unlock(&server->output_lock);
+    return failed;
+}
+
+/*
+ * Write a request id back as it came: number, string or null
+ */
+static void write_id(FILE* out, const MetisJson_t* id) {
+    if (id && id->type == METIS_JSON_STRING) {
+        metis_json_write_string(out, id->string, id->length);
+    } else if (id && id->type == METIS_JSON_NUMBER) {
+        fprintf(out, "%.17g", id->number);
+    } else {
+        fputs("null", out);
+    }
+}
+
+/*
+ * Answer a request with a raw JSON result, or with an error when `error_code` is non-zero
+ */
+static void send_response(LspServer_t* server, const MetisJson_t* id, const char* result,
+                          int error_code, const char* error_message) {
+    char* body = NULL;
+    size_t length = 0;
+    FILE* out = open_memstream(&body, &length);
+    if (!out) return;
+
+    fputs("{\"jsonrpc\":\"2.0\",\"id\":", out);
+    write_id(out, id);
+    if (error_code != 0) {
+        fprintf(out, ",\"error\":{\"code\":%d,\"message\":", error_code);
+        metis_json_write_string(out, error_message, strlen(error_message));
+        fputs("}}", out);
+    } else {
+        fprintf(out, ",\"result\":%s}", result);
+    }
+    fclose(out);
+
+    send_message(server, body, length, false);
+    free(body);
+}
+
+// =============================================================================
+// POSITIONS
+// =============================================================================
+
+/*
+ * Bytes in the UTF-8 sequence starting with `lead`
+ */
+static size_t utf8_sequence_length(unsigned char lead) {
+    if (lead >= 0xF0) return 4;
+    if (lead >= 0xE0) return 3;
+    if (lead >= 0xC0) return 2;
+    return 1;
+}
+
+/*
+ * Byte offset of an LSP position, clamped to the text
+ */
+static size_t position_to_offset(const char* text, size_t length, int line, int character, bool utf8) {
+    size_t offset = 0;
+    for (int current = 0; current < line; current++) {
+        const char* newline = memchr(text + offset, '\n', length - offset);
+        if (!newline) return length;
+        offset = (size_t)(newline - text) + 1;
+    }
+
+    // Characters count UTF-16 code units unless UTF-8 was negotiated
+    while (character > 0 && offset < length && text[offset] != '\n') {
+        size_t bytes = utf8 ? 1 : utf8_sequence_length((unsigned char)text[offset]);
+        character -= bytes == 4 ? 2 : 1;
+        offset += bytes;
+    }
+    return offset < length ? offset : length;
+}
+
+/*
+ * Character index of byte `offset` within a line starting at `line_start`
+ */
+static int offset_to_character(const char* text, size_t line_start, size_t offset, bool utf8) {
+    if (utf8) return (int)(offset - line_start);
+
+    int character = 0;
+    for (size_t i = line_start; i < offset; ) {
+        size_t bytes = utf8_sequence_length((unsigned char)text[i]);
+        character += bytes == 4 ? 2 : 1;
+        i += bytes;
+    }
+    return character;
+}
+
+/*
+ * Start offset of every line, so diagnostics convert without rescanning the text
+ */
+static size_t* index_lines(const char* text, size_t length, int* count_out) {
+    int capacity = 1024;
+    int count = 0;
+    size_t* starts = malloc(sizeof(size_t) * capacity);
+    if (!starts) return NULL;
+
+    starts[count++] = 0;
+    for (const char* newline = memchr(text, '\n', length); newline;
+         newline = memchr(newline + 1, '\n', length - (size_t)(newline + 1 - text))) {
+        if (count == capacity) {
+            capacity *= 2;
+            size_t* grown = realloc(starts, sizeof(size_t) * capacity);
+            if (!grown) {
+                free(starts);
+                return NULL;
+            }
+            starts = grown;
+        }
+        starts[count++] = (size_t)(newline - text) + 1;
+    }
+    *count_out = count;
+    return starts;
+}
+
+// =============================================================================
+// DOCUMENTS
+// =============================================================================
+
+/*
+ * Decode a file:// URI to a path; any other URI is used as is
+ */
+static char* uri_to_path(const char* uri) {
+    if (strncmp(uri, "file://", 7) != 0) return strdup(uri);
+
+    const char* encoded = uri + 7;
+    char* path = malloc(strlen(encoded) + 1);
+    if (!path) return NULL;
+
+    size_t used = 0;
+    for (const char* c = encoded; *c; c++) {
+        unsigned value;
+        if (c[0] == '%' && c[1] && c[2] && sscanf(c + 1, "%2x", &value) == 1) {
+            path[used++] = (char)value;
+            c += 2;
+        } else {
+            path[used++] = *c;
+        }
+    }
+    path[used] = '\0';
+    return path;
+}
+
+/*
+ * Find an open document by URI - caller holds lock
+ */
+static LspDocument_t* find_document(LspServer_t* server, const char* uri) {
+    for (LspDocument_t* document = server->documents; document; document = document->next) {
+        if (strcmp(document->uri, uri) == 0) return document;
+    }
+    return NULL;
+}
+
+/*
+ * Free a document
+ */
+static void free_document(LspDocument_t* document) {
+    free(document->uri);
+    free(document->path);
+    free(document->text);
+    free(document);
+}
+
+/*
+ * Replace bytes [start, end) of a document's text - caller holds lock
+ */
+static bool splice_text(LspDocument_t* document, size_t start, size_t end, const char* text, size_t length) {
+    size_t new_length = document->length - (end - start) + length;
+    if (new_length + 1 > document->capacity) {
+        size_t capacity = document->capacity ? document->capacity : 4096;
+        while (capacity < new_length + 1) capacity *= 2;
+        char* grown = realloc(document->text, capacity);
+        if (!grown) return false;
+        document->text = grown;
+        document->capacity = capacity;
+    }
+
+    memmove(document->text + start + length, document->text + end, document->length - end);
+    memcpy(document->text + start, text, length);
+    document->length = new_length;
+    document->text[new_length] = '\0';
+    return true;
+}
+
+/*
+ * Queue a document for the worker - caller holds lock
+ */
+static void mark_dirty(LspServer_t* server, LspDocument_t* document) {
+    // A buffer already waiting keeps its place in line while it takes more keystrokes
+    if (document->linted_generation == document->generation) {
+        document->dirty_since = ++server->change_counter;
+    }
+    document->generation++;
+    pthread_cond_signal(&server->work);
+}
+
+/*
+ * Build a publishDiagnostics notification for a snapshot's findings
+ *
+ * Findings located in another file (the matching header) are left out; that file
+ * gets them when it is opened itself, against its own text.
+ */
+static char* diagnostics_message(const LspSnapshot_t* snapshot, const MetisFindings_t* findings, size_t* length_out) {
+    char* body = NULL;
+    FILE* out = open_memstream(&body, length_out);
+    if (!out) return NULL;
+
+    int line_count = 0;
+    size_t* lines = findings->count > 0 ? index_lines(snapshot->text, snapshot->length, &line_count) : NULL;
+
+    fputs("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":", out);
+    metis_json_write_string(out, snapshot->uri, strlen(snapshot->uri));
+    fprintf(out, ",\"version\":%d,\"diagnostics\":[", snapshot->version);
+
+    int published = 0;
+    for (int i = 0; lines && i < findings->count; i++) {
+        const MetisFinding_t* finding = &findings->findings[i];
+        if (finding->file_path && strcmp(finding->file_path, snapshot->path) != 0) continue;
+
+        int line = finding->line > 0 ? finding->line - 1 : 0;
+        if (line >= line_count) line = line_count - 1;
+
+        // Underline from the reported column (or the first non-blank) to the end of the line
+        size_t line_start = lines[line];
+        size_t line_end = line + 1 < line_count ? lines[line + 1] - 1 : snapshot->length;
+        while (line_end > line_start && (snapshot->text[line_end - 1] == '\r' || snapshot->text[line_end - 1] == ' ' ||
+                                         snapshot->text[line_end - 1] == '\t')) {
+            line_end--;
+        }
+        size_t start = line_start;
+        if (finding->column > 1) {
+            start = line_start + (size_t)(finding->column - 1);
+            if (start > line_end) start = line_end;
+        } else {
+            while (start < line_end && (snapshot->text[start] == ' ' || snapshot->text[start] == '\t')) start++;
+        }
+
+        int severity = finding->severity == METIS_FINDING_ERROR ? LSP_SEVERITY_ERROR
+                     : finding->severity == METIS_FINDING_WARNING ? LSP_SEVERITY_WARNING
+                     : LSP_SEVERITY_INFORMATION;
+        fprintf(out, "%s{\"range\":{\"start\":{\"line\":%d,\"character\":%d},\"end\":{\"line\":%d,\"character\":%d}},"
+                     "\"severity\":%d,\"source\":\"metis\",\"code\":",
+                published++ > 0 ? "," : "", line, offset_to_character(snapshot->text, line_start, start, snapshot->utf8_positions),
+                line, offset_to_character(snapshot->text, line_start, line_end, snapshot->utf8_positions), severity);
+        metis_json_write_string(out, finding->category, strlen(finding->category));
+        fputs(",\"message\":", out);
+        if (finding->suggestion && *finding->suggestion) {
+            size_t message_length = strlen(finding->message);
+            size_t suggestion_length = strlen(finding->suggestion);
+            char* combined = malloc(message_length + suggestion_length + 2);
+            if (combined) {
+                memcpy(combined, finding->message, message_length);
+                combined[message_length] = '\n';
+                memcpy(combined + message_length + 1, finding->suggestion, suggestion_length + 1);
+                metis_json_write_string(out, combined, message_length + 1 + suggestion_length);
+                free(combined);
+            } else {
+                metis_json_write_string(out, finding->message, message_length);
+            }
+        } else {
+            metis_json_write_string(out, finding->message, strlen(finding->message));
+        }
+        fputc('}', out);
+    }
+    fputs("]}}", out);
+    fclose(out);
+    free(lines);
+    return body;
+}
+
+/*
+ * Tell the client a closed buffer has no diagnostics - caller holds output_lock
+ */
+static void send_cleared_diagnostics(LspServer_t* server, const char* uri) {
+    char* body = NULL;
+    size_t length = 0;
+    FILE* out = open_memstream(&body, &length);
+    if (!out) return;
+
+    fputs("{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":", out);
+    metis_json_write_string(out, uri, strlen(uri));
+    fputs(",\"diagnostics\":[]}}", out);
+    fclose(out);
+
+    send_message(server, body, length, true);
+    free(body);
+}
+
+// =============================================================================
+// LINT WORKER
+// =============================================================================
+
+/*
+ * Pick the dirty document waiting longest - caller holds lock
+ */
+static LspDocument_t* next_dirty_document(LspServer_t* server) {
+    LspDocument_t* oldest = NULL;
+    for (LspDocument_t* document = server->documents; document; document = document->next) {
+        if (document->linted_generation != document->generation &&
+            (!oldest || document->dirty_since < oldest->dirty_since)) {
+            oldest = document;
+        }
+    }
+    return oldest;
+}
+
+/*
+ * Free a snapshot's copies
+ */
+static void free_snapshot(LspSnapshot_t* snapshot) {
+    free(snapshot->uri);
+    free(snapshot->path);
+    free(snapshot->text);
+}
+
+/*
+ * Worker thread: lint dirty buffers one at a time, always their latest text
+ */
+static void* lint_worker(void* arg) {
+    LspServer_t* server = arg;
+    c_parser_pool_begin();
+
+    pthread_mutex_lock(&server->lock);
+    while (!server->stopping) {
+        LspDocument_t* document = next_dirty_document(server);
+        if (!document) {
+            pthread_cond_wait(&server->work, &server->lock);
+            continue;
+        }
+
+        // Copy the buffer so the reader can keep applying keystrokes meanwhile
+        LspSnapshot_t snapshot = {
+            .uri = strdup(document->uri),
+            .path = strdup(document->path),
+            .text = malloc(document->length + 1),
+            .length = document->length,
+            .version = document->version,
+            .utf8_positions = server->utf8_positions
+        };
+        document->linted_generation = document->generation;
+        if (snapshot.text) memcpy(snapshot.text, document->text, document->length + 1);
+        pthread_mutex_unlock(&server->lock);
+
+        // A nested run per lint: its end retires the atoms this keystroke's spelling interned
+        MetisFindings_t findings = { 0 };
+        char* body = NULL;
+        size_t length = 0;
+        c_parser_cache_begin();
+        if (snapshot.uri && snapshot.path && snapshot.text &&
+            metis_linter_analyze(snapshot.path, snapshot.text, snapshot.length, &findings)) {
+            body = diagnostics_message(&snapshot, &findings, &length);
+        }
+        metis_linter_free_findings(&findings);
+        c_parser_cache_end();
+
+        // Publish only while the buffer is open; hand over to output_lock so a close cannot slip in between
+        pthread_mutex_lock(&server->lock);
+        if (body && find_document(server, snapshot.uri)) {
+            pthread_mutex_lock(&server->output_lock);
+            pthread_mutex_unlock(&server->lock);
+            send_message(server, body, length, true);
+            pthread_mutex_unlock(&server->output_lock);
+            pthread_mutex_lock(&server->lock);
+        }
+        free(body);
+        free_snapshot(&snapshot);
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    c_parser_pool_end();
+    return NULL;
+}
+
+// =============================================================================
+// NOTIFICATIONS
+// =============================================================================
+
+/*
+ * textDocument/didOpen
+ */
+static void handle_did_open(LspServer_t* server, const MetisJson_t* params) {
+    const MetisJson_t* item = metis_json_get(params, "textDocument");
+    const char* uri = metis_json_get_string(item, "uri");
+    const MetisJson_t* text = metis_json_get(item, "text");
+    if (!uri || !text || text->type != METIS_JSON_STRING) return;
+
+    pthread_mutex_lock(&server->lock);
+    LspDocument_t* document = find_document(server, uri);
+    if (!document) {
+        document = calloc(1, sizeof(LspDocument_t));
+        if (document) {
+            document->uri = strdup(uri);
+            document->path = uri_to_path(uri);
+            if (!document->uri || !document->path) {
+                free_document(document);
+                document = NULL;
+            } else {
+                document->next = server->documents;
+                server->documents = document;
+            }
+        }
+    }
+    if (document) {
+        document->version = (int)metis_json_get_number(item, "version", 0);
+        if (splice_text(document, 0, document->length, text->string, text->length)) {
+            mark_dirty(server, document);
+        }
+    }
+    pthread_mutex_unlock(&server->lock);
+}
+
+/*
+ * textDocument/didChange: whole-text or ranged edits, applied in order
+ */
+static void handle_did_change(LspServer_t* server, const MetisJson_t* params) {
+    const MetisJson_t* item = metis_json_get(params, "textDocument");
+    const MetisJson_t* changes = metis_json_get(params, "contentChanges");
+    const char* uri = metis_json_get_string(item, "uri");
+    if (!uri || !changes || changes->type != METIS_JSON_ARRAY) return;
+
+    pthread_mutex_lock(&server->lock);
+    LspDocument_t* document = find_document(server, uri);
+    if (document) {
+        document->version = (int)metis_json_get_number(item, "version", document->version);
+        for (int i = 0; i < changes->count; i++) {
+            const MetisJson_t* change = &changes->items[i];
+            const MetisJson_t* text = metis_json_get(change, "text");
+            const MetisJson_t* range = metis_json_get(change, "range");
+            if (!text || text->type != METIS_JSON_STRING) continue;
+
+            size_t start = 0;
+            size_t end = document->length;
+            if (range) {
+                const MetisJson_t* from = metis_json_get(range, "start");
+                const MetisJson_t* to = metis_json_get(range, "end");
+                start = position_to_offset(document->text, document->length,
+                                           (int)metis_json_get_number(from, "line", 0),
+                                           (int)metis_json_get_number(from, "character", 0), server->utf8_positions);
+                end = position_to_offset(document->text, document->length,
+                                         (int)metis_json_get_number(to, "line", 0),
+                                         (int)metis_json_get_number(to, "character", 0), server->utf8_positions);
+                if (end < start) end = start;
+            }
+            splice_text(document, start, end, text->string, text->length);
+        }
+        mark_dirty(server, document);
+    }
+    pthread_mutex_unlock(&server->lock);
+}
+
+/*
+ * textDocument/didSave: a saved header changes what every buffer including it sees
+ */
+static void handle_did_save(LspServer_t* server, const MetisJson_t* params) {
+    const char* uri = metis_json_get_string(metis_json_get(params, "textDocument"), "uri");
+    size_t length = uri ? strlen(uri) : 0;
+    if (length < 2 || strcmp(uri + length - 2, ".h") != 0) return;
+
+    pthread_mutex_lock(&server->lock);
+    for (LspDocument_t* document = server->documents; document; document = document->next) {
+        if (strcmp(document->uri, uri) != 0) mark_dirty(server, document);
+    }
+    pthread_mutex_unlock(&server->lock);
+}
+
+/*
+ * textDocument/didClose
+ */
+static void handle_did_close(LspServer_t* server, const MetisJson_t* params) {
+    const char* uri = metis_json_get_string(metis_json_get(params, "textDocument"), "uri");
+    if (!uri) return;
+
+    pthread_mutex_lock(&server->lock);
+    LspDocument_t** link = &server->documents;
+    while (*link && strcmp((*link)->uri, uri) != 0) link = &(*link)->next;
+    LspDocument_t* document = *link;
+    if (!document) {
+        pthread_mutex_unlock(&server->lock);
+        return;
+    }
+    *link = document->next;
+
+    pthread_mutex_lock(&server->output_lock);
+    pthread_mutex_unlock(&server->lock);
+    send_cleared_diagnostics(server, document->uri);
+    pthread_mutex_unlock(&server->output_lock);
+    free_document(document);
+}
+
+// =============================================================================
+// SESSION
+// =============================================================================
+
+/*
+ * Whether the client accepts UTF-8 positions
+ */
+static bool client_offers_utf8(const MetisJson_t* params) {
+    const MetisJson_t* general = metis_json_get(metis_json_get(params, "capabilities"), "general");
+    const MetisJson_t* encodings = metis_json_get(general, "positionEncodings");
+    if (!encodings || encodings->type != METIS_JSON_ARRAY) return false;
+
+    for (int i = 0; i < encodings->count; i++) {
+        if (encodings->items[i].type == METIS_JSON_STRING && strcmp(encodings->items[i].string, "utf-8") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Answer initialize with what this server can do
+ */
+static void handle_initialize(LspServer_t* server, const MetisJson_t* id, const MetisJson_t* params) {
+    pthread_mutex_lock(&server->lock);
+    server->utf8_positions = client_offers_utf8(params);
+    pthread_mutex_unlock(&server->lock);
+
+    // textDocumentSync.change 2 = incremental
+    char result[512];
+    snprintf(result, sizeof(result),
+             "{\"capabilities\":{\"positionEncoding\":\"%s\","
+             "\"textDocumentSync\":{\"openClose\":true,\"change\":2,\"save\":{\"includeText\":false}}},"
+             "\"serverInfo\":{\"name\":\"metis\",\"version\":\"%s\"}}",
+             server->utf8_positions ? "utf-8" : "utf-16", METIS_VERSION);
+    send_response(server, id, result, 0, NULL);
+}
+
+/*
+ * Speak the Language Server Protocol until the client says exit
+ */
+int metis_lsp_run(int input_fd, FILE* output) {
+    if (!output) return 1;
+
+    LspServer_t server = { .output = output };
+    pthread_mutex_init(&server.output_lock, NULL);
+    pthread_mutex_init(&server.lock, NULL);
+    pthread_cond_init(&server.work, NULL);
+
+    // A client that hangs up mid-write must end the session, not the process
+    struct sigaction ignore_action = { .sa_handler = SIG_IGN };
+    struct sigaction old_pipe;
+    sigemptyset(&ignore_action.sa_mask);
+    sigaction(SIGPIPE, &ignore_action, &old_pipe);
+
+    // One parse cache run for the session keeps every header parse shared between buffers.
+    // Resident parses are read rather than mapped, so an editor rewriting a header is harmless
+    c_parser_cache_begin();
+    c_parser_cache_set_resident(true);
+
+    pthread_t worker;
+    bool worker_started = pthread_create(&worker, NULL, lint_worker, &server) == 0;
+
+    LspReader_t reader = { .fd = input_fd };
+    bool initialized = false;
+    bool shut_down = false;
+    bool exited = false;
+    const char* body;
+    size_t length;
+    while (!exited && !output_failed(&server) && (body = read_message(&reader, &length)) != NULL) {
+        MetisJsonDocument_t message;
+        if (!metis_json_parse(body, length, &message) || message.root->type != METIS_JSON_OBJECT) {
+            metis_json_free(&message);
+            continue;
+        }
+
+        const char* method = metis_json_get_string(message.root, "method");
+        const MetisJson_t* id = metis_json_get(message.root, "id");
+        const MetisJson_t* params = metis_json_get(message.root, "params");
+
+        if (!method) {
+            // A response to something we never ask: ignore
+        } else if (strcmp(method, "exit") == 0) {
+            exited = true;
+        } else if (shut_down) {
+            if (id) send_response(&server, id, NULL, LSP_INVALID_REQUEST, "Server is shutting down");
+        } else if (strcmp(method, "initialize") == 0) {
+            initialized = true;
+            handle_initialize(&server, id, params);
+        } else if (!initialized) {
+            if (id) send_response(&server, id, NULL, LSP_SERVER_NOT_INITIALIZED, "Server is not initialized");
+        } else if (strcmp(method, "shutdown") == 0) {
+            shut_down = true;
+            send_response(&server, id, "null", 0, NULL);
+        } else if (strcmp(method, "textDocument/didOpen") == 0) {
+            handle_did_open(&server, params);
+        } else if (strcmp(method, "textDocument/didChange") == 0) {
+            handle_did_change(&server, params);
+        } else if (strcmp(method, "textDocument/didSave") == 0) {
+            handle_did_save(&server, params);
+        } else if (strcmp(method, "textDocument/didClose") == 0) {
+            handle_did_close(&server, params);
+        } else if (id) {
+            send_response(&server, id, NULL, LSP_METHOD_NOT_FOUND, "Method not supported");
+        }
+        metis_json_free(&message);
+    }
+    free(reader.buffer);
+
+    pthread_mutex_lock(&server.lock);
+    server.stopping = true;
+    pthread_cond_signal(&server.work);
+    pthread_mutex_unlock(&server.lock);
+    if (worker_started) pthread_join(worker, NULL);
+
+    while (server.documents) {
+        LspDocument_t* next = server.documents->next;
+        free_document(server.documents);
+        server.documents = next;
+    }
+    c_parser_cache_set_resident(false);
+    c_parser_cache_end();
+    sigaction(SIGPIPE, &old_pipe, NULL);
+
+    pthread_cond_destroy(&server.work);
+    pthread_mutex_destroy(&server.lock);
+    pthread_mutex_destroy(&server.output_lock);
+    return shut_down && exited ? 0 : 1;
+}
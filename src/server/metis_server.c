@@ -0,0 +1,532 @@
+/* metis_server.c - Long-running lint server on a Unix socket, and its client */
+// INSERT WISDOM HERE
+
+#define _POSIX_C_SOURCE 200809L  // For open_memstream, sigaction and strdup
+
+#include "metis_server.h"
+#include "metis.h"
+#include "metis_json.h"
+#include "c_parser.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define SERVER_READ_CHUNK 65536
+#define SERVER_MAX_REQUEST_BYTES (256u * 1024 * 1024)  // One request line; larger ones close the connection
+
+// Woken by metis_server_stop() and the signal handler to end the accept loop. Created once
+// and never closed, so a late stop can never write to a descriptor reused for something else
+static pthread_once_t wake_pipe_once = PTHREAD_ONCE_INIT;
+static int wake_read_fd = -1;
+static atomic_int wake_write_fd = -1;
+
+// Open connections, so stopping can interrupt them and wait for their threads
+static pthread_mutex_t connections_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t connections_idle = PTHREAD_COND_INITIALIZER;
+static int* connection_fds = NULL;
+static int connection_count = 0;
+static int connection_capacity = 0;
+
+// =============================================================================
+// REQUESTS
+// =============================================================================
+
+/*
+ * Public name of a diagnostic severity
+ */
+static const char* severity_name(MetisSeverity severity) {
+    switch (severity) {
+        case METIS_SEVERITY_ERROR: return "error";
+        case METIS_SEVERITY_WARNING: return "warning";
+        case METIS_SEVERITY_INFO: return "info";
+        default: return "hint";
+    }
+}
+
+/*
+ * Build an error response line
+ */
+static char* error_response(const char* message) {
+    char* response = NULL;
+    size_t length = 0;
+    FILE* out = open_memstream(&response, &length);
+    if (!out) return NULL;
+
+    fputs("{\"ok\":false,\"error\":", out);
+    metis_json_write_string(out, message, strlen(message));
+    fputs("}\n", out);
+    fclose(out);
+    return response;
+}
+
+/*
+ * Build the response line for a finished lint
+ */
+static char* report_response(const MetisLintReport* report) {
+    char* response = NULL;
+    size_t length = 0;
+    FILE* out = open_memstream(&response, &length);
+    if (!out) return NULL;
+
+    fprintf(out, "{\"ok\":true,\"files_analyzed\":%zu,\"files_unreadable\":%zu,\"diagnostics\":[",
+            report->files_analyzed, report->files_unreadable);
+    for (size_t i = 0; i < report->count; i++) {
+        const MetisDiagnostic* diagnostic = &report->diagnostics[i];
+        fputs(i > 0 ? ",{\"file\":" : "{\"file\":", out);
+        metis_json_write_string(out, diagnostic->location.file, strlen(diagnostic->location.file));
+        fprintf(out, ",\"line\":%zu,\"column\":%zu,\"severity\":\"%s\",\"rule\":",
+                diagnostic->location.line, diagnostic->location.column, severity_name(diagnostic->severity));
+        metis_json_write_string(out, diagnostic->rule_id, strlen(diagnostic->rule_id));
+        fputs(",\"message\":", out);
+        metis_json_write_string(out, diagnostic->message, strlen(diagnostic->message));
+        fputs(",\"suggestion\":", out);
+        metis_json_write_string(out, diagnostic->suggestion,
+                                diagnostic->suggestion ? strlen(diagnostic->suggestion) : 0);
+        fputc('}', out);
+    }
+    fputs("]}\n", out);
+    fclose(out);
+    return response;
+}
+
+/*
+ * Collect a request's files or buffers into `sources`
+ *
+ * `const char*` - NULL on success, otherwise what is wrong with the request
+ */
+static const char* read_request_sources(const MetisJson_t* root, MetisSource** sources_out, size_t* count_out) {
+    const MetisJson_t* paths = metis_json_get(root, "paths");
+    const MetisJson_t* buffers = metis_json_get(root, "sources");
+    const MetisJson_t* list = paths ? paths : buffers;
+    if (!list || list->type != METIS_JSON_ARRAY) return "Request needs a \"paths\" or \"sources\" array";
+
+    MetisSource* sources = calloc(list->count > 0 ? (size_t)list->count : 1, sizeof(MetisSource));
+    if (!sources) return "Out of memory";
+
+    for (int i = 0; i < list->count; i++) {
+        const MetisJson_t* item = &list->items[i];
+        if (paths) {
+            if (item->type != METIS_JSON_STRING) {
+                free(sources);
+                return "Every entry of \"paths\" must be a string";
+            }
+            sources[i].path = item->string;
+            continue;
+        }
+
+        const MetisJson_t* content = metis_json_get(item, "content");
+        sources[i].path = metis_json_get_string(item, "path");
+        if (!sources[i].path || (content && content->type != METIS_JSON_STRING)) {
+            free(sources);
+            return "Every entry of \"sources\" needs a \"path\" and may have a string \"content\"";
+        }
+        if (content) {
+            sources[i].content = content->string;
+            sources[i].length = content->length;
+        }
+    }
+
+    *sources_out = sources;
+    *count_out = (size_t)list->count;
+    return NULL;
+}
+
+/*
+ * Answer one request line, as the server does for each line it reads
+ */
+char* metis_server_handle_request(const char* request, size_t length) {
+    MetisJsonDocument_t document;
+    if (!metis_json_parse(request, length, &document) || document.root->type != METIS_JSON_OBJECT) {
+        metis_json_free(&document);
+        return error_response("Request is not a JSON object");
+    }
+
+    MetisSource* sources = NULL;
+    size_t source_count = 0;
+    const char* problem = read_request_sources(document.root, &sources, &source_count);
+
+    // Rule names point into the document, which outlives the lint
+    const MetisJson_t* rules = metis_json_get(document.root, "ignore_rules");
+    const char** ignore_rules = NULL;
+    MetisLintOptions options = { .ignore_warnings = metis_json_get_bool(document.root, "ignore_warnings", false) };
+    if (!problem && rules) {
+        if (rules->type != METIS_JSON_ARRAY) {
+            problem = "\"ignore_rules\" must be an array of rule ids";
+        } else if (rules->count > 0) {
+            ignore_rules = calloc((size_t)rules->count, sizeof(char*));
+            if (!ignore_rules) problem = "Out of memory";
+            for (int i = 0; ignore_rules && i < rules->count; i++) {
+                if (rules->items[i].type == METIS_JSON_STRING) {
+                    ignore_rules[options.ignore_count++] = rules->items[i].string;
+                }
+            }
+            options.ignore_rules = ignore_rules;
+        }
+    }
+
+    char* response;
+    if (problem) {
+        response = error_response(problem);
+    } else {
+        MetisLintReport report;
+        MetisResult result = metis_lint_sources(sources, source_count, &options, &report);
+
+        // Unreadable files are part of a normal answer, counted in files_unreadable
+        if (result == METIS_SUCCESS || result == METIS_ERROR_FILE_NOT_FOUND) {
+            response = report_response(&report);
+        } else {
+            const char* error = metis_get_last_error();
+            response = error_response(error ? error : "Lint failed");
+        }
+        metis_lint_report_free(&report);
+    }
+
+    free(ignore_rules);
+    free(sources);
+    metis_json_free(&document);
+    return response;
+}
+
+// =============================================================================
+// CONNECTIONS
+// =============================================================================
+
+/*
+ * Write all of `length` bytes to a socket
+ */
+static bool send_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        data += sent;
+        length -= (size_t)sent;
+    }
+    return true;
+}
+
+/*
+ * Start tracking an accepted connection
+ */
+static bool track_connection(int fd) {
+    pthread_mutex_lock(&connections_lock);
+    if (connection_count >= connection_capacity) {
+        int capacity = connection_capacity ? connection_capacity * 2 : 16;
+        int* grown = realloc(connection_fds, sizeof(int) * capacity);
+        if (!grown) {
+            pthread_mutex_unlock(&connections_lock);
+            return false;
+        }
+        connection_fds = grown;
+        connection_capacity = capacity;
+    }
+    connection_fds[connection_count++] = fd;
+    pthread_mutex_unlock(&connections_lock);
+    return true;
+}
+
+/*
+ * Stop tracking a connection and close it
+ */
+static void untrack_connection(int fd) {
+    pthread_mutex_lock(&connections_lock);
+    for (int i = 0; i < connection_count; i++) {
+        if (connection_fds[i] == fd) {
+            connection_fds[i] = connection_fds[--connection_count];
+            break;
+        }
+    }
+    close(fd);
+    if (connection_count == 0) pthread_cond_broadcast(&connections_idle);
+    pthread_mutex_unlock(&connections_lock);
+}
+
+/*
+ * Connection thread: answer each request line until the client hangs up
+ */
+static void* serve_connection(void* arg) {
+    int fd = (int)(intptr_t)arg;
+    char* buffer = NULL;
+    size_t used = 0;
+    size_t capacity = 0;
+    size_t scanned = 0;     // Bytes already known to hold no newline
+
+    for (;;) {
+        if (capacity - used < SERVER_READ_CHUNK) {
+            if (capacity >= SERVER_MAX_REQUEST_BYTES) {
+                char* response = error_response("Request too large");
+                if (response) send_all(fd, response, strlen(response));
+                free(response);
+                break;
+            }
+            char* grown = realloc(buffer, capacity + SERVER_READ_CHUNK * 4);
+            if (!grown) break;
+            buffer = grown;
+            capacity += SERVER_READ_CHUNK * 4;
+        }
+
+        ssize_t bytes_read = recv(fd, buffer + used, capacity - used, 0);
+        if (bytes_read < 0 && errno == EINTR) continue;
+        if (bytes_read <= 0) break;
+        used += (size_t)bytes_read;
+
+        // Answer every complete line; keep any partial one for the next read
+        size_t start = 0;
+        char* newline;
+        bool open = true;
+        while (open && (newline = memchr(buffer + scanned, '\n', used - scanned)) != NULL) {
+            size_t end = (size_t)(newline - buffer);
+            if (end > start) {
+                char* response = metis_server_handle_request(buffer + start, end - start);
+                open = response && send_all(fd, response, strlen(response));
+                free(response);
+            }
+            start = end + 1;
+            scanned = start;
+        }
+        if (!open) break;
+
+        memmove(buffer, buffer + start, used - start);
+        used -= start;
+        scanned = used;
+    }
+
+    free(buffer);
+    untrack_connection(fd);
+    return NULL;
+}
+
+// =============================================================================
+// SERVER LIFECYCLE
+// =============================================================================
+
+/*
+ * SIGINT/SIGTERM handler: wake the accept loop (write() is async-signal-safe)
+ */
+static void handle_stop_signal(int signal_number) {
+    (void)signal_number;
+    int saved_errno = errno;
+    int wake_fd = atomic_load(&wake_write_fd);
+    if (wake_fd >= 0) {
+        ssize_t ignored = write(wake_fd, "x", 1);
+        (void)ignored;
+    }
+    errno = saved_errno;
+}
+
+/*
+ * Ask a running metis_server_run() to stop
+ */
+void metis_server_stop(void) {
+    handle_stop_signal(0);
+}
+
+/*
+ * Create the process's wake pipe, non-blocking at both ends
+ */
+static void create_wake_pipe(void) {
+    int ends[2];
+    if (pipe(ends) != 0) return;
+    for (int i = 0; i < 2; i++) {
+        fcntl(ends[i], F_SETFD, FD_CLOEXEC);
+        fcntl(ends[i], F_SETFL, O_NONBLOCK);
+    }
+    wake_read_fd = ends[0];
+    atomic_store(&wake_write_fd, ends[1]);
+}
+
+/*
+ * Fill a socket address for `socket_path`, failing if it does not fit
+ */
+static bool make_socket_address(const char* socket_path, struct sockaddr_un* address) {
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    if (!socket_path || strlen(socket_path) >= sizeof(address->sun_path)) return false;
+    strcpy(address->sun_path, socket_path);
+    return true;
+}
+
+/*
+ * Open a listening socket, replacing a stale socket file but never a live server
+ */
+static int open_listener(const char* socket_path) {
+    struct sockaddr_un address;
+    if (!make_socket_address(socket_path, &address)) {
+        fprintf(stderr, "err: socket path is too long: %s\n", socket_path);
+        return -1;
+    }
+
+    struct stat st;
+    if (lstat(socket_path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "err: %s exists and is not a socket\n", socket_path);
+            return -1;
+        }
+        int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        bool live = probe >= 0 && connect(probe, (struct sockaddr*)&address, sizeof(address)) == 0;
+        if (probe >= 0) close(probe);
+        if (live) {
+            fprintf(stderr, "err: a server is already listening on %s\n", socket_path);
+            return -1;
+        }
+        unlink(socket_path);
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) != 0 ||
+        bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(fd, SOMAXCONN) != 0) {
+        fprintf(stderr, "err: cannot listen on %s: %s\n", socket_path, strerror(errno));
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Serve lint requests on a Unix socket until stopped
+ */
+int metis_server_run(const char* socket_path) {
+    // Open the socket first: a refused second server must not drain the running one's stop requests
+    int listener = open_listener(socket_path);
+    if (listener < 0) return 1;
+
+    pthread_once(&wake_pipe_once, create_wake_pipe);
+    if (wake_read_fd < 0) {
+        fprintf(stderr, "err: cannot create server wake pipe: %s\n", strerror(errno));
+        close(listener);
+        unlink(socket_path);
+        return 1;
+    }
+
+    // Forget stop requests meant for an earlier server
+    char drained[64];
+    while (read(wake_read_fd, drained, sizeof(drained)) > 0) {}
+
+    struct sigaction stop_action = { .sa_handler = handle_stop_signal };
+    struct sigaction ignore_action = { .sa_handler = SIG_IGN };
+    struct sigaction old_int, old_term, old_pipe;
+    sigemptyset(&stop_action.sa_mask);
+    sigemptyset(&ignore_action.sa_mask);
+    sigaction(SIGINT, &stop_action, &old_int);
+    sigaction(SIGTERM, &stop_action, &old_term);
+    sigaction(SIGPIPE, &ignore_action, &old_pipe);
+
+    // One parse cache run for the server's lifetime keeps parses warm between requests;
+    // an edited file replaces its old parse, so memory stays at one parse per file
+    c_parser_cache_begin();
+    c_parser_cache_set_resident(true);
+
+    struct pollfd watched[2] = {
+        { .fd = listener, .events = POLLIN },
+        { .fd = wake_read_fd, .events = POLLIN }
+    };
+    for (;;) {
+        if (poll(watched, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (watched[1].revents) break;
+        if (!(watched[0].revents & POLLIN)) continue;
+
+        int client = accept(listener, NULL, NULL);
+        if (client < 0) continue;
+        fcntl(client, F_SETFD, FD_CLOEXEC);
+
+        pthread_t thread;
+        pthread_attr_t attributes;
+        pthread_attr_init(&attributes);
+        pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+        if (!track_connection(client)) {
+            close(client);
+        } else if (pthread_create(&thread, &attributes, serve_connection, (void*)(intptr_t)client) != 0) {
+            untrack_connection(client);
+        }
+        pthread_attr_destroy(&attributes);
+    }
+
+    close(listener);
+    unlink(socket_path);
+
+    // Hang up on idle clients so their threads finish, then wait for every one
+    pthread_mutex_lock(&connections_lock);
+    for (int i = 0; i < connection_count; i++) {
+        shutdown(connection_fds[i], SHUT_RDWR);
+    }
+    while (connection_count > 0) {
+        pthread_cond_wait(&connections_idle, &connections_lock);
+    }
+    free(connection_fds);
+    connection_fds = NULL;
+    connection_capacity = 0;
+    pthread_mutex_unlock(&connections_lock);
+
+    c_parser_cache_set_resident(false);
+    c_parser_cache_end();
+    sigaction(SIGINT, &old_int, NULL);
+    sigaction(SIGTERM, &old_term, NULL);
+    sigaction(SIGPIPE, &old_pipe, NULL);
+    return 0;
+}
+
+// =============================================================================
+// CLIENT
+// =============================================================================
+
+/*
+ * Send one request to a server and wait for its response
+ */
+char* metis_server_call(const char* socket_path, const char* request, size_t length) {
+    struct sockaddr_un address;
+    if (!request || !make_socket_address(socket_path, &address)) return NULL;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return NULL;
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        !send_all(fd, request, length) || !send_all(fd, "\n", 1)) {
+        close(fd);
+        return NULL;
+    }
+
+    char* response = NULL;
+    size_t used = 0;
+    size_t capacity = 0;
+    bool complete = false;
+    while (!complete) {
+        if (capacity - used < SERVER_READ_CHUNK) {
+            char* grown = realloc(response, capacity + SERVER_READ_CHUNK * 4);
+            if (!grown) break;
+            response = grown;
+            capacity += SERVER_READ_CHUNK * 4;
+        }
+
+        ssize_t bytes_read = recv(fd, response + used, capacity - used - 1, 0);
+        if (bytes_read < 0 && errno == EINTR) continue;
+        if (bytes_read <= 0) break;
+
+        char* newline = memchr(response + used, '\n', (size_t)bytes_read);
+        used += (size_t)bytes_read;
+        if (newline) {
+            *newline = '\0';
+            complete = true;
+        }
+    }
+    close(fd);
+
+    if (!complete) {
+        free(response);
+        return NULL;
+    }
+    return response;
+}
@@ -0,0 +1,122 @@
+/* bench_c_parser_lexer.c - Lexer throughput benchmark over real C sources */
+// Measures how many megabytes per second c_parser_tokenize can chew through
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "c_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_ITERATIONS 50
+
+typedef struct {
+    char* content;
+    size_t length;
+} BenchFile_t;
+
+/*
+ * Read an entire file into a null-terminated buffer
+ */
+static char* read_whole_file(const char* path, size_t* length_out) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    char* content = malloc((size_t)size + 1);
+    if (!content) {
+        fclose(file);
+        return NULL;
+    }
+
+    size_t bytes_read = fread(content, 1, (size_t)size, file);
+    content[bytes_read] = '\0';
+    fclose(file);
+
+    *length_out = strlen(content);
+    return content;
+}
+
+/*
+ * Get a monotonic timestamp in seconds
+ */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+    int iterations = BENCH_DEFAULT_ITERATIONS;
+    int first_file = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        iterations = atoi(argv[2]);
+        if (iterations <= 0) iterations = BENCH_DEFAULT_ITERATIONS;
+        first_file = 3;
+    }
+
+    if (first_file >= argc) {
+        fprintf(stderr, "usage: %s [-n iterations] file.c [file.h ...]\n", argv[0]);
+        return 1;
+    }
+
+    int file_count = 0;
+    BenchFile_t* files = calloc((size_t)(argc - first_file), sizeof(BenchFile_t));
+    if (!files) return 1;
+
+    size_t total_bytes = 0;
+    for (int i = first_file; i < argc; i++) {
+        size_t length = 0;
+        char* content = read_whole_file(argv[i], &length);
+        if (!content) {
+            fprintf(stderr, "skipping unreadable file: %s\n", argv[i]);
+            continue;
+        }
+        files[file_count].content = content;
+        files[file_count].length = length;
+        total_bytes += length;
+        file_count++;
+    }
+
+    // Warm the caches and count tokens once outside the timed region
+    long total_tokens = 0;
+    for (int f = 0; f < file_count; f++) {
+        int token_count = 0;
+        Token_t* tokens = c_parser_tokenize(files[f].content, &token_count);
+        total_tokens += token_count;
+        c_parser_free_tokens(tokens, token_count);
+    }
+
+    double start = now_seconds();
+    for (int iter = 0; iter < iterations; iter++) {
+        for (int f = 0; f < file_count; f++) {
+            int token_count = 0;
+            Token_t* tokens = c_parser_tokenize(files[f].content, &token_count);
+            c_parser_free_tokens(tokens, token_count);
+        }
+    }
+    double elapsed = now_seconds() - start;
+
+    double megabytes = (double)total_bytes * iterations / (1024.0 * 1024.0);
+    printf("Lexer benchmark: %d files, %zu bytes, %ld tokens per pass\n",
+           file_count, total_bytes, total_tokens);
+    printf("  %d iterations in %.3fs -> %.1f MB/s, %.1f Mtokens/s\n",
+           iterations, elapsed,
+           elapsed > 0 ? megabytes / elapsed : 0.0,
+           elapsed > 0 ? (double)total_tokens * iterations / elapsed / 1e6 : 0.0);
+
+    for (int f = 0; f < file_count; f++) {
+        free(files[f].content);
+    }
+    free(files);
+    return 0;
+}
@@ -0,0 +1,122 @@
+/* bench_c_parser_long_tokens.c - Parser benchmark over 64 KB comments and string tables */
+// Guards against long tokens being split and re-lexed as code, and times how fast they parse
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "c_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_ITERATIONS 200
+#define BENCH_BLOCK_COUNT 8                 // License block + string table + function, repeated
+#define BENCH_COMMENT_BYTES (64 * 1024)     // Size of each license/Doxygen style comment
+#define BENCH_TABLE_BYTES (64 * 1024)       // Size of each string table initializer
+
+/*
+ * Append formatted text to a growing buffer, aborting the benchmark on overflow
+ */
+static void append(char** cursor, const char* end, const char* text) {
+    size_t length = strlen(text);
+    if (*cursor + length >= end) {
+        fprintf(stderr, "bench_c_parser_long_tokens: generated input overflowed\n");
+        exit(1);
+    }
+    memcpy(*cursor, text, length);
+    *cursor += length;
+    **cursor = '\0';
+}
+
+/*
+ * Build a vendored-header style source: each block is a huge comment whose text
+ * looks like code, a large string table, and one real function
+ */
+static char* build_source(size_t* length_out) {
+    size_t capacity = BENCH_BLOCK_COUNT * (BENCH_COMMENT_BYTES + BENCH_TABLE_BYTES + 1024);
+    char* source = malloc(capacity);
+    if (!source) return NULL;
+
+    char* cursor = source;
+    const char* end = source + capacity;
+    *cursor = '\0';
+
+    for (int block = 0; block < BENCH_BLOCK_COUNT; block++) {
+        append(&cursor, end, "/*\n");
+        size_t comment_start = (size_t)(cursor - source);
+        while ((size_t)(cursor - source) - comment_start < BENCH_COMMENT_BYTES) {
+            append(&cursor, end, " * int looks_like_code(char* dst) { strcpy(dst, \"x\"); return 0; }\n");
+        }
+        append(&cursor, end, " */\nstatic const char* table[] = {\n");
+
+        size_t table_start = (size_t)(cursor - source);
+        while ((size_t)(cursor - source) - table_start < BENCH_TABLE_BYTES) {
+            append(&cursor, end, "    \"0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz\",\n");
+        }
+
+        char function[128];
+        snprintf(function, sizeof(function), "};\n\nint real_function_%d(void) {\n    return %d;\n}\n\n", block, block);
+        append(&cursor, end, function);
+    }
+
+    *length_out = (size_t)(cursor - source);
+    return source;
+}
+
+/*
+ * Get a monotonic timestamp in seconds
+ */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+    int iterations = BENCH_DEFAULT_ITERATIONS;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        iterations = atoi(argv[2]);
+        if (iterations <= 0) iterations = BENCH_DEFAULT_ITERATIONS;
+    }
+
+    size_t length = 0;
+    char* source = build_source(&length);
+    if (!source) return 1;
+
+    // Correctness first: every comment must stay one token and only real functions may appear
+    ParsedFile_t* parsed = c_parser_parse_content(source, "long_tokens.c");
+    if (!parsed) {
+        fprintf(stderr, "bench_c_parser_long_tokens: parse failed\n");
+        free(source);
+        return 1;
+    }
+
+    int comment_tokens = 0;
+    for (int i = 0; i < parsed->token_store.count; i++) {
+        if (parsed->token_store.kinds[i] == TOKEN_COMMENT_BLOCK) comment_tokens++;
+    }
+
+    int token_count = parsed->token_count;
+    bool correct = (comment_tokens == BENCH_BLOCK_COUNT && parsed->function_count == BENCH_BLOCK_COUNT);
+    if (!correct) {
+        fprintf(stderr, "bench_c_parser_long_tokens: expected %d comments and %d functions, got %d and %d\n",
+                BENCH_BLOCK_COUNT, BENCH_BLOCK_COUNT, comment_tokens, parsed->function_count);
+    }
+    c_parser_free_parsed_file(parsed);
+
+    double start = now_seconds();
+    for (int iter = 0; iter < iterations; iter++) {
+        ParsedFile_t* timed = c_parser_parse_content(source, "long_tokens.c");
+        c_parser_free_parsed_file(timed);
+    }
+    double elapsed = now_seconds() - start;
+
+    double megabytes = (double)length * iterations / (1024.0 * 1024.0);
+    printf("Long token benchmark: %zu bytes, %d tokens, %d x 64 KB comments and string tables\n",
+           length, token_count, BENCH_BLOCK_COUNT);
+    printf("  %d parses in %.3fs -> %.1f MB/s\n",
+           iterations, elapsed, elapsed > 0 ? megabytes / elapsed : 0.0);
+
+    free(source);
+    return correct ? 0 : 1;
+}
@@ -1,11 +1,17 @@
 /* test_c_parser_advanced.c - Advanced tests for the C parser divine wisdom */
 // INSERT WISDOM HERE
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "tests.h"
 #include "c_parser.h"
 #include <stdio.h>
+#include <pthread.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 #define LOG(msg) printf("%s | File: %s, Line: %d\n", msg, __FILE__, __LINE__)
 
@@ -208,10 +214,10 @@ static int test_valid_oneline_documentation_recognition(void) {
     // Show first 20 tokens to understand the token stream
     printf("\nFirst 20 tokens:\n");
     for (int i = 0; i < parsed->token_count && i < 20; i++) {
-        printf("Token %d: type=%s, value='%s', line=%d\n", 
-               i, c_parser_token_type_name(parsed->tokens[i].type),
-               parsed->tokens[i].value ? parsed->tokens[i].value : "NULL",
-               parsed->tokens[i].line);
+        printf("Token %d: type=%s, value='%.*s', line=%d\n", 
+               i, c_parser_token_type_name(c_parser_tokens(parsed)[i].type),
+               c_parser_tokens(parsed)[i].length, c_parser_token_text(parsed->source, &c_parser_tokens(parsed)[i]),
+               c_parser_tokens(parsed)[i].line);
     }
     printf("\n");
     
@@ -366,7 +372,7 @@ static int test_comprehensive_token_parsing(void) {
     bool has_operators = false;
     
     for (int i = 0; i < parsed->token_count; i++) {
-        switch (parsed->tokens[i].type) {
+        switch (c_parser_tokens(parsed)[i].type) {
             case TOKEN_KEYWORD:
                 has_keywords = true;
                 break;
@@ -394,6 +400,823 @@ static int test_comprehensive_token_parsing(void) {
     return 1;
 }
 
+/*
+ * Test that tokens are views into the parsed file's own source buffer
+ */
+static int test_token_views_into_source(void) {
+    LOG("Testing zero-copy token views");
+    
+    char content[] = "int answer = 42; /* note */";
+    ParsedFile_t* parsed = c_parser_parse_content(content, "views.c");
+    
+    TEST_ASSERT(parsed != NULL, "Parser should create parsed file structure");
+    TEST_ASSERT(parsed->source != NULL, "Parsed file should own a source buffer");
+    TEST_ASSERT(parsed->source != content, "Source buffer should be a private copy of the input");
+    TEST_ASSERT(parsed->source_length == strlen(content), "Source length should match the input");
+    
+    // Mutating the caller's buffer must not affect the parsed tokens
+    memset(content, 'x', sizeof(content) - 1);
+    
+    Token_t* ident = NULL;
+    Token_t* comment = NULL;
+    for (int i = 0; i < parsed->token_count; i++) {
+        if (c_parser_tokens(parsed)[i].type == TOKEN_IDENTIFIER && !ident) ident = &c_parser_tokens(parsed)[i];
+        if (c_parser_tokens(parsed)[i].type == TOKEN_COMMENT_BLOCK) comment = &c_parser_tokens(parsed)[i];
+    }
+    TEST_ASSERT(ident != NULL && comment != NULL, "Should find identifier and comment tokens");
+    
+    TEST_ASSERT(c_parser_token_equals(parsed->source, ident, "answer"), "Identifier should equal 'answer'");
+    TEST_ASSERT(!c_parser_token_equals(parsed->source, ident, "answe"), "Prefix should not compare equal");
+    TEST_ASSERT(!c_parser_token_equals(parsed->source, ident, "answers"), "Longer text should not compare equal");
+    TEST_ASSERT(c_parser_token_text(parsed->source, ident) == parsed->source + 4, "Text should point into the source");
+    TEST_ASSERT(c_parser_token_contains(parsed->source, comment, "note"), "Comment should contain 'note'");
+    TEST_ASSERT(!c_parser_token_contains(parsed->source, comment, "answer"), "Search must stay inside the token");
+    
+    char small[4];
+    size_t copied = c_parser_token_copy_to(parsed->source, ident, small, sizeof(small));
+    TEST_ASSERT(copied == 3 && strcmp(small, "ans") == 0, "Copy should truncate and terminate");
+    
+    char* dup = c_parser_token_strdup(parsed->source, comment);
+    TEST_ASSERT(dup != NULL && strcmp(dup, "/* note */") == 0, "Strdup should return the full comment");
+    free(dup);
+    
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Test that every word in the generated perfect hash tables maps to its own ID
+ */
+static int test_perfect_hash_word_ids(void) {
+    LOG("Testing perfect hash keyword, type and dangerous function IDs");
+    
+    #define CHECK_KEYWORD(id, text) \
+        TEST_ASSERT(c_parser_keyword_id(text, strlen(text)) == C_KEYWORD_##id, "Keyword " text " should map to its ID");
+    #define CHECK_TYPE(id, text) \
+        TEST_ASSERT(c_parser_type_keyword_id(text, strlen(text)) == C_TYPE_##id, "Type word " text " should map to its ID");
+    #define CHECK_DANGEROUS(id, text) \
+        TEST_ASSERT(c_parser_dangerous_function_id(text, strlen(text)) == C_DANGEROUS_##id, "Function " text " should map to its ID");
+    
+    C_PARSER_C_KEYWORDS(CHECK_KEYWORD)
+    C_PARSER_TYPE_KEYWORDS(CHECK_TYPE)
+    C_PARSER_DANGEROUS_FUNCTIONS(CHECK_DANGEROUS)
+    
+    #undef CHECK_KEYWORD
+    #undef CHECK_TYPE
+    #undef CHECK_DANGEROUS
+    
+    // Near misses must not match: prefixes, extensions, case changes, other sets
+    TEST_ASSERT(c_parser_keyword_id("whil", 4) == C_KEYWORD_NONE, "Prefix of keyword should not match");
+    TEST_ASSERT(c_parser_keyword_id("whiles", 6) == C_KEYWORD_NONE, "Extension of keyword should not match");
+    TEST_ASSERT(c_parser_keyword_id("While", 5) == C_KEYWORD_NONE, "Keywords are case-sensitive");
+    TEST_ASSERT(c_parser_keyword_id("size_t", 6) == C_KEYWORD_NONE, "Type names are not keywords");
+    TEST_ASSERT(c_parser_type_keyword_id("static", 6) == C_TYPE_NONE, "Storage class is not a type word");
+    TEST_ASSERT(c_parser_dangerous_function_id("strcmp", 6) == C_DANGEROUS_NONE, "strcmp is not in the dangerous set");
+    TEST_ASSERT(c_parser_keyword_id(NULL, 3) == C_KEYWORD_NONE, "NULL text should not match");
+    TEST_ASSERT(c_parser_keyword_id("", 0) == C_KEYWORD_NONE, "Empty text should not match");
+    
+    // Lookups work on views that are not null-terminated
+    const char* view = "returnx";
+    TEST_ASSERT(c_parser_keyword_id(view, 6) == C_KEYWORD_RETURN, "View of 'return' should match");
+    TEST_ASSERT(c_parser_keyword_id(view, 7) == C_KEYWORD_NONE, "Full 'returnx' should not match");
+    
+    return 1;
+}
+
+/*
+ * Test that punctuators, operators and keywords carry their sub-kind
+ */
+static int test_token_sub_kinds(void) {
+    LOG("Testing token sub-kinds for punctuators, operators and keywords");
+    
+    const char* source = "while (a->b && c[0] <<= 2) { return x.y; }";
+    const TokenSubKind_t expected[] = {
+        KW_WHILE, PUNCT_LPAREN, TOKEN_SUB_NONE, OP_ARROW, TOKEN_SUB_NONE, OP_LOGICAL_AND,
+        TOKEN_SUB_NONE, PUNCT_LBRACKET, TOKEN_SUB_NONE, PUNCT_RBRACKET, OP_SHIFT_LEFT, OP_ASSIGN,
+        TOKEN_SUB_NONE, PUNCT_RPAREN, PUNCT_LBRACE, KW_RETURN, TOKEN_SUB_NONE, PUNCT_DOT,
+        TOKEN_SUB_NONE, PUNCT_SEMICOLON, PUNCT_RBRACE
+    };
+    const int expected_count = (int)(sizeof(expected) / sizeof(expected[0]));
+    
+    int token_count = 0;
+    Token_t* tokens = c_parser_tokenize(source, &token_count);
+    TEST_ASSERT(tokens != NULL, "Tokenizer should produce tokens");
+    TEST_ASSERT(token_count == expected_count, "Token count should match the expected stream");
+    
+    for (int i = 0; i < expected_count && i < token_count; i++) {
+        TEST_ASSERT(tokens[i].sub_kind == expected[i], "Token sub-kind should match");
+    }
+    
+    // Keyword sub-kinds round-trip through the keyword IDs
+    TEST_ASSERT(TOKEN_SUB_TO_KEYWORD(tokens[0].sub_kind) == C_KEYWORD_WHILE, "KW_WHILE should map back to C_KEYWORD_WHILE");
+    TEST_ASSERT(TOKEN_SUB_FROM_KEYWORD(C_KEYWORD_RETURN) == KW_RETURN, "C_KEYWORD_RETURN should map to KW_RETURN");
+    
+    c_parser_free_tokens(tokens, token_count);
+    return 1;
+}
+
+/*
+ * Test that the struct-of-arrays store and its Token_t adapters agree
+ */
+static int test_token_store_adapters(void) {
+    LOG("Testing token store arrays against the Token_t adapters");
+    
+    const char* source = "/* doc */\nint add(int a, int b) {\n    return a + b;\n}\n";
+    ParsedFile_t* parsed = c_parser_parse_content(source, "store.c");
+    TEST_ASSERT(parsed != NULL, "Parsing should succeed");
+    TEST_ASSERT(parsed->tokens == NULL, "Token_t view should not be built until requested");
+    TEST_ASSERT(parsed->token_count == parsed->token_store.count, "Token count should match the store");
+    
+    int token_count = 0;
+    Token_t* standalone = c_parser_tokenize(source, &token_count);
+    TEST_ASSERT(standalone != NULL, "Standalone tokenizing should succeed");
+    TEST_ASSERT(token_count == parsed->token_count, "Standalone and parsed token counts should match");
+    
+    Token_t* view = c_parser_tokens(parsed);
+    TEST_ASSERT(view != NULL, "Token_t view should be built on request");
+    TEST_ASSERT(c_parser_tokens(parsed) == view, "Token_t view should be cached");
+    
+    const TokenStore_t* ts = &parsed->token_store;
+    for (int i = 0; i < token_count; i++) {
+        Token_t token = c_parser_token_at(parsed, i);
+        TEST_ASSERT(token.type == (TokenType_t)ts->kinds[i], "Gathered type should match the kinds array");
+        TEST_ASSERT(token.offset == ts->offsets[i] && token.length == ts->lengths[i], "Gathered view should match the store");
+        TEST_ASSERT(token.line == ts->lines[i], "Gathered line should match the store");
+        TEST_ASSERT(view[i].type == standalone[i].type && view[i].sub_kind == standalone[i].sub_kind &&
+                    view[i].offset == standalone[i].offset && view[i].length == standalone[i].length &&
+                    view[i].line == standalone[i].line && view[i].column == standalone[i].column,
+                    "View and standalone tokens should match");
+    }
+    
+    Token_t past_end = c_parser_token_at(parsed, token_count);
+    TEST_ASSERT(past_end.type == TOKEN_EOF, "Out-of-range index should give TOKEN_EOF");
+    
+    c_parser_free_tokens(standalone, token_count);
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Test the line-start index and the line-based queries built on it
+ */
+static int test_line_index_lookups(void) {
+    LOG("Testing line-start index and offset to line/column lookups");
+    
+    const char* source = "int a;\n\n  /* two\n lines */ int b;\nvoid f(void) {}\nint c;";
+    ParsedFile_t* parsed = c_parser_parse_content(source, "lines.c");
+    TEST_ASSERT(parsed != NULL, "Parsing should succeed");
+    TEST_ASSERT(parsed->line_index.count == 6, "Six lines should be indexed");
+    TEST_ASSERT(parsed->line_index.starts[0] == 0, "First line should start at offset 0");
+    TEST_ASSERT(parsed->line_index.starts[2] == 8, "Third line should start after the blank line");
+    
+    for (int i = 0; i < parsed->token_count; i++) {
+        TEST_ASSERT(c_parser_token_at(parsed, i).type != TOKEN_NEWLINE, "Newlines should not become tokens");
+    }
+    
+    int line = 0;
+    int column = 0;
+    TEST_ASSERT(c_parser_offset_to_line_column(parsed, 0, &line, &column) && line == 1 && column == 1,
+                "Offset 0 should be line 1, column 1");
+    TEST_ASSERT(c_parser_offset_to_line_column(parsed, 10, &line, &column) && line == 3 && column == 3,
+                "Comment start should be line 3, column 3");
+    TEST_ASSERT(c_parser_offset_to_line_column(parsed, 6, &line, &column) && line == 1 && column == 7,
+                "A newline byte belongs to the line it ends");
+    TEST_ASSERT(c_parser_offset_to_line_column(parsed, (uint32_t)strlen(source), &line, &column) && line == 6,
+                "End of source should map to the last line");
+    TEST_ASSERT(!c_parser_offset_to_line_column(parsed, (uint32_t)strlen(source) + 1, &line, &column),
+                "Offsets past the end should be rejected");
+    
+    // Every token position should agree with a lookup of its offset
+    for (int i = 0; i < parsed->token_count; i++) {
+        Token_t token = c_parser_token_at(parsed, i);
+        TEST_ASSERT(c_parser_offset_to_line_column(parsed, token.offset, &line, &column), "Token offset should resolve");
+        TEST_ASSERT(line == token.line && column == token.column, "Token position should match the lookup");
+    }
+    
+    TEST_ASSERT(c_parser_line_has_pattern(parsed, 4, "b"), "Line 4 should contain 'b'");
+    TEST_ASSERT(!c_parser_line_has_pattern(parsed, 2, "a"), "Blank line should match nothing");
+    TEST_ASSERT(!c_parser_line_has_pattern(parsed, 99, "a"), "Lines past the end should match nothing");
+    
+    FunctionInfo_t* func = c_parser_find_function_at_line(parsed, 5);
+    TEST_ASSERT(func != NULL && strcmp(func->name, "f") == 0, "Function f should be found on line 5");
+    TEST_ASSERT(c_parser_find_function_at_line(parsed, 4) == NULL, "No function starts on line 4");
+    
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Write `length` bytes of `content` to a fresh temporary file, returning its path
+ */
+static char* write_temp_source(const char* content, size_t length) {
+    char* path = strdup("/tmp/metis_input_XXXXXX");
+    int fd = path ? mkstemp(path) : -1;
+    if (fd < 0) {
+        free(path);
+        return NULL;
+    }
+    bool written = write(fd, content, length) == (ssize_t)length;
+    close(fd);
+    if (!written) {
+        unlink(path);
+        free(path);
+        return NULL;
+    }
+    return path;
+}
+
+/*
+ * Test mapped, read() fallback and pipe inputs all parse the same way
+ */
+static int test_source_input_open(void) {
+    LOG("Testing mmap-backed source input and its read() fallbacks");
+    
+    const char* source = "#include <stdio.h>\nint mapped(void) { return 1; }\n";
+    char* path = write_temp_source(source, strlen(source));
+    TEST_ASSERT(path != NULL, "Temporary source file should be written");
+    
+    SourceInput_t input;
+    TEST_ASSERT(c_parser_input_open(path, &input), "Regular file should open");
+    TEST_ASSERT(input.mapping != NULL, "Regular file should be memory-mapped");
+    TEST_ASSERT(input.length == strlen(source), "Input length should match the file");
+    TEST_ASSERT(input.data[input.length] == '\0', "Mapped input should end with a sentinel");
+    
+    const char* mapped_data = input.data;
+    ParsedFile_t* parsed = c_parser_parse_input(&input, path);
+    TEST_ASSERT(parsed != NULL, "Mapped input should parse");
+    TEST_ASSERT(parsed->source == mapped_data, "Parsed file should reference the mapping, not a copy");
+    TEST_ASSERT(input.data == NULL && input.mapping == NULL, "Parsing should take the input over");
+    c_parser_input_close(&input);  // No-op after the move
+    TEST_ASSERT(parsed->function_count == 1 && strcmp(parsed->functions[0].name, "mapped") == 0,
+                "Function in mapped input should be found");
+    TEST_ASSERT(parsed->include_count == 1, "Include in mapped input should be found");
+    c_parser_free_parsed_file(parsed);
+    
+    parsed = c_parser_parse_file(path);
+    TEST_ASSERT(parsed != NULL && parsed->input.mapping != NULL, "c_parser_parse_file should map the file");
+    c_parser_free_parsed_file(parsed);
+    unlink(path);
+    free(path);
+    
+    // A file filling whole pages has no room for the sentinel and is read instead
+    long page_size = sysconf(_SC_PAGESIZE);
+    char* page_source = malloc((size_t)page_size);
+    TEST_ASSERT(page_source != NULL, "Page buffer should allocate");
+    memset(page_source, ' ', (size_t)page_size);
+    memcpy(page_source, "int paged(void) { return 2; }", strlen("int paged(void) { return 2; }"));
+    page_source[page_size - 1] = '\n';
+    path = write_temp_source(page_source, (size_t)page_size);
+    TEST_ASSERT(path != NULL, "Page-sized source file should be written");
+    TEST_ASSERT(c_parser_input_open(path, &input), "Page-sized file should open");
+    TEST_ASSERT(input.mapping == NULL, "Page-sized file should fall back to read()");
+    TEST_ASSERT(input.length == (size_t)page_size && input.data[input.length] == '\0',
+                "Read input should hold the whole file plus a sentinel");
+    c_parser_input_close(&input);
+    TEST_ASSERT(input.data == NULL, "Closing should reset the input");
+    unlink(path);
+    free(path);
+    free(page_source);
+    
+    // Pipes cannot be mapped
+    int pipe_fds[2];
+    TEST_ASSERT(pipe(pipe_fds) == 0, "Pipe should be created");
+    TEST_ASSERT(write(pipe_fds[1], source, strlen(source)) == (ssize_t)strlen(source), "Pipe should accept the source");
+    close(pipe_fds[1]);
+    char pipe_path[64];
+    snprintf(pipe_path, sizeof(pipe_path), "/dev/fd/%d", pipe_fds[0]);
+    TEST_ASSERT(c_parser_input_open(pipe_path, &input), "Pipe should open through the read() fallback");
+    TEST_ASSERT(input.mapping == NULL && input.length == strlen(source), "Pipe input should be read whole");
+    TEST_ASSERT(strcmp(input.data, source) == 0, "Pipe input should match what was written");
+    c_parser_input_close(&input);
+    close(pipe_fds[0]);
+    
+    TEST_ASSERT(!c_parser_input_open("/nonexistent/metis/input.c", &input), "Missing file should fail");
+    TEST_ASSERT(input.data == NULL, "Failed open should leave the input empty");
+    TEST_ASSERT(!c_parser_input_open("/tmp", &input), "Directories should not open");
+    
+    return 1;
+}
+
+/*
+ * Test a run parses each file once, whatever path it is reached by
+ */
+static int test_parse_cache(void) {
+    LOG("Testing the per-run parse cache shares parses between handles");
+    
+    const char* source = "/* Shared */\nint shared(void) { return 1; }\n";
+    char* path = write_temp_source(source, strlen(source));
+    TEST_ASSERT(path != NULL, "Temporary source file should be written");
+    char alias[128];
+    snprintf(alias, sizeof(alias), "/tmp/..%s", path);
+    
+    // Outside a run every acquire parses privately
+    ParsedFile_t* first = c_parser_acquire_file(path);
+    ParsedFile_t* second = c_parser_acquire_file(path);
+    TEST_ASSERT(first != NULL && second != NULL, "Acquire without a run should parse");
+    TEST_ASSERT(first->source != second->source, "Acquires outside a run should not share");
+    TEST_ASSERT(first->functions[0].has_documentation, "Acquired parses should have documentation resolved");
+    c_parser_release_file(first);
+    c_parser_release_file(second);
+    
+    c_parser_cache_begin();
+    first = c_parser_acquire_file(path);
+    second = c_parser_acquire_file(alias);
+    TEST_ASSERT(first != NULL && second != NULL, "Acquire within a run should parse");
+    TEST_ASSERT(first->source == second->source, "Both spellings of one file should share a parse");
+    TEST_ASSERT(strcmp(first->file_path, path) == 0 && strcmp(second->file_path, alias) == 0,
+                "Each handle should keep the path it was acquired by");
+    c_parser_free_parsed_file(second);  // Freeing a handle only releases it
+    
+    // A file changed on disk is parsed again
+    const char* changed = "int shared(void) { return 1; }\nint added(void) { return 2; }\n";
+    FILE* file = fopen(path, "w");
+    TEST_ASSERT(file != NULL, "Temporary source file should reopen");
+    fputs(changed, file);
+    fclose(file);
+    second = c_parser_acquire_file(path);
+    TEST_ASSERT(second != NULL && second->source != first->source, "Changed file should be parsed again");
+    TEST_ASSERT(second->function_count == 2, "Re-parse should see the new contents");
+    c_parser_release_file(second);
+    
+    TEST_ASSERT(c_parser_acquire_file("/nonexistent/metis/input.c") == NULL, "Missing file should not be cached");
+    
+    // Handles outlive the run that produced them
+    c_parser_cache_end();
+    TEST_ASSERT(first->function_count == 1 && strcmp(first->functions[0].name, "shared") == 0,
+                "Handle should stay valid after the run ends");
+    c_parser_release_file(first);
+    
+    unlink(path);
+    free(path);
+    return 1;
+}
+
+/*
+ * Test a resident cache's parses survive their file being truncated
+ */
+static int test_resident_cache_truncation(void) {
+    LOG("Testing resident parses do not depend on their file staying intact");
+    
+    // Several pages, not a whole number of them, so the file would otherwise be mapped
+    char source[3 * 4096 + 100];
+    size_t length = 0;
+    while (length + 40 < sizeof(source)) {
+        length += (size_t)snprintf(source + length, sizeof(source) - length, "int f%zu(void) { return 1; }\n", length);
+    }
+    char* path = write_temp_source(source, length);
+    TEST_ASSERT(path != NULL, "Temporary source file should be written");
+    
+    c_parser_cache_begin();
+    c_parser_cache_set_resident(true);
+    ParsedFile_t* parsed = c_parser_acquire_file(path);
+    TEST_ASSERT(parsed != NULL && parsed->input.mapping == NULL, "Resident parses should not be mapped");
+    
+    // Reading a truncated mapping would raise SIGBUS here
+    int truncated = truncate(path, 0);
+    TEST_ASSERT(truncated == 0, "Temporary source file should truncate");
+    TEST_ASSERT(parsed->source_length == length && memcmp(parsed->source, source, length) == 0,
+                "Resident parse should keep the contents it read");
+    
+    c_parser_release_file(parsed);
+    c_parser_cache_set_resident(false);
+    c_parser_cache_end();
+    
+    unlink(path);
+    free(path);
+    return 1;
+}
+
+/*
+ * Test the per-call strcmp matcher agrees with the whole-file detector
+ */
+static int test_unsafe_strcmp_matcher(void) {
+    LOG("Testing c_parser_match_unsafe_strcmp on each strcmp call");
+    
+    const char* source =
+        "int check(dString_t* a, dString_t* b, const char* c) {\n"
+        "    if (strcmp(a->str, \"x\") == 0) return 1;\n"
+        "    if (strcmp(a->str, b->str) == 0) return 2;\n"
+        "    return strcmp(c, \"y\");\n"
+        "}\n";
+    ParsedFile_t* parsed = c_parser_parse_content(source, "strcmp.c");
+    TEST_ASSERT(parsed != NULL, "Source should parse");
+    
+    const TokenStore_t* ts = &parsed->token_store;
+    UnsafeStrcmpUsage_t matched[3];
+    int matched_count = 0;
+    int strcmp_calls = 0;
+    for (int i = 0; i < ts->count; i++) {
+        bool is_strcmp = ts->lengths[i] == 6 && memcmp(parsed->source + ts->offsets[i], "strcmp", 6) == 0;
+        if (is_strcmp) strcmp_calls++;
+        UnsafeStrcmpUsage_t usage;
+        if (c_parser_match_unsafe_strcmp(parsed, i, &usage)) {
+            TEST_ASSERT(is_strcmp, "Only strcmp tokens should match");
+            TEST_ASSERT(matched_count < 3, "No more than the unsafe calls should match");
+            matched[matched_count++] = usage;
+        }
+    }
+    TEST_ASSERT(strcmp_calls == 3, "Source should contain three strcmp calls");
+    TEST_ASSERT(matched_count == 2, "Only the two ->str comparisons should match");
+    TEST_ASSERT(matched[0].line == 2 && matched[0].is_dstring_vs_cstring, "First call compares dString_t with a C string");
+    TEST_ASSERT(matched[1].line == 3 && matched[1].is_dstring_vs_dstring, "Second call compares two dString_t");
+    TEST_ASSERT(strcmp(matched[0].function_name, "check") == 0, "Match should name its containing function");
+    TEST_ASSERT(!c_parser_match_unsafe_strcmp(parsed, -1, &matched[2]) &&
+                !c_parser_match_unsafe_strcmp(parsed, ts->count, &matched[2]), "Out-of-range tokens should not match");
+    
+    UnsafeStrcmpUsage_t* usages = NULL;
+    int usage_count = 0;
+    TEST_ASSERT(c_parser_detect_unsafe_strcmp_dstring_usage(parsed, &usages, &usage_count), "Detector should find usages");
+    TEST_ASSERT(usage_count == 2 && usages[0].line == matched[0].line && usages[1].line == matched[1].line &&
+                usages[1].column == matched[1].column, "Detector should report exactly what the matcher does");
+    free(usages);
+    
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Test the call-site table recorded while parsing
+ */
+static int test_call_site_table(void) {
+    LOG("Testing call sites, arguments and containing functions");
+    
+    const char* source =
+        "int g(int a, int b);\n"
+        "int f(int a) {\n"
+        "    printf(\"%d %d\", g(a, (a + 1)), h());\n"
+        "    int arr[2] = { k(1, 2), sizeof(int) };\n"
+        "    return arr[0];\n"
+        "}\n";
+    ParsedFile_t* parsed = c_parser_parse_content(source, "calls.c");
+    TEST_ASSERT(parsed != NULL, "Source should parse");
+    TEST_ASSERT(parsed->call_count == 4, "Should record printf, g, h and k but not the prototype or sizeof");
+    
+    const TokenStore_t* ts = &parsed->token_store;
+    const char* expected[] = { "printf", "g", "h", "k" };
+    int expected_args[] = { 3, 2, 0, 2 };
+    for (int c = 0; c < parsed->call_count && c < 4; c++) {
+        const CallSite_t* call = &parsed->calls[c];
+        size_t length = strlen(expected[c]);
+        TEST_ASSERT((size_t)ts->lengths[call->token_index] == length &&
+                    memcmp(parsed->source + ts->offsets[call->token_index], expected[c], length) == 0,
+                    "Calls should be recorded in source order");
+        TEST_ASSERT(call->arg_count == expected_args[c], "Each call should count its top-level arguments");
+        TEST_ASSERT(call->close_paren > call->token_index &&
+                    ts->sub_kinds[call->close_paren] == PUNCT_RPAREN, "Each call should find its closing parenthesis");
+        TEST_ASSERT(call->function_index >= 0 &&
+                    strcmp(parsed->functions[call->function_index].name, "f") == 0, "Calls should know their containing function");
+    }
+    TEST_ASSERT(parsed->calls[0].dangerous_id == C_DANGEROUS_PRINTF && parsed->calls[1].dangerous_id == C_DANGEROUS_NONE,
+                "Only dangerous callees should carry a dangerous-function ID");
+    
+    // g's second argument is the parenthesised expression, nested calls do not split printf's arguments
+    const CallArgRange_t* second = &parsed->call_args[parsed->calls[1].first_arg + 1];
+    TEST_ASSERT(second->end - second->start == 5, "(a + 1) should be one argument of five tokens");
+    
+    c_parser_free_parsed_file(parsed);
+    
+    parsed = c_parser_parse_content("void run(char* d) { strcpy(d, \"x\"); exit(1); }\n", "danger.c");
+    TEST_ASSERT(parsed != NULL && parsed->call_count == 2, "Dangerous source should parse with two calls");
+    TEST_ASSERT(parsed->calls[0].dangerous_id == C_DANGEROUS_STRCPY, "strcpy should carry its dangerous-function ID");
+    TEST_ASSERT(parsed->calls[1].dangerous_id == C_DANGEROUS_NONE, "exit is not a dangerous function");
+    c_parser_free_parsed_file(parsed);
+    
+    parsed = c_parser_parse_content("int f(void) { return m(1, n(", "truncated.c");
+    TEST_ASSERT(parsed != NULL && parsed->call_count == 2, "Truncated source should still record its calls");
+    TEST_ASSERT(parsed->calls[0].close_paren == -1 && parsed->calls[1].close_paren == -1,
+                "Unclosed calls should have no closing parenthesis");
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Test body token ranges and the one-pass complexity analysis built on them
+ */
+static int test_function_body_ranges(void) {
+    LOG("Testing function body ranges and batch complexity analysis");
+    
+    const char* source =
+        "static int nested(int x);\n"
+        "static int flat(void) {\n"
+        "    return 1;\n"
+        "}\n"
+        "static int nested(int x) {\n"
+        "    if (x && x > 1) {\n"
+        "        while (x) {\n"
+        "            for (;;) { return 1; }\n"
+        "        }\n"
+        "    }\n"
+        "    return 0;\n"
+        "}\n";
+    ParsedFile_t* parsed = c_parser_parse_content(source, "bodies.c");
+    TEST_ASSERT(parsed != NULL && parsed->function_count == 3, "Prototype and both definitions should be found");
+    
+    const TokenStore_t* ts = &parsed->token_store;
+    FunctionInfo_t* prototype = &parsed->functions[0];
+    FunctionInfo_t* flat = &parsed->functions[1];
+    FunctionInfo_t* nested = &parsed->functions[2];
+    TEST_ASSERT(prototype->body_start == -1 && prototype->body_end == -1, "A prototype should have no body");
+    TEST_ASSERT(ts->sub_kinds[flat->body_start] == PUNCT_LBRACE && ts->sub_kinds[flat->body_end] == PUNCT_RBRACE,
+                "Body range should span the braces");
+    TEST_ASSERT(ts->lines[flat->body_start] == 2 && ts->lines[flat->body_end] == 4, "flat's body should cover lines 2-4");
+    TEST_ASSERT(ts->lines[nested->body_end] == 12, "nested's body should end on its own closing brace");
+    
+    ComplexityAnalysis_t results[3];
+    TEST_ASSERT(c_parser_analyze_all_function_complexity(parsed, results), "Batch analysis should succeed");
+    TEST_ASSERT(results[0].function_length == 1 && results[0].complexity_score == 0, "Prototype should have no complexity");
+    TEST_ASSERT(results[1].function_length == 3 && results[1].nesting_depth == 0, "flat should be three lines with no nesting");
+    TEST_ASSERT(results[2].complexity_score == 4 && results[2].branch_count == 3, "nested should count three branches and one &&");
+    TEST_ASSERT(results[2].nesting_depth == 4 && results[2].has_deep_nesting, "nested should reach depth four");
+    TEST_ASSERT(results[2].function_length == 8 && results[2].has_multiple_returns, "nested should be eight lines with two returns");
+    TEST_ASSERT(!c_parser_analyze_all_function_complexity(parsed, NULL), "NULL results should be rejected");
+    
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Test that each function is linked to the comment nearest above it
+ */
+static int test_doc_comment_links(void) {
+    LOG("Testing per-function documentation links");
+    
+    const char* source =
+        "/*\n"
+        " * First function\n"
+        " *\n"
+        " * -- Details\n"
+        " */\n"
+        "int first(void);\n"
+        "/*\n"
+        " * Second function\n"
+        " * spills onto a second line\n"
+        " */\n"
+        "int second(void);\n"
+        "int bare(void);\n"
+        "int first(void);\n"
+        "/* beside */ int beside(void);\n";
+    ParsedFile_t* parsed = c_parser_parse_content(source, "docs.h");
+    TEST_ASSERT(parsed != NULL && parsed->function_count == 5, "All five declarations should be found");
+    
+    const TokenStore_t* ts = &parsed->token_store;
+    FunctionInfo_t* first = &parsed->functions[0];
+    FunctionInfo_t* second = &parsed->functions[1];
+    FunctionInfo_t* bare = &parsed->functions[2];
+    FunctionInfo_t* repeated = &parsed->functions[3];
+    FunctionInfo_t* beside = &parsed->functions[4];
+    TEST_ASSERT(first->has_documentation && ts->lines[first->doc_comment] == 1, "first should link the comment above it");
+    TEST_ASSERT(second->has_documentation && ts->lines[second->doc_comment] == 7,
+                "second should link its own comment, not the earlier one");
+    TEST_ASSERT(!bare->has_documentation && bare->doc_comment == second->doc_comment,
+                "Code between comment and function should break the documentation link");
+    TEST_ASSERT(!repeated->has_documentation, "A repeated declaration should be judged on its own comment");
+    TEST_ASSERT(!beside->has_documentation, "A comment on the function's own line is not documentation");
+    
+    TEST_ASSERT(c_parser_function_has_proper_doc_format(parsed, first), "first's comment follows the one-line format");
+    TEST_ASSERT(!c_parser_function_has_proper_doc_format(parsed, second), "second's two-line description should fail");
+    TEST_ASSERT(!c_parser_has_proper_header_doc_format(parsed, "second"), "Name lookup should agree with the direct check");
+    TEST_ASSERT(c_parser_has_documentation_for_function(parsed, "first"), "Name lookup should read the first match's link");
+    
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Test hashed function lookup by name
+ */
+static int test_function_name_index(void) {
+    LOG("Testing the function name index");
+    
+    // Enough names to force probing, plus a prototype repeated by its definition
+    char source[32768];
+    size_t used = 0;
+    used += snprintf(source + used, sizeof(source) - used, "int repeated(void);\n");
+    for (int i = 0; i < 300; i++) {
+        used += snprintf(source + used, sizeof(source) - used, "int fn_%d(void) { return %d; }\n", i, i);
+    }
+    snprintf(source + used, sizeof(source) - used, "int repeated(void) { return 0; }\n");
+    
+    ParsedFile_t* parsed = c_parser_parse_content(source, "index.c");
+    TEST_ASSERT(parsed != NULL && parsed->function_count == 302, "All declarations and definitions should be found");
+    TEST_ASSERT(parsed->function_index != NULL, "Parsing should build the name index");
+    
+    bool all_found = true;
+    for (int i = 0; i < parsed->function_count; i++) {
+        FunctionInfo_t* func = c_parser_find_function(parsed, parsed->functions[i].name);
+        if (!func || strcmp(func->name, parsed->functions[i].name) != 0) all_found = false;
+    }
+    TEST_ASSERT(all_found, "Every recorded function should be found by name");
+    TEST_ASSERT(c_parser_find_function(parsed, "repeated") == &parsed->functions[0],
+                "A repeated name should resolve to its first declaration");
+    TEST_ASSERT(c_parser_find_function(parsed, "fn_300") == NULL, "Unknown names should not be found");
+    TEST_ASSERT(c_parser_find_function(parsed, NULL) == NULL && c_parser_find_function(NULL, "fn_1") == NULL,
+                "NULL arguments should be rejected");
+    
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Test the arena that owns a parse's strings
+ */
+static int test_arena_allocation(void) {
+    LOG("Testing arena allocation, adoption and chunk reuse");
+    
+    Arena_t arena = {0};
+    char* name = c_parser_arena_strndup(&arena, "parse_thing(void)", 11);
+    TEST_ASSERT(name != NULL && strcmp(name, "parse_thing") == 0, "strndup should copy and terminate");
+    void* aligned = c_parser_arena_alloc(&arena, 24);
+    TEST_ASSERT(aligned != NULL && (uintptr_t)aligned % _Alignof(max_align_t) == 0, "Allocations should be aligned");
+    
+    // A request larger than a chunk must not disturb what is already there
+    char* big = c_parser_arena_alloc(&arena, 256 * 1024);
+    TEST_ASSERT(big != NULL, "Oversized requests should get their own chunk");
+    memset(big, 'x', 256 * 1024);
+    TEST_ASSERT(strcmp(name, "parse_thing") == 0, "Earlier strings should survive a big allocation");
+    
+    Arena_t other = {0};
+    char* moved = c_parser_arena_strdup(&other, "moved");
+    c_parser_arena_adopt(&arena, &other);
+    TEST_ASSERT(other.head == NULL && strcmp(moved, "moved") == 0, "Adopted allocations should stay valid");
+    TEST_ASSERT(c_parser_arena_strdup(&arena, NULL) == NULL, "NULL strings should not be copied");
+    
+    c_parser_arena_release(&arena);
+    TEST_ASSERT(arena.head == NULL && arena.used == 0, "Release should leave an empty arena");
+    c_parser_arena_release(&arena);
+    c_parser_arena_release(NULL);
+    
+    // The thread's released chunks are handed out again
+    Arena_t first = {0};
+    void* chunk_memory = c_parser_arena_alloc(&first, 16);
+    c_parser_arena_release(&first);
+    Arena_t second = {0};
+    TEST_ASSERT(c_parser_arena_alloc(&second, 16) == chunk_memory, "A released chunk should be reused on the same thread");
+    c_parser_arena_release(&second);
+    
+    // Parsed files keep their strings in their own arena
+    ParsedFile_t* parsed = c_parser_parse_content("#include <stdio.h>\nint add(int a, int b) { return a + b; }\n", "arena.c");
+    TEST_ASSERT(parsed != NULL && parsed->function_count == 1 && parsed->include_count == 1, "Source should parse");
+    TEST_ASSERT(parsed->functions[0].param_count == 2 && strcmp(parsed->functions[0].parameters[1], "int b") == 0,
+                "Parameters should be copied into the arena");
+    TEST_ASSERT(strcmp(parsed->includes[0], "stdio.h") == 0 && parsed->arena.head != NULL, "Includes should live in the arena");
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Test input-sized capacities and the per-thread parse buffer pool
+ */
+static int test_parse_pool(void) {
+    LOG("Testing size-aware capacities and parse buffer pooling");
+    
+    ParsedFile_t* tiny = c_parser_parse_content("int answer(void) { return 42; }\n", "tiny.c");
+    TEST_ASSERT(tiny != NULL && tiny->function_count == 1, "Tiny source should parse");
+    TEST_ASSERT(tiny->token_store.capacity < 256 && tiny->function_capacity < 32 && tiny->include_capacity < 32,
+                "Tiny sources should get small arrays");
+    c_parser_free_parsed_file(tiny);
+    
+    // Ordinary C is reserved for up front, so the token store is never doubled
+    static char big[96 * 1000];
+    size_t used = 0;
+    for (int i = 0; i < 1000; i++) {
+        used += (size_t)snprintf(big + used, sizeof(big) - used,
+                                 "/* Adds %d */\nstatic int add_%04d(int value) {\n    return value + %d;\n}\n\n", i, i, i);
+    }
+    ParsedFile_t* first = c_parser_parse_content(big, "big.c");
+    TEST_ASSERT(first != NULL && first->function_count == 1000, "Large source should parse");
+    TEST_ASSERT(first->token_store.capacity >= first->token_count &&
+                first->token_store.capacity < first->token_count * 2, "Token capacity should come from the input size");
+    TEST_ASSERT(first->function_capacity >= 1000, "Function capacity should cover every function");
+    
+    // With the pool open, the next parse on this thread reuses the freed arrays
+    c_parser_pool_begin();
+    uint8_t* kinds = first->token_store.kinds;
+    FunctionInfo_t* functions = first->functions;
+    c_parser_free_parsed_file(first);
+    
+    ParsedFile_t* second = c_parser_parse_content("#include <stdio.h>\nint add(int a, int b) { return a + b; }\n", "second.c");
+    TEST_ASSERT(second != NULL && second->token_store.kinds == kinds && second->functions == functions,
+                "A pooled parse's arrays should be reused");
+    TEST_ASSERT(second->function_count == 1 && strcmp(second->functions[0].name, "add") == 0 &&
+                second->include_count == 1 && strcmp(second->file_path, "second.c") == 0,
+                "A reused parse should hold only the new file");
+    
+    // Nested pools share one set of buffers; only the outermost end frees them
+    c_parser_pool_begin();
+    c_parser_free_parsed_file(second);
+    c_parser_pool_end();
+    ParsedFile_t* third = c_parser_parse_content("int x;\n", "third.c");
+    TEST_ASSERT(third != NULL && third->token_store.kinds == kinds, "An inner pool end should keep the buffers");
+    TEST_ASSERT(third->function_count == 0 && third->call_count == 0, "Stale functions should not leak into a reused parse");
+    c_parser_free_parsed_file(third);
+    c_parser_pool_end();
+    c_parser_pool_end();
+    return 1;
+}
+
+#define ATOM_TEST_THREADS 4
+#define ATOM_TEST_NAMES 500
+
+/*
+ * Intern the same generated names from several threads at once
+ */
+static void* intern_test_names(void* arg) {
+    Atom_t* atoms = arg;
+    char name[32];
+    for (int i = 0; i < ATOM_TEST_NAMES; i++) {
+        int length = snprintf(name, sizeof(name), "atom_thread_name_%d", i);
+        atoms[i] = c_parser_intern(name, (size_t)length);
+    }
+    return NULL;
+}
+
+/*
+ * Test the atom table and the atoms parsed functions carry
+ */
+static int test_atom_table(void) {
+    LOG("Testing interned atoms for names and return types");
+    
+    Atom_t first = c_parser_intern("atom_test_identifier", 20);
+    TEST_ASSERT(first != ATOM_NONE, "Interning should produce an atom");
+    TEST_ASSERT(c_parser_intern("atom_test_identifier(void)", 20) == first, "Equal text should intern to the same atom");
+    TEST_ASSERT(c_parser_intern("atom_test_identifier2", 21) != first, "Different text should get a different atom");
+    TEST_ASSERT(strcmp(c_parser_atom_text(first), "atom_test_identifier") == 0, "Atom text should round-trip");
+    TEST_ASSERT(c_parser_atom_find("atom_test_never_interned", 24) == ATOM_NONE, "Lookups should not add strings");
+    TEST_ASSERT(c_parser_atom_find("atom_test_identifier", 20) == first, "Lookups should find interned strings");
+    TEST_ASSERT(c_parser_atom_text(ATOM_NONE) == NULL && c_parser_intern(NULL, 0) == ATOM_NONE, "ATOM_NONE is never text");
+    
+    // Threads racing on the same names must agree on every atom
+    static Atom_t atoms[ATOM_TEST_THREADS][ATOM_TEST_NAMES];
+    pthread_t threads[ATOM_TEST_THREADS];
+    for (int t = 0; t < ATOM_TEST_THREADS; t++) {
+        TEST_ASSERT(pthread_create(&threads[t], NULL, intern_test_names, atoms[t]) == 0, "Thread should start");
+    }
+    for (int t = 0; t < ATOM_TEST_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    bool agreed = true;
+    for (int t = 1; t < ATOM_TEST_THREADS; t++) {
+        agreed = agreed && memcmp(atoms[0], atoms[t], sizeof(atoms[0])) == 0;
+    }
+    TEST_ASSERT(agreed && atoms[0][0] != atoms[0][1], "Concurrent interning should give one atom per name");
+    
+    // Functions from different files share atoms, and their name strings with them
+    ParsedFile_t* header = c_parser_parse_content("int shared_name(int a);\nchar* other_name(void);\n", "atoms.h");
+    ParsedFile_t* impl = c_parser_parse_content("int shared_name(int a) { return a; }\n", "atoms.c");
+    TEST_ASSERT(header != NULL && impl != NULL && header->function_count == 2 && impl->function_count == 1, "Sources should parse");
+    TEST_ASSERT(header->functions[0].name_atom == impl->functions[0].name_atom &&
+                header->functions[0].name == impl->functions[0].name, "Equal names should share one interned string");
+    TEST_ASSERT(header->functions[0].return_type_atom == impl->functions[0].return_type_atom &&
+                header->functions[1].return_type_atom != header->functions[0].return_type_atom,
+                "Return types should intern by text");
+    TEST_ASSERT(c_parser_find_function_atom(header, impl->functions[0].name_atom) == &header->functions[0],
+                "Functions should be found by another file's atom");
+    TEST_ASSERT(c_parser_find_function_atom(impl, header->functions[1].name_atom) == NULL &&
+                c_parser_find_function_atom(impl, ATOM_NONE) == NULL, "Missing atoms should not match");
+    TEST_ASSERT(c_parser_find_function(impl, "never_declared_anywhere") == NULL, "Unknown names should not match");
+    c_parser_free_parsed_file(header);
+    c_parser_free_parsed_file(impl);
+    return 1;
+}
+
+/*
+ * Test that each parse cache run interns into its own table, freed with its last parse
+ */
+static int test_atom_table_runs(void) {
+    LOG("Testing atom tables scoped to parse cache runs");
+
+    c_parser_cache_begin();
+    Atom_t first = c_parser_intern("atom_first_run_only", 19);
+    ParsedFile_t* header = c_parser_parse_content("int kept_name(int a);\n", "kept.h");
+    c_parser_cache_end();
+    TEST_ASSERT(first != ATOM_NONE && header != NULL && header->function_count == 1, "The first run should intern and parse");
+
+    // The parse keeps its table, so it still answers lookups by name after the run
+    TEST_ASSERT(c_parser_find_function(header, "kept_name") == &header->functions[0],
+                "A parse should outlive the run it was made in");
+
+    c_parser_cache_begin();
+    TEST_ASSERT(c_parser_atom_find("atom_first_run_only", 19) == ATOM_NONE,
+                "A new run should not see the last run's atoms");
+    ParsedFile_t* impl = c_parser_parse_content("int kept_name(int a) { return a; }\n", "kept.c");
+    TEST_ASSERT(impl != NULL && impl->function_count == 1, "The second run should parse");
+    TEST_ASSERT(!c_parser_atoms_comparable(header->functions[0].name_atom, impl->functions[0].name_atom) &&
+                c_parser_atoms_comparable(impl->functions[0].name_atom, impl->functions[0].return_type_atom),
+                "Only atoms from the same run should compare");
+    TEST_ASSERT(c_parser_find_function_atom(header, impl->functions[0].name_atom) == &header->functions[0],
+                "Functions should still be found by another run's atom");
+    c_parser_free_parsed_file(header);
+    c_parser_free_parsed_file(impl);
+    c_parser_cache_end();
+
+    // With no parse left holding them, both runs' strings are gone
+    c_parser_cache_begin();
+    TEST_ASSERT(c_parser_atom_find("kept_name", 9) == ATOM_NONE && c_parser_atom_text(first) == NULL,
+                "Finished runs' atoms should be freed");
+    c_parser_cache_end();
+    return 1;
+}
+
 // =============================================================================
 // STRESS AND PERFORMANCE TESTS
 // =============================================================================
@@ -453,6 +1276,98 @@ static int test_parser_large_input_handling(void) {
     return 1;
 }
 
+/*
+ * Test a large body of calls and nested blocks parses correctly and in linear time
+ */
+static int test_parser_many_call_sites(void) {
+    LOG("Testing parser with thousands of call sites");
+    
+    const char* header = "/* Generated protocol dispatch */\nint dispatch(int op) {\n";
+    const char* call = "    if (op) { handle(op, encode(op)); }\n";
+    const char* footer = "    return 0;\n}\n\n/* Trailing helper */\nstatic int helper(void) {\n    return 1;\n}\n";
+    const int call_count = 5000;
+    
+    size_t total_len = strlen(header) + strlen(call) * call_count + strlen(footer);
+    char* content = malloc(total_len + 1);
+    TEST_ASSERT(content != NULL, "Should allocate generated content");
+    
+    char* cursor = content;
+    cursor += sprintf(cursor, "%s", header);
+    for (int i = 0; i < call_count; i++) {
+        cursor += sprintf(cursor, "%s", call);
+    }
+    sprintf(cursor, "%s", footer);
+    
+    clock_t start = clock();
+    ParsedFile_t* parsed = c_parser_parse_content(content, "dispatch.c");
+    double elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("Parsed %d tokens in %.3fs\n", parsed ? parsed->token_count : 0, elapsed);
+    
+    TEST_ASSERT(parsed != NULL, "Parser should handle generated call-heavy content");
+    TEST_ASSERT(parsed->function_count == 2, "Calls inside bodies must not be detected as functions");
+    TEST_ASSERT(strcmp(parsed->functions[0].name, "dispatch") == 0, "First function should be dispatch");
+    TEST_ASSERT(strcmp(parsed->functions[1].name, "helper") == 0, "Function after nested blocks should be found");
+    TEST_ASSERT(elapsed < 2.0, "Parsing should scale linearly with call sites");
+    
+    free(content);
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
+/*
+ * Test that comments and literals far longer than 1 KB stay single tokens
+ */
+static int test_parser_long_comment_and_literal(void) {
+    LOG("Testing 64 KB comments and string literals stay whole");
+    
+    // A license-style block whose body looks like code, then a huge literal and a real function
+    const char* comment_line = " * int fake_function(void) { return strcpy(a, b); }\n";
+    const char* literal_chunk = "abcdefghijklmnopqrstuvwxyz0123456789";
+    const int comment_lines = 1300;   // ~66 KB
+    const int literal_chunks = 1850;  // ~66 KB
+    
+    size_t total_len = 16 + strlen(comment_line) * comment_lines + 32 +
+                       strlen(literal_chunk) * literal_chunks + 64;
+    char* content = malloc(total_len);
+    TEST_ASSERT(content != NULL, "Should allocate generated content");
+    
+    char* cursor = content;
+    cursor += sprintf(cursor, "/*\n");
+    for (int i = 0; i < comment_lines; i++) {
+        cursor += sprintf(cursor, "%s", comment_line);
+    }
+    cursor += sprintf(cursor, " */\nconst char* table = \"");
+    for (int i = 0; i < literal_chunks; i++) {
+        cursor += sprintf(cursor, "%s", literal_chunk);
+    }
+    cursor += sprintf(cursor, "\";\nint real(void) {\n    return 0;\n}\n");
+    
+    ParsedFile_t* parsed = c_parser_parse_content(content, "long_tokens.c");
+    TEST_ASSERT(parsed != NULL, "Parsing long tokens should succeed");
+    
+    Token_t comment = c_parser_token_at(parsed, 0);
+    TEST_ASSERT(comment.type == TOKEN_COMMENT_BLOCK, "File should open with a block comment");
+    TEST_ASSERT(c_parser_token_text(parsed->source, &comment)[comment.length - 1] == '/', "Comment should end at its closing marker");
+    TEST_ASSERT(comment.length > 64 * 1024, "Comment should be one token over 64 KB");
+    
+    int string_tokens = 0;
+    for (int i = 0; i < parsed->token_count; i++) {
+        Token_t token = c_parser_token_at(parsed, i);
+        if (token.type == TOKEN_STRING) {
+            string_tokens++;
+            TEST_ASSERT(token.length == (int)(strlen(literal_chunk) * literal_chunks) + 2, "Literal should be one whole token");
+        }
+    }
+    TEST_ASSERT(string_tokens == 1, "There should be exactly one string token");
+    
+    TEST_ASSERT(parsed->function_count == 1, "Code-like comment text should not produce functions");
+    TEST_ASSERT(parsed->function_count == 1 && strcmp(parsed->functions[0].name, "real") == 0, "Only the real function should be found");
+    
+    free(content);
+    c_parser_free_parsed_file(parsed);
+    return 1;
+}
+
 // =============================================================================
 // REGRESSION TESTS FOR SPECIFIC BUGS
 // =============================================================================
@@ -730,10 +1645,29 @@ int main(void) {
     // Complex parsing scenario tests
     RUN_TEST(test_complex_function_parsing);
     RUN_TEST(test_comprehensive_token_parsing);
+    RUN_TEST(test_token_views_into_source);
+    RUN_TEST(test_perfect_hash_word_ids);
+    RUN_TEST(test_token_sub_kinds);
+    RUN_TEST(test_token_store_adapters);
+    RUN_TEST(test_line_index_lookups);
+    RUN_TEST(test_source_input_open);
+    RUN_TEST(test_parse_cache);
+    RUN_TEST(test_resident_cache_truncation);
+    RUN_TEST(test_unsafe_strcmp_matcher);
+    RUN_TEST(test_call_site_table);
+    RUN_TEST(test_function_body_ranges);
+    RUN_TEST(test_doc_comment_links);
+    RUN_TEST(test_function_name_index);
+    RUN_TEST(test_arena_allocation);
+    RUN_TEST(test_parse_pool);
+    RUN_TEST(test_atom_table);
+    RUN_TEST(test_atom_table_runs);
     
     // Stress and performance tests
     RUN_TEST(test_parser_stress_many_functions);
     RUN_TEST(test_parser_large_input_handling);
+    RUN_TEST(test_parser_many_call_sites);
+    RUN_TEST(test_parser_long_comment_and_literal);
     
     // Regression tests for specific bugs
     RUN_TEST(test_regression_false_positive_docs_bug);
@@ -544,6 +544,41 @@ static int test_function_signature_comparison(void) {
     return 1;
 }
 
+/*
+ * Test that interned signatures still normalize differently spelled return types
+ */
+static int test_interned_signature_comparison(void) {
+    LOG("Testing interned signature comparison");
+
+    FunctionInfo_t header_func = {0};
+    FunctionInfo_t impl_func = {0};
+
+    header_func.name = "interned_function";
+    header_func.return_type = "const char *";
+    header_func.param_count = 1;
+    header_func.name_atom = c_parser_intern(header_func.name, strlen(header_func.name));
+    header_func.return_type_atom = c_parser_intern(header_func.return_type, strlen(header_func.return_type));
+
+    impl_func = header_func;
+    impl_func.return_type = "const char\t* ";
+    impl_func.return_type_atom = c_parser_intern(impl_func.return_type, strlen(impl_func.return_type));
+
+    bool spacing_match = cross_reference_compare_signatures(&header_func, &impl_func);
+    TEST_ASSERT(spacing_match, "Return types differing only in tabs and trailing space should match");
+
+    impl_func.return_type = "char *";
+    impl_func.return_type_atom = c_parser_intern(impl_func.return_type, strlen(impl_func.return_type));
+    bool type_match = cross_reference_compare_signatures(&header_func, &impl_func);
+    TEST_ASSERT(!type_match, "Different return types should not match");
+
+    impl_func = header_func;
+    impl_func.param_count = 2;
+    bool count_match = cross_reference_compare_signatures(&header_func, &impl_func);
+    TEST_ASSERT(!count_match, "Different parameter counts should not match");
+
+    return 1;
+}
+
 /*
  * Test function documentation comparison
  */
@@ -888,18 +923,18 @@ static int test_debug_raw_signature_extraction(void) {
     
     // Find all tokens around multiply_numbers in header
     for (int i = 0; i < header_parsed->token_count; i++) {
-        Token_t* token = &header_parsed->tokens[i];
-        if (token->type == TOKEN_IDENTIFIER && strcmp(token->value, "multiply_numbers") == 0) {
+        Token_t* token = &c_parser_tokens(header_parsed)[i];
+        if (token->type == TOKEN_IDENTIFIER && c_parser_token_equals(header_parsed->source, token, "multiply_numbers")) {
             printf("Found multiply_numbers token at index %d, line %d\n", i, token->line);
             
             // Print surrounding tokens
             printf("Surrounding tokens:\n");
             for (int j = i - 5; j <= i + 10 && j < header_parsed->token_count; j++) {
                 if (j >= 0) {
-                    Token_t* surrounding = &header_parsed->tokens[j];
-                    printf("  [%d] %s: '%s' (line %d)\n", j, 
+                    Token_t* surrounding = &c_parser_tokens(header_parsed)[j];
+                    printf("  [%d] %s: '%.*s' (line %d)\n", j, 
                            c_parser_token_type_name(surrounding->type), 
-                           surrounding->value, surrounding->line);
+                           surrounding->length, c_parser_token_text(header_parsed->source, surrounding), surrounding->line);
                 }
             }
             break;
@@ -910,18 +945,18 @@ static int test_debug_raw_signature_extraction(void) {
     
     // Find all tokens around multiply_numbers in implementation
     for (int i = 0; i < impl_parsed->token_count; i++) {
-        Token_t* token = &impl_parsed->tokens[i];
-        if (token->type == TOKEN_IDENTIFIER && strcmp(token->value, "multiply_numbers") == 0) {
+        Token_t* token = &c_parser_tokens(impl_parsed)[i];
+        if (token->type == TOKEN_IDENTIFIER && c_parser_token_equals(impl_parsed->source, token, "multiply_numbers")) {
             printf("Found multiply_numbers token at index %d, line %d\n", i, token->line);
             
             // Print surrounding tokens
             printf("Surrounding tokens:\n");
             for (int j = i - 5; j <= i + 10 && j < impl_parsed->token_count; j++) {
                 if (j >= 0) {
-                    Token_t* surrounding = &impl_parsed->tokens[j];
-                    printf("  [%d] %s: '%s' (line %d)\n", j, 
+                    Token_t* surrounding = &c_parser_tokens(impl_parsed)[j];
+                    printf("  [%d] %s: '%.*s' (line %d)\n", j, 
                            c_parser_token_type_name(surrounding->type), 
-                           surrounding->value, surrounding->line);
+                           surrounding->length, c_parser_token_text(impl_parsed->source, surrounding), surrounding->line);
                 }
             }
             break;
@@ -1159,6 +1194,7 @@ int main(void) {
     
     // Function comparison tests
     RUN_TEST(test_function_signature_comparison);
+    RUN_TEST(test_interned_signature_comparison);
     RUN_TEST(test_function_documentation_comparison);
     RUN_TEST(test_function_filtering);
     
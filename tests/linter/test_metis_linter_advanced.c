@@ -887,10 +887,10 @@ static int test_documentation_detection_debugging(void) {
     
     // Show tokens around functions to understand the parsing
     for (int i = 0; i < parsed->token_count && i < 50; i++) {
-        Token_t* token = &parsed->tokens[i];
-        printf("Token %d: type=%s, value='%s', line=%d, col=%d\\n", 
+        Token_t* token = &c_parser_tokens(parsed)[i];
+        printf("Token %d: type=%s, value='%.*s', line=%d, col=%d\\n", 
                i, c_parser_token_type_name(token->type),
-               token->value ? token->value : "NULL",
+               token->length, c_parser_token_text(parsed->source, token),
                token->line, token->column);
     }
     
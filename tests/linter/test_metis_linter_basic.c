@@ -4,12 +4,18 @@
 #include "tests.h"
 #include "metis_linter.h"
 #include "c_parser.h"
+#include "metis_ignore.h"
+#include "metis.h"
+#include "../test_helpers.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <dirent.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
 
 #define LOG(msg) printf("%s | File: %s, Line: %d\n", msg, __FILE__, __LINE__)
 
@@ -512,6 +518,463 @@ static int test_lint_directory_with_files(void) {
     return 1;
 }
 
+/*
+ * Test parallel directory linting matches serial linting
+ */
+static int test_lint_directory_parallel_jobs(void) {
+    LOG("Testing directory linting with worker threads");
+    
+    char* temp_dir = create_temp_test_directory("parallel_test_dir");
+    TEST_ASSERT(temp_dir != NULL, "Should create temporary test directory");
+    
+    char sub_dir[512];
+    snprintf(sub_dir, sizeof(sub_dir), "%s/nested", temp_dir);
+    mkdir(sub_dir, 0755);
+    
+    // Files in both directories, so per-directory totals have to roll up through the plan
+    const char* names[] = { "a_dangerous.c", "b_perfect.c", "c_dangerous.c", "nested/d_dangerous.c", "nested/e_perfect.c" };
+    int name_count = (int)(sizeof(names) / sizeof(names[0]));
+    char file_path[600];
+    for (int i = 0; i < name_count; i++) {
+        snprintf(file_path, sizeof(file_path), "%s/%s", temp_dir, names[i]);
+        FILE* file = fopen(file_path, "w");
+        TEST_ASSERT(file != NULL, "Should create test file");
+        fputs(strstr(names[i], "dangerous") ? create_dangerous_functions_content() : create_perfect_c_content(), file);
+        fclose(file);
+    }
+    
+    int serial = metis_lint_directory_jobs(temp_dir, 1);
+    int parallel = metis_lint_directory_jobs(temp_dir, 4);
+    int per_core = metis_lint_directory(temp_dir);
+    
+    TEST_ASSERT(serial > 0, "Directory with problematic files should have violations");
+    TEST_ASSERT(parallel == serial, "Four workers should find the same violations as one");
+    TEST_ASSERT(per_core == serial, "Default job count should find the same violations as one worker");
+    
+    for (int i = 0; i < name_count; i++) {
+        snprintf(file_path, sizeof(file_path), "%s/%s", temp_dir, names[i]);
+        unlink(file_path);
+    }
+    rmdir(sub_dir);
+    cleanup_temp_directory(temp_dir);
+    return 1;
+}
+
+#define WALK_TEST_LONG_LEVELS 12   // Enough 100-byte components to pass 1024 bytes of path
+#define WALK_TEST_DEEP_LEVELS 45   // Enough 100-byte components to pass PATH_MAX (4096 bytes)
+
+/*
+ * Test the directory walk's depth limit, symlink loop detection and long paths
+ */
+static int test_lint_directory_walk_limits(void) {
+    LOG("Testing directory walk depth limit, symlink loops and long paths");
+    
+    char* temp_dir = create_temp_test_directory("walk_test_dir");
+    TEST_ASSERT(temp_dir != NULL, "Should create temporary test directory");
+    
+    char nested[600];
+    snprintf(nested, sizeof(nested), "%s/nested", temp_dir);
+    mkdir(nested, 0755);
+    
+    char file_path[2100];      // Room for the deep directory below plus a file name
+    const char* names[] = { "a_dangerous.c", "nested/b_dangerous.c" };
+    for (int i = 0; i < 2; i++) {
+        snprintf(file_path, sizeof(file_path), "%s/%s", temp_dir, names[i]);
+        FILE* file = fopen(file_path, "w");
+        TEST_ASSERT(file != NULL, "Should create test file");
+        fputs(create_dangerous_functions_content(), file);
+        fclose(file);
+    }
+    
+    metis_linter_set_max_depth(0);
+    int root_only = metis_lint_directory_jobs(temp_dir, 1);
+    metis_linter_set_max_depth(-1);
+    int full = metis_lint_directory_jobs(temp_dir, 1);
+    TEST_ASSERT(root_only > 0 && full > root_only, "A depth limit of 0 should skip subdirectories");
+    
+    // nested/loop points back at the root; following it must not repeat the tree
+    char loop_path[700];
+    snprintf(loop_path, sizeof(loop_path), "%s/loop", nested);
+    TEST_ASSERT(symlink("..", loop_path) == 0, "Should create symlink loop");
+    TEST_ASSERT(metis_lint_directory_jobs(temp_dir, 1) == full, "A symlink loop should be skipped, not walked");
+    unlink(loop_path);
+    
+    // A file more than 1024 bytes of path deep is still found
+    char deep[2048];
+    snprintf(deep, sizeof(deep), "%s", nested);
+    for (int level = 0; level < WALK_TEST_LONG_LEVELS; level++) {
+        size_t used = strlen(deep);
+        snprintf(deep + used, sizeof(deep) - used, "/level_%02d_%090d", level, 0);
+        mkdir(deep, 0755);
+    }
+    TEST_ASSERT(strlen(deep) > 1024, "Deep path should exceed the old 1024-byte buffer");
+    snprintf(file_path, sizeof(file_path), "%s/c_dangerous.c", deep);
+    FILE* deep_file = fopen(file_path, "w");
+    TEST_ASSERT(deep_file != NULL, "Should create deep test file");
+    fputs(create_dangerous_functions_content(), deep_file);
+    fclose(deep_file);
+    int with_long = metis_lint_directory_jobs(temp_dir, 1);
+    TEST_ASSERT(with_long > full, "Files below long paths should be analyzed");
+    
+    // Past PATH_MAX a file can only be reached relative to its directory, so build the tree that way
+    char component[100];
+    int dir_fd = open(nested, O_RDONLY | O_DIRECTORY);
+    for (int level = 0; dir_fd >= 0 && level < WALK_TEST_DEEP_LEVELS; level++) {
+        snprintf(component, sizeof(component), "deep_%02d_%090d", level, 0);
+        mkdirat(dir_fd, component, 0755);
+        int child_fd = openat(dir_fd, component, O_RDONLY | O_DIRECTORY);
+        close(dir_fd);
+        dir_fd = child_fd;
+    }
+    TEST_ASSERT(dir_fd >= 0, "Should create directories past PATH_MAX");
+    const char* content = create_dangerous_functions_content();
+    int file_fd = openat(dir_fd, "d_dangerous.c", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool written = file_fd >= 0 && write(file_fd, content, strlen(content)) == (ssize_t)strlen(content);
+    if (file_fd >= 0) close(file_fd);
+    TEST_ASSERT(written, "Should create test file past PATH_MAX");
+    
+    int deepest_serial = metis_lint_directory_jobs(temp_dir, 1);
+    int deepest_parallel = metis_lint_directory_jobs(temp_dir, 4);
+    TEST_ASSERT(deepest_serial > with_long, "Files below paths longer than PATH_MAX should be analyzed");
+    TEST_ASSERT(deepest_parallel == deepest_serial, "Workers should read deep files the same way");
+    
+    unlinkat(dir_fd, "d_dangerous.c", 0);
+    for (int level = WALK_TEST_DEEP_LEVELS - 1; level >= 0; level--) {
+        int parent_fd = openat(dir_fd, "..", O_RDONLY | O_DIRECTORY);
+        close(dir_fd);
+        dir_fd = parent_fd;
+        snprintf(component, sizeof(component), "deep_%02d_%090d", level, 0);
+        unlinkat(dir_fd, component, AT_REMOVEDIR);
+    }
+    close(dir_fd);
+    
+    unlink(file_path);
+    for (int level = 0; level < WALK_TEST_LONG_LEVELS; level++) {
+        rmdir(deep);
+        *strrchr(deep, '/') = '\0';
+    }
+    for (int i = 0; i < 2; i++) {
+        snprintf(file_path, sizeof(file_path), "%s/%s", temp_dir, names[i]);
+        unlink(file_path);
+    }
+    rmdir(nested);
+    cleanup_temp_directory(temp_dir);
+    return 1;
+}
+
+/*
+ * Test .metisignore pattern compilation and gitignore-style matching
+ */
+static int test_metis_ignore_patterns(void) {
+    LOG("Testing .metisignore pattern matching");
+    
+    const char* text = "# comment\n"
+                       "\n"
+                       "build/\n"
+                       "*.gen.c\n"
+                       "/top_only.c\n"
+                       "third_party/**/vendor_*.c\n"
+                       "logs/**\n"
+                       "test_[0-9].c\n"
+                       "*.c\n"
+                       "!keep.c\n"
+                       "\\#literal.c   \r\n";
+    MetisIgnore_t* ignore = metis_ignore_compile(text, strlen(text));
+    TEST_ASSERT(ignore != NULL, "Should compile a pattern list");
+    TEST_ASSERT(ignore->count == 9, "Comments and blank lines should not become patterns");
+    
+    TEST_ASSERT(metis_ignore_match(ignore, "build", true) == METIS_IGNORE_EXCLUDED, "Directory pattern should match a directory");
+    TEST_ASSERT(metis_ignore_match(ignore, "src/build", true) == METIS_IGNORE_EXCLUDED, "Unanchored pattern should match at any depth");
+    TEST_ASSERT(metis_ignore_match(ignore, "build", false) == METIS_IGNORE_NO_MATCH, "Directory pattern should not match a file");
+    TEST_ASSERT(metis_ignore_match(ignore, "top_only.c", false) == METIS_IGNORE_EXCLUDED, "Anchored pattern should match at the top");
+    TEST_ASSERT(metis_ignore_match(ignore, "third_party/vendor_zlib.c", false) == METIS_IGNORE_EXCLUDED, "** should match zero directories");
+    TEST_ASSERT(metis_ignore_match(ignore, "third_party/a/b/vendor_zlib.c", false) == METIS_IGNORE_EXCLUDED, "** should match several directories");
+    TEST_ASSERT(metis_ignore_match(ignore, "logs/x/y", true) == METIS_IGNORE_EXCLUDED, "Trailing ** should match everything below");
+    TEST_ASSERT(metis_ignore_match(ignore, "logs", true) == METIS_IGNORE_NO_MATCH, "Trailing ** should not match the directory itself");
+    TEST_ASSERT(metis_ignore_match(ignore, "src/test_7.c", false) == METIS_IGNORE_EXCLUDED, "Bracket range should match");
+    TEST_ASSERT(metis_ignore_match(ignore, "keep.c", false) == METIS_IGNORE_INCLUDED, "Later negation should re-include");
+    TEST_ASSERT(metis_ignore_match(ignore, "#literal.c", false) == METIS_IGNORE_EXCLUDED, "Escaped # should be literal and trailing space trimmed");
+    TEST_ASSERT(metis_ignore_match(ignore, "notes.txt", false) == METIS_IGNORE_NO_MATCH, "Unrelated path should not match");
+    metis_ignore_free(ignore);
+    
+    const char* star = "src/*.c\n";
+    ignore = metis_ignore_compile(star, strlen(star));
+    TEST_ASSERT(ignore != NULL, "Should compile a single pattern");
+    TEST_ASSERT(metis_ignore_match(ignore, "src/a.c", false) == METIS_IGNORE_EXCLUDED, "* should match within one directory");
+    TEST_ASSERT(metis_ignore_match(ignore, "src/sub/a.c", false) == METIS_IGNORE_NO_MATCH, "* should not cross a slash");
+    metis_ignore_free(ignore);
+    
+    TEST_ASSERT(metis_ignore_compile("# only a comment\n", 17) == NULL, "A file without patterns should compile to NULL");
+    TEST_ASSERT(metis_ignore_match(NULL, "a.c", false) == METIS_IGNORE_NO_MATCH, "NULL list should never match");
+    return 1;
+}
+
+/*
+ * Write `content` to dir/name, returning false if the file could not be created
+ */
+static bool write_dir_test_file(const char* dir, const char* name, const char* content) {
+    char path[700];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    return write_test_file(path, content);
+}
+
+/*
+ * Test nested .metisignore files prune directories and skip files during a directory lint
+ */
+static int test_lint_directory_metisignore(void) {
+    LOG("Testing .metisignore pruning during directory walks");
+    
+    char* temp_dir = create_temp_test_directory("metisignore_test_dir");
+    TEST_ASSERT(temp_dir != NULL, "Should create temporary test directory");
+    
+    char build_dir[600], src_dir[600];
+    snprintf(build_dir, sizeof(build_dir), "%s/build", temp_dir);
+    snprintf(src_dir, sizeof(src_dir), "%s/src", temp_dir);
+    mkdir(build_dir, 0755);
+    mkdir(src_dir, 0755);
+    
+    // Leftovers from an interrupted run would skew the unignored baseline
+    char path[700];
+    snprintf(path, sizeof(path), "%s/%s", temp_dir, METIS_IGNORE_FILE);
+    unlink(path);
+    snprintf(path, sizeof(path), "%s/%s", src_dir, METIS_IGNORE_FILE);
+    unlink(path);
+    
+    const char* dangerous = create_dangerous_functions_content();
+    TEST_ASSERT(write_dir_test_file(temp_dir, "main.c", dangerous), "Should create root file");
+    TEST_ASSERT(write_dir_test_file(build_dir, "out.c", dangerous), "Should create build file");
+    TEST_ASSERT(write_dir_test_file(src_dir, "gen.c", dangerous), "Should create generated file");
+    TEST_ASSERT(write_dir_test_file(src_dir, "keep.c", dangerous), "Should create kept file");
+    int baseline = metis_lint_directory_jobs(temp_dir, 1);
+    TEST_ASSERT(baseline > 0, "Unignored tree should have violations");
+    
+    // The root file prunes build/; the nested one re-includes keep.c after excluding every .c
+    TEST_ASSERT(write_dir_test_file(temp_dir, METIS_IGNORE_FILE, "build/\n"), "Should create root .metisignore");
+    TEST_ASSERT(write_dir_test_file(src_dir, METIS_IGNORE_FILE, "*.c\n!keep.c\n"), "Should create nested .metisignore");
+    
+    int ignored = metis_lint_directory_jobs(temp_dir, 1);
+    TEST_ASSERT(ignored * 2 == baseline, "Only main.c and src/keep.c should be analyzed");
+    
+    const char* created[] = { "main.c", METIS_IGNORE_FILE, "build/out.c", "src/gen.c", "src/keep.c", "src/" METIS_IGNORE_FILE };
+    for (int i = 0; i < 6; i++) {
+        snprintf(path, sizeof(path), "%s/%s", temp_dir, created[i]);
+        unlink(path);
+    }
+    rmdir(build_dir);
+    rmdir(src_dir);
+    cleanup_temp_directory(temp_dir);
+    return 1;
+}
+
+#define LIBRARY_TEST_THREADS 4
+
+/*
+ * Lint the dangerous-functions buffer through the library API, returning its diagnostic count
+ */
+static void* lint_buffer_thread(void* arg) {
+    const char* content = create_dangerous_functions_content();
+    MetisSource source = { .path = "/tmp/metis_library_buffer.c", .content = content, .length = strlen(content) };
+    MetisLintReport report;
+    size_t* count = arg;
+    *count = metis_lint_sources(&source, 1, NULL, &report) == METIS_SUCCESS ? report.count : 0;
+    metis_lint_report_free(&report);
+    return NULL;
+}
+
+/*
+ * Test metis_lint() returns diagnostics for files and buffers without printing
+ */
+static int test_library_lint(void) {
+    LOG("Testing the library lint API");
+    
+    char* temp_file = create_temp_test_file("library_dangerous.c", create_dangerous_functions_content());
+    TEST_ASSERT(temp_file != NULL, "Should create temporary test file");
+    TEST_ASSERT(metis_init(NULL) == METIS_SUCCESS, "Init without a config should succeed");
+    
+    // Everything the call writes to stdout lands in this file, which must stay empty
+    char capture_path[] = "/tmp/metis_library_stdout_XXXXXX";
+    int capture = mkstemp(capture_path);
+    TEST_ASSERT(capture >= 0, "Should create stdout capture file");
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    dup2(capture, STDOUT_FILENO);
+    
+    const char* files[] = { temp_file, "/tmp/metis_library_missing.c" };
+    MetisLintReport report;
+    MetisResult result = metis_lint(files, 2, NULL, &report);
+    
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+    struct stat st;
+    fstat(capture, &st);
+    close(capture);
+    unlink(capture_path);
+    TEST_ASSERT(st.st_size == 0, "Library linting should print nothing");
+    
+    TEST_ASSERT(result == METIS_ERROR_FILE_NOT_FOUND, "A missing file should be reported");
+    TEST_ASSERT(metis_get_last_error() != NULL, "The missing file should leave an error message");
+    TEST_ASSERT(report.files_analyzed == 1 && report.files_unreadable == 1, "Readable files should still be analyzed");
+    TEST_ASSERT(report.count > 0, "Dangerous functions should produce diagnostics");
+    
+    bool found_daedalus = false;
+    for (size_t i = 0; i < report.count; i++) {
+        const MetisDiagnostic* diagnostic = &report.diagnostics[i];
+        TEST_ASSERT(strcmp(diagnostic->location.file, temp_file) == 0, "Diagnostics should name the linted file");
+        TEST_ASSERT(diagnostic->location.line >= 1 && diagnostic->message, "Diagnostics should carry a line and message");
+        if (strcmp(diagnostic->rule_id, "daedalus") == 0) found_daedalus = true;
+    }
+    TEST_ASSERT(found_daedalus, "strcpy should be reported as a daedalus diagnostic");
+    size_t file_count = report.count;
+    metis_lint_report_free(&report);
+    
+    // Ignoring a rule drops its diagnostics
+    const char* ignored[] = { "daedalus" };
+    MetisLintOptions options = { .ignore_rules = ignored, .ignore_count = 1 };
+    TEST_ASSERT(metis_lint(files, 1, &options, &report) == METIS_SUCCESS, "Linting a readable file should succeed");
+    TEST_ASSERT(metis_get_last_error() == NULL, "Success should clear the error message");
+    TEST_ASSERT(report.count < file_count, "Ignored rules should not be reported");
+    metis_lint_report_free(&report);
+    
+    // An unsaved buffer gives the same answer as the file, on any number of threads at once
+    pthread_t threads[LIBRARY_TEST_THREADS];
+    size_t counts[LIBRARY_TEST_THREADS];
+    for (int i = 0; i < LIBRARY_TEST_THREADS; i++) {
+        pthread_create(&threads[i], NULL, lint_buffer_thread, &counts[i]);
+    }
+    for (int i = 0; i < LIBRARY_TEST_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        TEST_ASSERT(counts[i] == file_count, "Concurrent buffer lints should match the file lint");
+    }
+    
+    TEST_ASSERT(metis_lint(NULL, 1, NULL, &report) == METIS_ERROR_INVALID_ARGUMENT, "NULL files should be rejected");
+    unlink(temp_file);
+    free(temp_file);
+    return 1;
+}
+
+/*
+ * Add one made-up violation to the only entry in a result cache directory
+ *
+ * A run that replays the entry then reports one more violation than the
+ * analysis it was stored from, which a fresh analysis never would.
+ */
+static bool plant_cached_violation(const char* cache_dir, const char* file_path) {
+    DIR* dir = opendir(cache_dir);
+    if (!dir) return false;
+    char entry_path[700] = "";
+    int entries = 0;
+    for (struct dirent* entry = readdir(dir); entry; entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') continue;
+        snprintf(entry_path, sizeof(entry_path), "%s/%s", cache_dir, entry->d_name);
+        entries++;
+    }
+    closedir(dir);
+    if (entries != 1) return false;
+
+    FILE* in = fopen(entry_path, "rb");
+    if (!in) return false;
+    char* content = calloc(1, 65536);
+    size_t length = content ? fread(content, 1, 65535, in) : 0;
+    fclose(in);
+
+    // Header, path length and path take three lines; the counts follow
+    char* counts = content;
+    for (int line = 0; counts && line < 3; line++) {
+        counts = strchr(counts, '\n');
+        if (counts) counts++;
+    }
+    int violation_count = 0, usage_count = 0;
+    char* rest = counts ? strchr(counts, '\n') : NULL;
+    bool planted = length > 0 && rest && sscanf(counts, "%d %d", &violation_count, &usage_count) == 2;
+    if (planted) {
+        char* edited = malloc(length + 1024);
+        int prefix = (int)(counts - content);
+        planted = edited != NULL;
+        if (planted) {
+            // Line 1, column 1, type 0 and severity 0 (a docs finding at info level), no suggestion
+            snprintf(edited, length + 1024, "%.*s%d %d\n1 1 0 0\n%zu\n%s\n21\nPlanted cache finding\n-%s",
+                     prefix, content, violation_count + 1, usage_count, strlen(file_path), file_path, rest);
+            planted = write_test_file(entry_path, edited);
+        }
+        free(edited);
+    }
+    free(content);
+    return planted;
+}
+
+/*
+ * Test cached results replay until the file or its header changes
+ */
+static int test_lint_result_cache(void) {
+    LOG("Testing the on-disk result cache and its invalidation");
+    
+    char* temp_dir = create_temp_test_directory("result_cache_test_dir");
+    TEST_ASSERT(temp_dir != NULL, "Should create temporary test directory");
+    
+    char cache_dir[600], c_path[600], h_path[600];
+    snprintf(cache_dir, sizeof(cache_dir), "%s/.metis-cache", temp_dir);
+    snprintf(c_path, sizeof(c_path), "%s/cached.c", temp_dir);
+    snprintf(h_path, sizeof(h_path), "%s/cached.h", temp_dir);
+    
+    const char* header = "/* cached.h - Header for the cache test */\n"
+                         "// INSERT WISDOM HERE\n"
+                         "\n"
+                         "/* Add two numbers */\n"
+                         "int add(int a, int b);\n";
+    const char* source = "/* cached.c - Implementation for the cache test */\n"
+                         "// INSERT WISDOM HERE\n"
+                         "\n"
+                         "#include \"cached.h\"\n"
+                         "\n"
+                         "/* Add two numbers */\n"
+                         "int add(int a, int b) {\n"
+                         "    return a + b;\n"
+                         "}\n";
+    FILE* file = fopen(h_path, "w");
+    TEST_ASSERT(file != NULL, "Should create header");
+    fputs(header, file);
+    fclose(file);
+    file = fopen(c_path, "w");
+    TEST_ASSERT(file != NULL, "Should create source");
+    fputs(source, file);
+    fclose(file);
+    
+    // Entries left by an earlier, interrupted run would hide which one is this file's
+    char command[700];
+    snprintf(command, sizeof(command), "rm -rf '%s'", cache_dir);
+    TEST_ASSERT(system(command) == 0, "Should clear the cache directory");
+    metis_linter_set_cache_dir(cache_dir);
+    int cold = metis_lint_file(c_path);
+    struct stat st;
+    TEST_ASSERT(stat(cache_dir, &st) == 0 && S_ISDIR(st.st_mode), "First run should create the cache directory");
+    int warm = metis_lint_file(c_path);
+    TEST_ASSERT(cold >= 0 && warm == cold, "Replayed result should match the analysis it was stored from");
+    
+    // Only a replay can report the planted finding
+    bool planted = plant_cached_violation(cache_dir, c_path);
+    TEST_ASSERT(planted, "Should plant a finding in the cache entry");
+    int replayed = metis_lint_file(c_path);
+    TEST_ASSERT(replayed == cold + 1, "An unchanged file should be answered from its cache entry");
+    
+    // Only the header changes; the implementation's cached result must not be replayed
+    file = fopen(h_path, "a");
+    TEST_ASSERT(file != NULL, "Should reopen header");
+    fputs("\n/* Subtract two numbers */\nint subtract(int a, int b);\n", file);
+    fclose(file);
+    int changed = metis_lint_file(c_path);
+    metis_linter_set_cache_dir(NULL);
+    int uncached = metis_lint_file(c_path);
+    TEST_ASSERT(changed > cold, "Header change should invalidate the cached result");
+    TEST_ASSERT(changed == uncached, "Result after invalidation should match an uncached run");
+    
+    TEST_ASSERT(system(command) == 0, "Should remove the cache directory");
+    unlink(c_path);
+    unlink(h_path);
+    cleanup_temp_directory(temp_dir);
+    return 1;
+}
+
 /*
  * Test linting non-existent directory
  */
@@ -995,6 +1458,12 @@ int main(void) {
     // Directory linting tests
     RUN_TEST(test_lint_empty_directory);
     RUN_TEST(test_lint_directory_with_files);
+    RUN_TEST(test_lint_directory_parallel_jobs);
+    RUN_TEST(test_lint_directory_walk_limits);
+    RUN_TEST(test_metis_ignore_patterns);
+    RUN_TEST(test_lint_directory_metisignore);
+    RUN_TEST(test_library_lint);
+    RUN_TEST(test_lint_result_cache);
     RUN_TEST(test_lint_nonexistent_directory);
     RUN_TEST(test_lint_null_directory_path);
     
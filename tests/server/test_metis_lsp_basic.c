@@ -0,0 +1,392 @@
+/* test_metis_lsp_basic.c - Basic tests for the Language Server Protocol front end */
+// INSERT WISDOM HERE
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "tests.h"
+#include "../test_helpers.h"
+#include "metis_json.h"
+#include "metis_lsp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define LOG(msg) printf("%s | File: %s, Line: %d\n", msg, __FILE__, __LINE__)
+
+#define LSP_TEST_URI "file:///tmp/metis_lsp_test.c"
+
+// Global test counters required by tests.h framework
+int total_tests = 0;
+int tests_passed = 0;
+int tests_failed = 0;
+
+// Line 6 holds strcpy behind a two-byte character, so UTF-16 and byte columns differ
+static const char* DANGEROUS_SOURCE =
+    "/* metis_lsp_test.c - File with unsafe functions */\n"
+    "// INSERT WISDOM HERE\n"
+    "\n"
+    "#include <string.h>\n"
+    "\n"
+    "void unsafe_copy(char* buffer, const char* input) {\n"
+    "    /* \xc3\xa9 */ strcpy(buffer, input);\n"
+    "}\n";
+
+// Declarations without doc comments, lying past the end of WIDGET_SOURCE
+static const char* UNDOCUMENTED_HEADER =
+    "/* widget.h - Header with undocumented declarations */\n"
+    "// INSERT WISDOM HERE\n"
+    "\n"
+    "#ifndef WIDGET_H\n"
+    "#define WIDGET_H\n"
+    "\n"
+    "\n"
+    "\n"
+    "\n"
+    "int widget_add(int a, int b);\n"
+    "\n"
+    "int widget_sub(int a, int b);\n"
+    "\n"
+    "#endif\n";
+
+static const char* WIDGET_SOURCE =
+    "/* widget.c - Widget arithmetic */\n"
+    "// INSERT WISDOM HERE\n"
+    "#include \"widget.h\"\n"
+    "/* Add two numbers */\n"
+    "int widget_add(int a, int b) { return a + b; }\n"
+    "/* Subtract two numbers */\n"
+    "int widget_sub(int a, int b) { return a - b; }\n";
+
+/*
+ * One session: the server thread reads `to_server` and writes `from_server`
+ */
+typedef struct {
+    int to_server[2];
+    int from_server[2];
+    FILE* server_output;
+    FILE* client_input;
+    pthread_t thread;
+    int result;
+} LspSession_t;
+
+// =============================================================================
+// TEST HELPER FUNCTIONS
+// =============================================================================
+
+/*
+ * Server thread body
+ */
+static void* run_lsp_thread(void* arg) {
+    LspSession_t* session = arg;
+    session->result = metis_lsp_run(session->to_server[0], session->server_output);
+    fclose(session->server_output);
+    return NULL;
+}
+
+/*
+ * Start a server on a pair of pipes
+ */
+static bool start_session(LspSession_t* session) {
+    memset(session, 0, sizeof(*session));
+    if (pipe(session->to_server) != 0 || pipe(session->from_server) != 0) return false;
+    session->server_output = fdopen(session->from_server[1], "w");
+    session->client_input = fdopen(session->from_server[0], "r");
+    if (!session->server_output || !session->client_input) return false;
+    return pthread_create(&session->thread, NULL, run_lsp_thread, session) == 0;
+}
+
+/*
+ * Hang up on the server and wait for it, returning its exit code
+ */
+static int finish_session(LspSession_t* session) {
+    close(session->to_server[1]);
+    pthread_join(session->thread, NULL);
+    close(session->to_server[0]);
+    fclose(session->client_input);
+    return session->result;
+}
+
+/*
+ * Frame and send one message to the server
+ */
+static void send_to_server(LspSession_t* session, const char* body) {
+    char header[64];
+    int header_length = snprintf(header, sizeof(header), "Content-Length: %zu\r\n\r\n", strlen(body));
+    ssize_t ignored = write(session->to_server[1], header, (size_t)header_length);
+    ignored = write(session->to_server[1], body, strlen(body));
+    (void)ignored;
+}
+
+/*
+ * Send a message with one JSON string spliced in for the single %s of `format`
+ */
+static void send_with_string(LspSession_t* session, const char* format, const char* text) {
+    char* quoted = NULL;
+    size_t quoted_length = 0;
+    FILE* out = open_memstream(&quoted, &quoted_length);
+    metis_json_write_string(out, text, strlen(text));
+    fclose(out);
+
+    size_t size = strlen(format) + quoted_length + 1;
+    char* body = malloc(size);
+    snprintf(body, size, format, quoted);
+    send_to_server(session, body);
+    free(body);
+    free(quoted);
+}
+
+/*
+ * Read the next message from the server into `document`
+ */
+static bool receive_from_server(LspSession_t* session, MetisJsonDocument_t* document) {
+    size_t length = 0;
+    char line[128];
+    while (fgets(line, sizeof(line), session->client_input)) {
+        if (strncmp(line, "Content-Length:", 15) == 0) length = (size_t)strtoul(line + 15, NULL, 10);
+        if (strcmp(line, "\r\n") != 0) continue;
+
+        char* body = malloc(length + 1);
+        bool parsed = body && fread(body, 1, length, session->client_input) == length &&
+                      metis_json_parse(body, length, document);
+        free(body);
+        return parsed;
+    }
+    memset(document, 0, sizeof(*document));
+    return false;
+}
+
+/*
+ * Read messages until diagnostics for `version` arrive; their count, or -1
+ */
+static int receive_diagnostics(LspSession_t* session, int version, MetisJsonDocument_t* document) {
+    while (receive_from_server(session, document)) {
+        const MetisJson_t* params = metis_json_get(document->root, "params");
+        const char* method = metis_json_get_string(document->root, "method");
+        if (method && strcmp(method, "textDocument/publishDiagnostics") == 0 &&
+            metis_json_get_number(params, "version", -1) == version) {
+            return metis_json_get(params, "diagnostics")->count;
+        }
+        metis_json_free(document);
+    }
+    return -1;
+}
+
+/*
+ * Find the diagnostic with `code` in a publishDiagnostics message
+ */
+static const MetisJson_t* find_diagnostic(const MetisJsonDocument_t* document, const char* code) {
+    const MetisJson_t* diagnostics = metis_json_get(metis_json_get(document->root, "params"), "diagnostics");
+    for (int i = 0; diagnostics && i < diagnostics->count; i++) {
+        const char* diagnostic_code = metis_json_get_string(&diagnostics->items[i], "code");
+        if (diagnostic_code && strcmp(diagnostic_code, code) == 0) return &diagnostics->items[i];
+    }
+    return NULL;
+}
+
+// =============================================================================
+// LSP TESTS
+// =============================================================================
+
+/*
+ * Test a full session: open, incremental edits, close, orderly shutdown
+ */
+static int test_lsp_session(void) {
+    LOG("Testing an LSP session");
+
+    // TEST_ASSERT may evaluate its condition twice, so calls with side effects stay outside it
+    LspSession_t session;
+    bool started = start_session(&session);
+    TEST_ASSERT(started, "Should start the server");
+
+    MetisJsonDocument_t message;
+    send_to_server(&session, "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"shutdown\"}");
+    bool received = receive_from_server(&session, &message);
+    const MetisJson_t* error = metis_json_get(message.root, "error");
+    TEST_ASSERT(received && metis_json_get_number(error, "code", 0) == -32002,
+                "Requests before initialize should be refused");
+    metis_json_free(&message);
+
+    send_to_server(&session, "{\"jsonrpc\":\"2.0\",\"id\":\"init\",\"method\":\"initialize\",\"params\":{\"capabilities\":{}}}");
+    received = receive_from_server(&session, &message);
+    const MetisJson_t* capabilities = metis_json_get(metis_json_get(message.root, "result"), "capabilities");
+    TEST_ASSERT(received && strcmp(metis_json_get_string(message.root, "id"), "init") == 0,
+                "initialize should be answered with its own id");
+    TEST_ASSERT(strcmp(metis_json_get_string(capabilities, "positionEncoding"), "utf-16") == 0,
+                "Positions default to UTF-16");
+    TEST_ASSERT(metis_json_get_number(metis_json_get(capabilities, "textDocumentSync"), "change", 0) == 2,
+                "Incremental sync should be offered");
+    metis_json_free(&message);
+
+    send_with_string(&session, "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":"
+                               "{\"uri\":\"" LSP_TEST_URI "\",\"languageId\":\"c\",\"version\":1,\"text\":%s}}}",
+                     DANGEROUS_SOURCE);
+    int opened = receive_diagnostics(&session, 1, &message);
+    TEST_ASSERT(opened > 0, "Opening a buffer should publish its diagnostics");
+    TEST_ASSERT(strcmp(metis_json_get_string(metis_json_get(message.root, "params"), "uri"), LSP_TEST_URI) == 0,
+                "Diagnostics should name the buffer's URI");
+
+    // strcpy sits after a two-byte character: byte column 13, UTF-16 column 12
+    const MetisJson_t* strcpy_diagnostic = find_diagnostic(&message, "daedalus");
+    const MetisJson_t* start = metis_json_get(metis_json_get(strcpy_diagnostic, "range"), "start");
+    TEST_ASSERT(strcpy_diagnostic != NULL, "strcpy should be reported");
+    TEST_ASSERT(metis_json_get_number(start, "line", -1) == 6 && metis_json_get_number(start, "character", -1) == 12,
+                "Columns should be counted in UTF-16 code units");
+    metis_json_free(&message);
+
+    // Replace strcpy(...) on line 6, addressing it in UTF-16 units
+    send_to_server(&session, "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{"
+                             "\"textDocument\":{\"uri\":\"" LSP_TEST_URI "\",\"version\":2},\"contentChanges\":["
+                             "{\"range\":{\"start\":{\"line\":6,\"character\":12},\"end\":{\"line\":6,\"character\":34}},"
+                             "\"text\":\"buffer[0] = input[0];\"}]}}");
+    int edited = receive_diagnostics(&session, 2, &message);
+    TEST_ASSERT(edited == opened - 1 && find_diagnostic(&message, "daedalus") == NULL,
+                "The ranged edit should remove exactly the strcpy diagnostic");
+    metis_json_free(&message);
+
+    // Keystrokes sent back to back: the last version is always published
+    for (int version = 3; version <= 40; version++) {
+        char change[512];
+        snprintf(change, sizeof(change),
+                 "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{"
+                 "\"textDocument\":{\"uri\":\"" LSP_TEST_URI "\",\"version\":%d},\"contentChanges\":["
+                 "{\"range\":{\"start\":{\"line\":2,\"character\":0},\"end\":{\"line\":2,\"character\":0}},"
+                 "\"text\":\"%s\"}]}}", version, version == 40 ? "\\n" : " ");
+        send_to_server(&session, change);
+    }
+    int typed = receive_diagnostics(&session, 40, &message);
+    TEST_ASSERT(typed == edited, "Whitespace edits should leave the diagnostics unchanged");
+    metis_json_free(&message);
+
+    send_to_server(&session, "{\"jsonrpc\":\"2.0\",\"id\":7,\"method\":\"textDocument/hover\",\"params\":{}}");
+    received = receive_from_server(&session, &message);
+    error = metis_json_get(message.root, "error");
+    TEST_ASSERT(received && metis_json_get_number(message.root, "id", 0) == 7 &&
+                metis_json_get_number(error, "code", 0) == -32601, "Unsupported requests should get MethodNotFound");
+    metis_json_free(&message);
+
+    send_to_server(&session, "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didClose\",\"params\":{"
+                             "\"textDocument\":{\"uri\":\"" LSP_TEST_URI "\"}}}");
+    received = receive_from_server(&session, &message);
+    const MetisJson_t* params = metis_json_get(message.root, "params");
+    TEST_ASSERT(received && metis_json_get(params, "diagnostics")->count == 0, "Closing should clear diagnostics");
+    metis_json_free(&message);
+
+    send_to_server(&session, "{\"jsonrpc\":\"2.0\",\"id\":8,\"method\":\"shutdown\"}");
+    received = receive_from_server(&session, &message);
+    TEST_ASSERT(received && metis_json_get(message.root, "result")->type == METIS_JSON_NULL,
+                "shutdown should be answered with null");
+    metis_json_free(&message);
+
+    send_to_server(&session, "{\"jsonrpc\":\"2.0\",\"method\":\"exit\"}");
+    int result = finish_session(&session);
+    TEST_ASSERT(result == 0, "exit after shutdown should return 0");
+    return 1;
+}
+
+/*
+ * Test positions in UTF-8 when the client offers it, and hanging up without shutdown
+ */
+static int test_lsp_utf8_and_hang_up(void) {
+    LOG("Testing UTF-8 positions and an abrupt hang-up");
+
+    LspSession_t session;
+    bool started = start_session(&session);
+    TEST_ASSERT(started, "Should start the server");
+
+    MetisJsonDocument_t message;
+    send_to_server(&session, "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"initialize\",\"params\":{\"capabilities\":"
+                             "{\"general\":{\"positionEncodings\":[\"utf-8\",\"utf-16\"]}}}}");
+    bool received = receive_from_server(&session, &message);
+    const MetisJson_t* capabilities = metis_json_get(metis_json_get(message.root, "result"), "capabilities");
+    TEST_ASSERT(received && strcmp(metis_json_get_string(capabilities, "positionEncoding"), "utf-8") == 0,
+                "UTF-8 positions should be chosen when offered");
+    metis_json_free(&message);
+
+    send_with_string(&session, "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":"
+                               "{\"uri\":\"" LSP_TEST_URI "\",\"languageId\":\"c\",\"version\":1,\"text\":%s}}}",
+                     DANGEROUS_SOURCE);
+    int opened = receive_diagnostics(&session, 1, &message);
+    const MetisJson_t* start = metis_json_get(metis_json_get(find_diagnostic(&message, "daedalus"), "range"), "start");
+    TEST_ASSERT(opened > 0 && metis_json_get_number(start, "character", -1) == 13,
+                "Columns should be counted in bytes under UTF-8");
+    metis_json_free(&message);
+
+    int result = finish_session(&session);
+    TEST_ASSERT(result == 1, "Hanging up without shutdown should return 1");
+    return 1;
+}
+
+/*
+ * Test that findings in a buffer's header are published for the header, not the buffer
+ */
+static int test_lsp_header_findings(void) {
+    LOG("Testing findings located in the matching header");
+
+    char directory[] = "/tmp/metis_lsp_header_XXXXXX";
+    char header_path[64];
+    char source_path[64];
+    bool created = mkdtemp(directory) != NULL;
+    TEST_ASSERT(created, "Should create a scratch directory");
+    snprintf(header_path, sizeof(header_path), "%s/widget.h", directory);
+    snprintf(source_path, sizeof(source_path), "%s/widget.c", directory);
+    bool written = write_test_file(header_path, UNDOCUMENTED_HEADER);
+    TEST_ASSERT(written, "Should write the header");
+
+    LspSession_t session;
+    bool started = start_session(&session);
+    TEST_ASSERT(started, "Should start the server");
+
+    MetisJsonDocument_t message;
+    send_to_server(&session, "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"initialize\",\"params\":{\"capabilities\":{}}}");
+    bool received = receive_from_server(&session, &message);
+    TEST_ASSERT(received, "initialize should be answered");
+    metis_json_free(&message);
+
+    char open_format[256];
+    snprintf(open_format, sizeof(open_format),
+             "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":"
+             "{\"uri\":\"file://%s\",\"languageId\":\"c\",\"version\":1,\"text\":%%s}}}", source_path);
+    send_with_string(&session, open_format, WIDGET_SOURCE);
+    int opened = receive_diagnostics(&session, 1, &message);
+    const MetisJson_t* diagnostics = metis_json_get(metis_json_get(message.root, "params"), "diagnostics");
+    bool header_finding = false;
+    for (int i = 0; diagnostics && i < diagnostics->count; i++) {
+        const char* text = metis_json_get_string(&diagnostics->items[i], "message");
+        if (text && strstr(text, "declared in header")) header_finding = true;
+    }
+    TEST_ASSERT(opened >= 0, "Opening the source should publish its diagnostics");
+    TEST_ASSERT(!header_finding, "The header's missing docs should not be reported on the source buffer");
+    metis_json_free(&message);
+
+    snprintf(open_format, sizeof(open_format),
+             "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":"
+             "{\"uri\":\"file://%s\",\"languageId\":\"c\",\"version\":2,\"text\":%%s}}}", header_path);
+    send_with_string(&session, open_format, UNDOCUMENTED_HEADER);
+    int header_count = receive_diagnostics(&session, 2, &message);
+    const MetisJson_t* docs_diagnostic = find_diagnostic(&message, "docs");
+    const MetisJson_t* start = metis_json_get(metis_json_get(docs_diagnostic, "range"), "start");
+    TEST_ASSERT(header_count > 0 && docs_diagnostic != NULL, "The header's own buffer should report its missing docs");
+    TEST_ASSERT(metis_json_get_number(start, "line", -1) >= 9, "Header findings should point at the declarations");
+    metis_json_free(&message);
+
+    finish_session(&session);
+    unlink(header_path);
+    rmdir(directory);
+    return 1;
+}
+
+// =============================================================================
+// MAIN TEST RUNNER
+// =============================================================================
+
+int main(void) {
+    TEST_SUITE_START("Metis LSP Basic Tests");
+
+    RUN_TEST(test_lsp_session);
+    RUN_TEST(test_lsp_utf8_and_hang_up);
+    RUN_TEST(test_lsp_header_findings);
+
+    TEST_SUITE_END();
+}
@@ -0,0 +1,302 @@
+/* test_metis_server_basic.c - Basic tests for the JSON codec and the lint server */
+// INSERT WISDOM HERE
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "tests.h"
+#include "metis_json.h"
+#include "metis_server.h"
+#include "../test_helpers.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOG(msg) printf("%s | File: %s, Line: %d\n", msg, __FILE__, __LINE__)
+
+#define SERVER_TEST_SOCKET "/tmp/metis_server_test.sock"
+#define SERVER_TEST_FILE "/tmp/metis_server_test.c"
+
+// Global test counters required by tests.h framework
+int total_tests = 0;
+int tests_passed = 0;
+int tests_failed = 0;
+
+static const char* DANGEROUS_SOURCE =
+    "/* metis_server_test.c - File with unsafe functions */\n"
+    "// INSERT WISDOM HERE\n"
+    "\n"
+    "#include <string.h>\n"
+    "\n"
+    "void unsafe_copy(char* buffer, const char* input) {\n"
+    "    strcpy(buffer, input);\n"
+    "}\n";
+
+// =============================================================================
+// TEST HELPER FUNCTIONS
+// =============================================================================
+
+/*
+ * Write `text` as a JSON string and return the output
+ */
+static char* json_quote(const char* text, size_t length) {
+    char* output = NULL;
+    size_t output_length = 0;
+    FILE* out = open_memstream(&output, &output_length);
+    if (!out) return NULL;
+    metis_json_write_string(out, text, length);
+    fclose(out);
+    return output;
+}
+
+/*
+ * Server thread body
+ */
+static void* run_server_thread(void* arg) {
+    *(int*)arg = metis_server_run(SERVER_TEST_SOCKET);
+    return NULL;
+}
+
+/*
+ * Wait up to a second for the test server to answer
+ */
+static bool wait_for_server(void) {
+    const char* ping = "{\"paths\":[]}";
+    struct timespec pause = { 0, 10 * 1000 * 1000 };
+    for (int attempt = 0; attempt < 100; attempt++) {
+        char* response = metis_server_call(SERVER_TEST_SOCKET, ping, strlen(ping));
+        if (response) {
+            free(response);
+            return true;
+        }
+        nanosleep(&pause, NULL);
+    }
+    return false;
+}
+
+/*
+ * Count the diagnostics of a response line, or -1 if it is not a successful response
+ */
+static int response_diagnostic_count(const char* response) {
+    MetisJsonDocument_t document = { 0 };
+    int count = -1;
+    if (response && metis_json_parse(response, strlen(response), &document) &&
+        metis_json_get_bool(document.root, "ok", false)) {
+        const MetisJson_t* diagnostics = metis_json_get(document.root, "diagnostics");
+        if (diagnostics && diagnostics->type == METIS_JSON_ARRAY) count = diagnostics->count;
+    }
+    metis_json_free(&document);
+    return count;
+}
+
+// =============================================================================
+// JSON TESTS
+// =============================================================================
+
+/*
+ * Test parsing nested values, escapes and lookups
+ */
+static int test_json_parse(void) {
+    LOG("Testing JSON parsing");
+
+    const char* text = "{ \"name\": \"a\\\"b\\\\c\\u00e9\\ud83d\\ude00\", \"count\": -12.5e1,"
+                       " \"flags\": [true, false, null], \"nested\": {\"x\": 1}, \"count\": 3 }";
+    // TEST_ASSERT may evaluate its condition twice, so calls with side effects stay outside it
+    MetisJsonDocument_t document;
+    bool parsed = metis_json_parse(text, strlen(text), &document);
+    TEST_ASSERT(parsed, "Valid JSON should parse");
+    TEST_ASSERT(document.root->type == METIS_JSON_OBJECT && document.root->count == 5, "Root should be an object of five members");
+    TEST_ASSERT(strcmp(metis_json_get_string(document.root, "name"), "a\"b\\c\xc3\xa9\xf0\x9f\x98\x80") == 0,
+                "Escapes and surrogate pairs should decode to UTF-8");
+    TEST_ASSERT(metis_json_get_number(document.root, "count", 0) == 3, "The last duplicate key should win");
+
+    const MetisJson_t* flags = metis_json_get(document.root, "flags");
+    TEST_ASSERT(flags && flags->type == METIS_JSON_ARRAY && flags->count == 3, "Arrays should keep every item");
+    TEST_ASSERT(flags->items[0].boolean && !flags->items[1].boolean && flags->items[2].type == METIS_JSON_NULL,
+                "Literals should parse");
+    TEST_ASSERT(metis_json_get_number(metis_json_get(document.root, "nested"), "x", 0) == 1, "Nested objects should parse");
+    TEST_ASSERT(metis_json_get_bool(document.root, "missing", true), "Missing members should give the fallback");
+    metis_json_free(&document);
+
+    const char* invalid[] = { "", "{", "[1,]", "{\"a\" 1}", "\"\\x\"", "01", "nul", "{} extra", ".5" };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        parsed = metis_json_parse(invalid[i], strlen(invalid[i]), &document);
+        metis_json_free(&document);
+        TEST_ASSERT(!parsed, "Malformed JSON should be rejected");
+    }
+
+    // A lone surrogate cannot be encoded, so it decodes as U+FFFD rather than failing the request
+    parsed = metis_json_parse("\"\\ud800\"", 8, &document);
+    TEST_ASSERT(parsed && strcmp(document.root->string, "\xef\xbf\xbd") == 0, "Lone surrogates should become U+FFFD");
+    metis_json_free(&document);
+
+    // Deep nesting is refused rather than overflowing the stack
+    char deep[200];
+    memset(deep, '[', 100);
+    memset(deep + 100, ']', 100);
+    parsed = metis_json_parse(deep, sizeof(deep), &document);
+    metis_json_free(&document);
+    TEST_ASSERT(!parsed, "Nesting past the limit should be rejected");
+    return 1;
+}
+
+/*
+ * Test that written strings parse back to the same bytes
+ */
+static int test_json_write_round_trip(void) {
+    LOG("Testing JSON string writing");
+
+    const char original[] = "tab\there \"quoted\" back\\slash\nline\x01 caf\xc3\xa9";
+    char* quoted = json_quote(original, sizeof(original) - 1);
+    TEST_ASSERT(quoted != NULL, "Writing should succeed");
+    TEST_ASSERT(strchr(quoted, '\n') == NULL && strchr(quoted, '\t') == NULL, "Control characters should be escaped");
+
+    MetisJsonDocument_t document;
+    bool parsed = metis_json_parse(quoted, strlen(quoted), &document);
+    TEST_ASSERT(parsed, "Written strings should parse");
+    TEST_ASSERT(document.root->type == METIS_JSON_STRING && document.root->length == sizeof(original) - 1 &&
+                memcmp(document.root->string, original, sizeof(original) - 1) == 0,
+                "Strings should survive a round trip");
+    metis_json_free(&document);
+    free(quoted);
+    return 1;
+}
+
+// =============================================================================
+// SERVER TESTS
+// =============================================================================
+
+/*
+ * Test answering requests without a socket
+ */
+static int test_server_handle_request(void) {
+    LOG("Testing request handling");
+
+    bool written = write_test_file(SERVER_TEST_FILE, DANGEROUS_SOURCE);
+    TEST_ASSERT(written, "Should create test file");
+
+    const char* by_path = "{\"paths\":[\"" SERVER_TEST_FILE "\",\"/tmp/metis_server_missing.c\"]}";
+    char* response = metis_server_handle_request(by_path, strlen(by_path));
+    TEST_ASSERT(response && response[strlen(response) - 1] == '\n', "Responses should be newline-terminated");
+
+    MetisJsonDocument_t document;
+    bool parsed = metis_json_parse(response, strlen(response), &document);
+    TEST_ASSERT(parsed, "Responses should be valid JSON");
+    TEST_ASSERT(metis_json_get_bool(document.root, "ok", false), "A path request should succeed");
+    TEST_ASSERT(metis_json_get_number(document.root, "files_analyzed", 0) == 1 &&
+                metis_json_get_number(document.root, "files_unreadable", 0) == 1,
+                "Missing files should be counted, not fail the request");
+    const MetisJson_t* diagnostics = metis_json_get(document.root, "diagnostics");
+    TEST_ASSERT(diagnostics && diagnostics->count > 0, "strcpy should be reported");
+    TEST_ASSERT(strcmp(metis_json_get_string(&diagnostics->items[0], "file"), SERVER_TEST_FILE) == 0,
+                "Diagnostics should name the file");
+    int file_count = diagnostics->count;
+    metis_json_free(&document);
+    free(response);
+
+    // An unsaved buffer is linted as sent, not as on disk
+    written = write_test_file(SERVER_TEST_FILE, "/* metis_server_test.c - Saved version */\n");
+    TEST_ASSERT(written, "Should rewrite test file");
+    char* content = json_quote(DANGEROUS_SOURCE, strlen(DANGEROUS_SOURCE));
+    char request[4096];
+    snprintf(request, sizeof(request), "{\"sources\":[{\"path\":\"" SERVER_TEST_FILE "\",\"content\":%s}]}", content);
+    response = metis_server_handle_request(request, strlen(request));
+    int buffer_count = response_diagnostic_count(response);
+    TEST_ASSERT(buffer_count == file_count, "A buffer should lint like the same file");
+    free(response);
+
+    snprintf(request, sizeof(request),
+             "{\"sources\":[{\"path\":\"" SERVER_TEST_FILE "\",\"content\":%s}],\"ignore_rules\":[\"daedalus\"]}", content);
+    response = metis_server_handle_request(request, strlen(request));
+    buffer_count = response_diagnostic_count(response);
+    TEST_ASSERT(buffer_count >= 0 && buffer_count < file_count, "Ignored rules should not be reported");
+    free(response);
+    free(content);
+
+    const char* bad[] = { "not json", "[]", "{}", "{\"paths\":[1]}", "{\"sources\":[{}]}", "{\"paths\":[],\"ignore_rules\":1}" };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        response = metis_server_handle_request(bad[i], strlen(bad[i]));
+        parsed = response && metis_json_parse(response, strlen(response), &document);
+        TEST_ASSERT(parsed, "Errors should be valid JSON");
+        TEST_ASSERT(!metis_json_get_bool(document.root, "ok", true) && metis_json_get_string(document.root, "error"),
+                    "Bad requests should get an error response");
+        metis_json_free(&document);
+        free(response);
+    }
+
+    unlink(SERVER_TEST_FILE);
+    return 1;
+}
+
+/*
+ * Test a server round trip over its socket, including an edit between requests
+ */
+static int test_server_socket_round_trip(void) {
+    LOG("Testing the lint server over a socket");
+
+    const char* request = "{\"paths\":[\"" SERVER_TEST_FILE "\"]}";
+    unlink(SERVER_TEST_SOCKET);
+    char* response = metis_server_call(SERVER_TEST_SOCKET, request, strlen(request));
+    TEST_ASSERT(response == NULL, "No server should answer before one runs");
+    bool written = write_test_file(SERVER_TEST_FILE, DANGEROUS_SOURCE);
+    TEST_ASSERT(written, "Should create test file");
+
+    int server_result = -1;
+    pthread_t server;
+    int started = pthread_create(&server, NULL, run_server_thread, &server_result);
+    TEST_ASSERT(started == 0, "Should start server thread");
+    bool answering = wait_for_server();
+    TEST_ASSERT(answering, "The server should start answering");
+    int second_result = metis_server_run(SERVER_TEST_SOCKET);
+    TEST_ASSERT(second_result == 1, "A second server on the same socket should be refused");
+
+    response = metis_server_call(SERVER_TEST_SOCKET, request, strlen(request));
+    int before = response_diagnostic_count(response);
+    TEST_ASSERT(before > 0, "The server should report strcpy");
+    free(response);
+
+    // Repeated requests are answered from the resident parse, and give the same answer
+    response = metis_server_call(SERVER_TEST_SOCKET, request, strlen(request));
+    int repeated = response_diagnostic_count(response);
+    TEST_ASSERT(repeated == before, "A repeated request should give the same answer");
+    free(response);
+
+    // Removing strcpy must be noticed even though the old parse is cached
+    char* fixed = strdup(DANGEROUS_SOURCE);
+    char* call = strstr(fixed, "    strcpy(buffer, input);\n");
+    memcpy(call, "    buffer[0] = input[0]; \n", strlen("    strcpy(buffer, input);\n"));
+    written = write_test_file(SERVER_TEST_FILE, fixed);
+    free(fixed);
+    TEST_ASSERT(written, "Should rewrite test file");
+    response = metis_server_call(SERVER_TEST_SOCKET, request, strlen(request));
+    int after = response_diagnostic_count(response);
+    TEST_ASSERT(after >= 0 && after < before, "An edited file should be linted afresh");
+    free(response);
+
+    metis_server_stop();
+    pthread_join(server, NULL);
+    TEST_ASSERT(server_result == 0, "The server should stop cleanly");
+    TEST_ASSERT(access(SERVER_TEST_SOCKET, F_OK) != 0, "Stopping should remove the socket");
+    response = metis_server_call(SERVER_TEST_SOCKET, request, strlen(request));
+    TEST_ASSERT(response == NULL, "No server should answer after it stops");
+
+    unlink(SERVER_TEST_FILE);
+    return 1;
+}
+
+// =============================================================================
+// MAIN TEST RUNNER
+// =============================================================================
+
+int main(void) {
+    TEST_SUITE_START("Metis Server Basic Tests");
+
+    RUN_TEST(test_json_parse);
+    RUN_TEST(test_json_write_round_trip);
+    RUN_TEST(test_server_handle_request);
+    RUN_TEST(test_server_socket_round_trip);
+
+    TEST_SUITE_END();
+}
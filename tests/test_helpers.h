@@ -0,0 +1,25 @@
+/* test_helpers.h - File helpers shared by the test suites */
+// INSERT WISDOM HERE
+
+#ifndef METIS_TEST_HELPERS_H
+#define METIS_TEST_HELPERS_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/*
+ * Write `content` to a file, replacing it
+ *
+ * `path` - File to create or overwrite
+ * `content` - Null-terminated text to write
+ *
+ * `bool` - false if the file could not be created or written
+ */
+static inline bool write_test_file(const char* path, const char* content) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+    bool written = fputs(content, file) >= 0;
+    return fclose(file) == 0 && written;
+}
+
+#endif // METIS_TEST_HELPERS_H
@@ -0,0 +1,134 @@
+/* gen_perfect_hash.c - Build-time generator for the parser's perfect hash tables */
+// Reads the word sets from c_parser.h and writes collision-free lookup tables
+
+#include "c_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SEED_ATTEMPTS 10000000u
+
+/*
+ * Seeded FNV-1a variant used for every generated table.
+ * Must stay identical to HASH_FUNCTION_SOURCE, which is what the parser compiles.
+ */
+static uint32_t perfect_hash(const char* text, size_t length, uint32_t seed) {
+    uint32_t hash = seed ^ (uint32_t)length;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)text[i]) * 16777619u;
+    }
+    return hash ^ (hash >> 16);
+}
+
+static const char* HASH_FUNCTION_SOURCE =
+    "static inline uint32_t c_parser_perfect_hash(const char* text, size_t length, uint32_t seed) {\n"
+    "    uint32_t hash = seed ^ (uint32_t)length;\n"
+    "    for (size_t i = 0; i < length; i++) {\n"
+    "        hash = (hash ^ (unsigned char)text[i]) * 16777619u;\n"
+    "    }\n"
+    "    return hash ^ (hash >> 16);\n"
+    "}\n";
+
+#define WORD_TEXT(id, text) text,
+
+static const char* KEYWORD_WORDS[] = { C_PARSER_C_KEYWORDS(WORD_TEXT) };
+static const char* TYPE_KEYWORD_WORDS[] = { C_PARSER_TYPE_KEYWORDS(WORD_TEXT) };
+static const char* DANGEROUS_FUNCTION_WORDS[] = { C_PARSER_DANGEROUS_FUNCTIONS(WORD_TEXT) };
+
+/*
+ * Find a seed that maps every word to a distinct slot and write the table
+ *
+ * `out` - Generated header being written
+ * `prefix` - Upper-case prefix for the emitted identifiers
+ * `words` - Word set; word i gets ID i + 1
+ * `count` - Number of words
+ *
+ * `bool` - true on success, false if no seed was found
+ */
+static bool emit_table(FILE* out, const char* prefix, const char** words, size_t count) {
+    // Four slots per word keeps the seed search short and the table tiny
+    size_t size = 1;
+    while (size < count * 4) size <<= 1;
+    uint32_t mask = (uint32_t)(size - 1);
+
+    uint8_t* slots = malloc(size);
+    if (!slots) return false;
+
+    size_t min_length = (size_t)-1;
+    size_t max_length = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t length = strlen(words[i]);
+        if (length < min_length) min_length = length;
+        if (length > max_length) max_length = length;
+    }
+
+    uint32_t seed = 0;
+    bool found = false;
+    for (uint32_t attempt = 1; attempt < MAX_SEED_ATTEMPTS && !found; attempt++) {
+        memset(slots, 0, size);
+        found = true;
+        for (size_t i = 0; i < count; i++) {
+            uint32_t slot = perfect_hash(words[i], strlen(words[i]), attempt) & mask;
+            if (slots[slot]) {
+                found = false;
+                break;
+            }
+            slots[slot] = (uint8_t)(i + 1);
+        }
+        if (found) seed = attempt;
+    }
+
+    if (!found) {
+        free(slots);
+        fprintf(stderr, "gen_perfect_hash: no collision-free seed for %s\n", prefix);
+        return false;
+    }
+
+    fprintf(out, "#define %s_HASH_SEED %uu\n", prefix, seed);
+    fprintf(out, "#define %s_HASH_MASK %uu\n", prefix, mask);
+    fprintf(out, "#define %s_MIN_LENGTH %zu\n", prefix, min_length);
+    fprintf(out, "#define %s_MAX_LENGTH %zu\n\n", prefix, max_length);
+    fprintf(out, "static const uint8_t %s_HASH_SLOTS[%zu] = {", prefix, size);
+    for (size_t i = 0; i < size; i++) {
+        if (i % 16 == 0) fprintf(out, "\n   ");
+        fprintf(out, " %2u,", slots[i]);
+    }
+    fprintf(out, "\n};\n\n");
+
+    free(slots);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s output.h\n", argv[0]);
+        return 1;
+    }
+
+    FILE* out = fopen(argv[1], "w");
+    if (!out) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "/* c_parser_hash_tables.h - Generated by tools/gen_perfect_hash.c, do not edit */\n");
+    fprintf(out, "// Slot values are 1-based word IDs from the X-macro lists in c_parser.h; 0 is empty\n\n");
+    fprintf(out, "#ifndef C_PARSER_HASH_TABLES_H\n#define C_PARSER_HASH_TABLES_H\n\n");
+    fprintf(out, "#include <stddef.h>\n#include <stdint.h>\n\n");
+    fprintf(out, "%s\n", HASH_FUNCTION_SOURCE);
+
+    bool ok = emit_table(out, "C_KEYWORD", KEYWORD_WORDS,
+                         sizeof(KEYWORD_WORDS) / sizeof(KEYWORD_WORDS[0])) &&
+              emit_table(out, "C_TYPE_KEYWORD", TYPE_KEYWORD_WORDS,
+                         sizeof(TYPE_KEYWORD_WORDS) / sizeof(TYPE_KEYWORD_WORDS[0])) &&
+              emit_table(out, "C_DANGEROUS_FUNCTION", DANGEROUS_FUNCTION_WORDS,
+                         sizeof(DANGEROUS_FUNCTION_WORDS) / sizeof(DANGEROUS_FUNCTION_WORDS[0]));
+
+    fprintf(out, "#endif /* C_PARSER_HASH_TABLES_H */\n");
+
+    if (fclose(out) != 0 || !ok) {
+        remove(argv[1]);
+        return 1;
+    }
+    return 0;
+}